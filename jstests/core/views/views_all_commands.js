@@ -118,7 +118,12 @@ let viewsCommandTests = {
     _recvChunkCommit: {skip: isAnInternalCommand},
     _recvChunkStart: {skip: isAnInternalCommand},
     _recvChunkStatus: {skip: isAnInternalCommand},
+    _replBackupClose: {skip: isAnInternalCommand},
+    _replBackupOpen: {skip: isAnInternalCommand},
+    _replBackupReadFileChunk: {skip: isAnInternalCommand},
+    _replCopyBackupFiles: {skip: isAnInternalCommand},
     _shardsvrCloneCatalogData: {skip: isAnInternalCommand},
+    _shardsvrGetChunkLoads: {skip: isAnInternalCommand},
     _shardsvrMovePrimary: {skip: isAnInternalCommand},
     _shardsvrRenameCollection: {skip: isAnInternalCommand},
     _shardsvrShardCollection: {skip: isAnInternalCommand},
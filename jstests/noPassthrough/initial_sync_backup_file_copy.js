@@ -0,0 +1,71 @@
+/**
+ * Tests that copying a backup of the data files of a replica set member with the backup file
+ * transfer commands used by file copy based initial sync yields a dbpath that a new mongod can
+ * start from with all of the member's data.
+ *
+ * @tags: [requires_persistence, requires_replication, requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+// Skip this test if not running with the "wiredTiger" storage engine.
+if (jsTest.options().storageEngine && jsTest.options().storageEngine !== 'wiredTiger') {
+    jsTest.log('Skipping test because storageEngine is not "wiredTiger"');
+    return;
+}
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+const primary = rst.getPrimary();
+const primaryDB = primary.getDB('test');
+
+const bulk = primaryDB.coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({_id: i, padding: 'x'.repeat(1024)});
+}
+assert.commandWorked(bulk.execute({w: 1, j: true}));
+assert.commandWorked(primaryDB.coll.createIndex({padding: 1}));
+assert.commandWorked(primary.adminCommand({fsync: 1}));
+
+// Only one backup may be open at a time, and reads must name the open backup.
+const adminDB = primary.getDB('admin');
+const opened = assert.commandWorked(adminDB.runCommand({_replBackupOpen: 1}));
+assert.gt(opened.files.length, 0, tojson(opened));
+assert.commandFailedWithCode(adminDB.runCommand({_replBackupOpen: 1}),
+                             ErrorCodes.ConflictingOperationInProgress);
+assert.commandFailedWithCode(
+    adminDB.runCommand(
+        {_replBackupReadFileChunk: UUID(), file: opened.files[0].name, offset: 0, length: 16}),
+    ErrorCodes.NoSuchKey);
+assert.commandWorked(adminDB.runCommand({_replBackupClose: opened.backupId}));
+
+// Copy the member's files from a separate mongod into an empty directory.
+const copier = MongoRunner.runMongod();
+assert.neq(null, copier, 'mongod was unable to start up');
+const destination = MongoRunner.dataPath + 'initial_sync_backup_file_copy';
+resetDbpath(destination);
+const copied = assert.commandWorked(copier.adminCommand(
+    {_replCopyBackupFiles: 1, source: primary.host, destination: destination}));
+jsTest.log('Copied backup files: ' + tojson(copied));
+assert.eq(opened.files.length, copied.numFiles, tojson(copied));
+assert.gt(copied.bytesCopied, 1000 * 1024, tojson(copied));
+MongoRunner.stopMongod(copier);
+
+// The backup was closed, so another one can be opened right away.
+assert.commandWorked(adminDB.runCommand(
+    {_replBackupClose: assert.commandWorked(adminDB.runCommand({_replBackupOpen: 1})).backupId}));
+
+// The copy starts as a standalone with the data as of the backup's checkpoint.
+const restored = MongoRunner.runMongod({dbpath: destination, noCleanData: true});
+assert.neq(null, restored, 'mongod was unable to start up on the copied files');
+const restoredDB = restored.getDB('test');
+assert.eq(1000, restoredDB.coll.find().itcount());
+assert.eq(primaryDB.coll.find().sort({_id: 1}).toArray(),
+          restoredDB.coll.find().sort({_id: 1}).toArray());
+assert.eq(2, restoredDB.coll.getIndexes().length);
+assert.commandWorked(restoredDB.coll.validate({full: true}));
+MongoRunner.stopMongod(restored);
+
+rst.stopSet();
+})();
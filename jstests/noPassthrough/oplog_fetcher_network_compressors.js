@@ -0,0 +1,40 @@
+/**
+ * Tests that the 'oplogFetcherNetworkCompressors' parameter makes the oplog fetcher negotiate its
+ * own preferred network compressor with the sync source, while the node's other connections keep
+ * using the first compressor in 'networkMessageCompressors'.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+'use strict';
+
+const rst = new ReplSetTest({
+    nodes: [{}, {rsConfig: {priority: 0}, setParameter: {oplogFetcherNetworkCompressors: 'zstd'}}],
+    nodeOptions: {networkMessageCompressors: 'snappy,zstd'},
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+
+function zstdBytesCompressedBy(node) {
+    const serverStatus = assert.commandWorked(node.adminCommand({serverStatus: 1}));
+    return serverStatus.network.compression.zstd.compressor.bytesIn;
+}
+
+const zstdBytesBefore = zstdBytesCompressedBy(primary);
+const coll = primary.getDB('test').coll;
+for (let i = 0; i < 100; i++) {
+    assert.commandWorked(coll.insert({_id: i, payload: 'oplog entry payload '.repeat(50)}));
+}
+rst.awaitReplication();
+assert.eq(100, secondary.getDB('test').coll.find().itcount());
+
+// The primary compresses the oplog batches it sends to the secondary with zstd.
+assert.gt(zstdBytesCompressedBy(primary),
+          zstdBytesBefore + 100 * 1000,
+          'expected the oplog fetcher connection to use zstd');
+
+rst.stopSet();
+})();
@@ -0,0 +1,78 @@
+/**
+ * Measures the throughput of reads on a secondary with and without concurrent oplog application,
+ * and tests that secondary reads neither wait for an in-progress batch nor see its writes.
+ *
+ * @tags: [requires_replication, requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const dbName = "test";
+const collName = "coll";
+const measureMillis = 5000;
+
+const rst = new ReplSetTest({nodes: [{}, {rsConfig: {priority: 0, votes: 0}}]});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const primaryColl = primary.getDB(dbName)[collName];
+const secondary = rst.getSecondary();
+secondary.setSlaveOk();
+const secondaryColl = secondary.getDB(dbName)[collName];
+
+assert.commandWorked(primaryColl.insertMany([...Array(1000).keys()].map(x => ({_id: x}))));
+rst.awaitReplication();
+
+/**
+ * Runs reads on the secondary for 'measureMillis' and returns the number of reads per second.
+ */
+function measureSecondaryReads() {
+    let reads = 0;
+    const start = Date.now();
+    while (Date.now() - start < measureMillis) {
+        assert.eq(100, secondaryColl.find({_id: {$lt: 100}}).itcount());
+        reads++;
+    }
+    return reads * 1000 / (Date.now() - start);
+}
+
+const idleReadsPerSecond = measureSecondaryReads();
+
+// Keep the secondary applying batches while we measure again.
+const writer = startParallelShell(function() {
+    const coll = db.getSiblingDB("test").coll;
+    for (let i = 1000; coll.getDB().stopWriter.find().itcount() == 0; i++) {
+        assert.commandWorked(coll.insert({_id: i}));
+    }
+}, primary.port);
+
+const busyReadsPerSecond = measureSecondaryReads();
+assert.commandWorked(primary.getDB(dbName).stopWriter.insert({}));
+writer();
+
+jsTestLog({
+    secondaryReadsPerSecondWithoutApplication: idleReadsPerSecond,
+    secondaryReadsPerSecondDuringApplication: busyReadsPerSecond,
+});
+assert.gt(busyReadsPerSecond, 0);
+rst.awaitReplication();
+
+// Hold a batch open on the secondary, with the parallel batch writer mode lock, after it has
+// applied its writes. Reads must complete without waiting for it, at the last batch boundary.
+const countBefore = secondaryColl.find().itcount();
+const pauseBatch = configureFailPoint(secondary, "pauseBatchApplicationBeforeCompletion");
+assert.commandWorked(primaryColl.insert({_id: "duringBatch"}));
+pauseBatch.wait();
+
+assert.eq(countBefore, secondaryColl.find().maxTimeMS(10 * 1000).itcount());
+assert.eq(0, secondaryColl.find({_id: "duringBatch"}).maxTimeMS(10 * 1000).itcount());
+
+pauseBatch.off();
+rst.awaitReplication();
+assert.eq(1, secondaryColl.find({_id: "duringBatch"}).itcount());
+
+rst.stopSet();
+})();
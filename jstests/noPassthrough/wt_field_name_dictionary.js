@@ -0,0 +1,76 @@
+/**
+ * Tests that documents in a collection created with a 'fieldNameDictionary' storage option round
+ * trip unchanged through inserts, updates, deletes and a restart, and that the logical data size
+ * matches a collection without the dictionary.
+ */
+(function() {
+'use strict';
+
+// Skip this test if not running with the "wiredTiger" storage engine.
+if (jsTest.options().storageEngine && jsTest.options().storageEngine !== 'wiredTiger') {
+    jsTest.log('Skipping test because storageEngine is not "wiredTiger"');
+    return;
+}
+
+const dictionary = ['temperatureCelsius', 'relativeHumidity', 'sensorMetadata', 'location'];
+const storageEngine = {wiredTiger: {fieldNameDictionary: dictionary}};
+
+let conn = MongoRunner.runMongod();
+assert.neq(null, conn, 'mongod was unable to start up');
+let testDB = conn.getDB('test');
+
+assert.commandWorked(testDB.createCollection('dict', {storageEngine: storageEngine}));
+assert.commandWorked(testDB.createCollection('plain'));
+
+// The dictionary is validated on creation and is not supported for capped collections.
+assert.commandFailedWithCode(
+    testDB.createCollection('bad', {storageEngine: {wiredTiger: {fieldNameDictionary: [1]}}}),
+    ErrorCodes.TypeMismatch);
+assert.commandFailedWithCode(
+    testDB.createCollection('capped', {capped: true, size: 4096, storageEngine: storageEngine}),
+    ErrorCodes.InvalidOptions);
+
+function makeDoc(i) {
+    return {
+        _id: i,
+        temperatureCelsius: 20 + i,
+        relativeHumidity: 0.5,
+        sensorMetadata: {location: 'rack-' + (i % 4), tags: [{location: 'row'}, 'x']},
+        unlisted: 'value',
+    };
+}
+
+for (let i = 0; i < 100; i++) {
+    assert.commandWorked(testDB.dict.insert(makeDoc(i)));
+    assert.commandWorked(testDB.plain.insert(makeDoc(i)));
+}
+
+for (let coll of [testDB.dict, testDB.plain]) {
+    assert.commandWorked(coll.update({_id: 1}, {$set: {relativeHumidity: 0.75}}));
+    assert.commandWorked(coll.update({_id: 2}, {$inc: {temperatureCelsius: 1}}));
+    assert.commandWorked(coll.remove({_id: 3}));
+}
+
+function checkContents(db) {
+    const expected = db.plain.find().sort({_id: 1}).toArray();
+    assert.eq(99, expected.length);
+    assert.eq(expected, db.dict.find().sort({_id: 1}).toArray());
+    assert.eq(db.plain.find({'sensorMetadata.location': 'rack-1'}).itcount(),
+              db.dict.find({'sensorMetadata.location': 'rack-1'}).itcount());
+    assert.eq(db.plain.stats().size, db.dict.stats().size);
+}
+
+checkContents(testDB);
+
+// The dictionary is part of the collection's catalog entry, so it survives a restart.
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod({dbpath: conn.dbpath, noCleanData: true});
+assert.neq(null, conn, 'mongod was unable to restart');
+testDB = conn.getDB('test');
+
+checkContents(testDB);
+assert.commandWorked(testDB.dict.insert(makeDoc(1000)));
+assert.eq(makeDoc(1000), testDB.dict.findOne({_id: 1000}));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,52 @@
+/**
+ * Tests that journal flushes requested by concurrent {j: true} writes are reported in the
+ * 'wiredTiger.groupCommit' serverStatus section, and that the group commit delay is tunable.
+ * @tags: [requires_journaling, requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, 'mongod was unable to start up');
+const testDB = conn.getDB('test');
+
+function groupCommitStats() {
+    return assert.commandWorked(testDB.serverStatus()).wiredTiger.groupCommit;
+}
+
+const before = groupCommitStats();
+assert.gte(before.batches, 0, tojson(before));
+
+const kNumThreads = 8;
+const kInsertsPerThread = 50;
+let shells = [];
+for (let i = 0; i < kNumThreads; i++) {
+    shells.push(startParallelShell(
+        funWithArgs(function(thread, count) {
+            for (let j = 0; j < count; j++) {
+                assert.commandWorked(db.getSiblingDB('test').coll.insert(
+                    {thread: thread, j: j}, {writeConcern: {j: true}}));
+            }
+        }, i, kInsertsPerThread), conn.port));
+}
+shells.forEach((join) => join());
+assert.eq(kNumThreads * kInsertsPerThread, testDB.coll.count());
+
+const after = groupCommitStats();
+jsTestLog('Group commit stats: ' + tojson(after));
+assert.gt(after.batches, before.batches, tojson(after));
+assert.eq(after.batches, after.batchSize.count, tojson(after));
+assert.eq(after.batches, after.flushMicros.count, tojson(after));
+// Each flush ran on behalf of at least one waiter.
+assert.gte(after.batchSize.sum - before.batchSize.sum,
+           after.batches - before.batches,
+           tojson(after));
+
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, wiredTigerGroupCommitMaxDelayMicros: 0}));
+assert.commandFailed(
+    testDB.adminCommand({setParameter: 1, wiredTigerGroupCommitMaxDelayMicros: -1}));
+assert.commandWorked(testDB.coll.insert({x: 1}, {writeConcern: {j: true}}));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -61,7 +61,12 @@ const allCommands = {
     _recvChunkCommit: {skip: isPrimaryOnly},
     _recvChunkStart: {skip: isPrimaryOnly},
     _recvChunkStatus: {skip: isPrimaryOnly},
+    _replBackupClose: {skip: isNotAUserDataRead},
+    _replBackupOpen: {skip: isNotAUserDataRead},
+    _replBackupReadFileChunk: {skip: isNotAUserDataRead},
+    _replCopyBackupFiles: {skip: isNotAUserDataRead},
     _shardsvrCloneCatalogData: {skip: isPrimaryOnly},
+    _shardsvrGetChunkLoads: {skip: isPrimaryOnly},
     _shardsvrMovePrimary: {skip: isPrimaryOnly},
     _shardsvrShardCollection: {skip: isPrimaryOnly},
     _transferMods: {skip: isPrimaryOnly},
@@ -0,0 +1,61 @@
+/**
+ * Tests that when dbCheck finds an inconsistent batch on a secondary, the health log entry narrows
+ * the inconsistency down to the subranges of the batch that differ, and that dbCheck accepts a
+ * bytes-per-second budget.
+ *
+ * @tags: [requires_persistence]
+ */
+(function() {
+"use strict";
+
+const dbName = "dbCheckSubranges";
+const collName = "coll";
+const numDocs = 4000;
+const divergentId = 2345;
+
+const rst = new ReplSetTest({nodes: [{}, {rsConfig: {priority: 0, votes: 0}}]});
+rst.startSet();
+rst.initiate();
+
+let primary = rst.getPrimary();
+let primaryDB = primary.getDB(dbName);
+assert.commandWorked(
+    primaryDB[collName].insertMany([...Array(numDocs).keys()].map(x => ({_id: x, x: x}))));
+rst.awaitReplication();
+
+// Make a single document diverge on the secondary by changing it while it runs as a standalone.
+let secondary = rst.restart(1, {noReplSet: true});
+assert.commandWorked(
+    secondary.getDB(dbName)[collName].update({_id: divergentId}, {$set: {x: "divergent"}}));
+secondary = rst.restart(1);
+rst.awaitSecondaryNodes();
+primary = rst.getPrimary();
+primaryDB = primary.getDB(dbName);
+
+assert.commandWorked(primaryDB.runCommand({dbCheck: collName, maxBytesPerSecond: 1024 * 1024}));
+
+// Wait for dbCheck to finish on the primary and for its oplog entries to be applied.
+assert.soon(() => primaryDB.currentOp().inprog.filter(op => op.desc == "dbCheck").length == 0,
+            "dbCheck timed out");
+rst.awaitReplication();
+
+const healthlog = secondary.getDB("local").system.healthlog;
+let errors;
+assert.soon(() => {
+    errors = healthlog.find({operation: "dbCheckBatch", severity: "error"}).toArray();
+    return errors.length > 0;
+}, "dbCheck did not report the divergent document");
+assert.eq(1, errors.length, tojson(errors));
+
+// Only the subrange holding the divergent document is reported.
+const subranges = errors[0].data.inconsistentSubranges;
+assert.eq(1, subranges.length, tojson(errors[0]));
+assert.lt(subranges[0].minKey, divergentId, tojson(subranges[0]));
+assert.gte(subranges[0].maxKey, divergentId, tojson(subranges[0]));
+assert.lt(subranges[0].maxKey - subranges[0].minKey, 1000, tojson(subranges[0]));
+
+// The primary reports every batch as consistent with itself.
+assert.eq(0, primary.getDB("local").system.healthlog.find({severity: "error"}).itcount());
+
+rst.stopSet();
+})();
@@ -0,0 +1,90 @@
+/**
+ * Tests that with 'internalQueryEnableGroupExchange' a sharded $group is merged in parallel on the
+ * targeted shards through a hashed exchange, and returns the same groups as a merge on a single
+ * node, also when the group keys are numbers of different types.
+ *
+ * @tags: [requires_sharding, uses_transactions]
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+
+const st = new ShardingTest({shards: 3, rs: {nodes: 1}});
+
+const dbName = "test";
+const mongosDB = st.s.getDB(dbName);
+const coll = mongosDB.group_exchange;
+
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+assert.commandWorked(st.s.adminCommand({shardCollection: coll.getFullName(), key: {a: 1}}));
+assert.commandWorked(st.s.adminCommand({split: coll.getFullName(), middle: {a: 300}}));
+assert.commandWorked(st.s.adminCommand({split: coll.getFullName(), middle: {a: 600}}));
+assert.commandWorked(st.s.adminCommand({
+    moveChunk: coll.getFullName(),
+    find: {a: 300},
+    to: st.shard1.shardName,
+    _waitForDelete: true
+}));
+assert.commandWorked(st.s.adminCommand({
+    moveChunk: coll.getFullName(),
+    find: {a: 600},
+    to: st.shard2.shardName,
+    _waitForDelete: true
+}));
+
+// Every shard holds each group key as an int, a long, a double and a decimal, so the partial
+// groups of a key reach the exchange with different numeric types.
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 900; i++) {
+    const k = i % 10;
+    const key = [NumberInt(k), NumberLong(k), k + 0.0, NumberDecimal(k)][Math.floor(i / 10) % 4];
+    bulk.insert({a: i, k: (i % 50 == 0) ? "str" + k : key});
+}
+bulk.insert({a: 900});
+assert.commandWorked(bulk.execute());
+
+// The group keys are converted to doubles after the $group, since the type of the key each group
+// reports depends on which of its documents was seen first.
+const pipeline = [
+    {$group: {_id: "$k", n: {$sum: 1}, total: {$sum: "$a"}}},
+    {$addFields: {key: {$cond: [{$isNumber: "$_id"}, {$toDouble: "$_id"}, "$_id"]}}},
+    {$project: {_id: 0}},
+];
+
+function setGroupExchange(enabled) {
+    assert.commandWorked(
+        st.s.adminCommand({setParameter: 1, internalQueryEnableGroupExchange: enabled}));
+}
+
+setGroupExchange(false);
+const expected = coll.aggregate(pipeline).toArray();
+// Ten numeric keys, "str0" and null for the document without a key.
+assert.eq(12, expected.length, tojson(expected));
+assert.neq("exchange", coll.explain().aggregate(pipeline).mergeType);
+
+setGroupExchange(true);
+const explain = coll.explain().aggregate(pipeline);
+assert.eq("exchange", explain.mergeType, tojson(explain));
+assert.eq({_id: "hashed"}, explain.splitPipeline.exchange.key, tojson(explain));
+assert.eq(3, explain.splitPipeline.exchange.consumerShards.length, tojson(explain));
+
+const actual = coll.aggregate(pipeline).toArray();
+assert(arrayEq(expected, actual), () => tojson({expected: expected, actual: actual}));
+
+// A $sort after the $group needs every group on one node, so the exchange is not used.
+assert.neq("exchange", coll.explain().aggregate(pipeline.concat([{$sort: {key: 1}}])).mergeType);
+
+// Multi-document transactions do not use the exchange, and still return the same groups.
+const session = st.s.startSession();
+const sessionColl = session.getDatabase(dbName).getCollection(coll.getName());
+session.startTransaction();
+const actualInTxn = sessionColl.aggregate(pipeline).toArray();
+assert.commandWorked(session.commitTransaction_forTesting());
+assert(arrayEq(expected, actualInTxn), () => tojson({expected: expected, actual: actualInTxn}));
+session.endSession();
+
+setGroupExchange(false);
+st.stop();
+})();
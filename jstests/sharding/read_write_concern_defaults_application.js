@@ -111,7 +111,12 @@ let testCases = {
     _recvChunkCommit: {skip: "internal command"},
     _recvChunkStart: {skip: "internal command"},
     _recvChunkStatus: {skip: "internal command"},
+    _replBackupClose: {skip: "internal command"},
+    _replBackupOpen: {skip: "internal command"},
+    _replBackupReadFileChunk: {skip: "internal command"},
+    _replCopyBackupFiles: {skip: "internal command"},
     _shardsvrCloneCatalogData: {skip: "internal command"},
+    _shardsvrGetChunkLoads: {skip: "internal command"},
     _shardsvrMovePrimary: {skip: "internal command"},
     _shardsvrRenameCollection: {skip: "internal command"},
     _shardsvrShardCollection: {skip: "internal command"},
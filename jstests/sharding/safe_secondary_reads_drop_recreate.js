@@ -62,11 +62,16 @@ let testCases = {
     _killOperations: {skip: "does not return user data"},
     _mergeAuthzCollections: {skip: "primary only"},
     _migrateClone: {skip: "primary only"},
+    _shardsvrGetChunkLoads: {skip: "primary only"},
     _shardsvrMovePrimary: {skip: "primary only"},
     _recvChunkAbort: {skip: "primary only"},
     _recvChunkCommit: {skip: "primary only"},
     _recvChunkStart: {skip: "primary only"},
     _recvChunkStatus: {skip: "primary only"},
+    _replBackupClose: {skip: "does not return user data"},
+    _replBackupOpen: {skip: "does not return user data"},
+    _replBackupReadFileChunk: {skip: "does not return user data"},
+    _replCopyBackupFiles: {skip: "does not return user data"},
     _transferMods: {skip: "primary only"},
     abortTransaction: {skip: "primary only"},
     addShard: {skip: "primary only"},
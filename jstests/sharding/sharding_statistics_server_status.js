@@ -14,6 +14,7 @@ function ShardStat() {
     this.countDonorMoveChunkStarted = 0;
     this.countRecipientMoveChunkStarted = 0;
     this.countDocsClonedOnRecipient = 0;
+    this.countBytesClonedOnRecipient = 0;
     this.countDocsClonedOnDonor = 0;
     this.countDocsDeletedOnDonor = 0;
 }
@@ -23,6 +24,7 @@ function incrementStatsAndCheckServerShardStats(donor, recipient, numDocs) {
     donor.countDocsClonedOnDonor += numDocs;
     ++recipient.countRecipientMoveChunkStarted;
     recipient.countDocsClonedOnRecipient += numDocs;
+    recipient.countBytesClonedOnRecipient += numDocs * Object.bsonsize({_id: 0});
     donor.countDocsDeletedOnDonor += numDocs;
     const statsFromServerStatus = shardArr.map(function(shardVal) {
         return shardVal.getDB('admin').runCommand({serverStatus: 1}).shardingStatistics;
@@ -33,12 +35,15 @@ function incrementStatsAndCheckServerShardStats(donor, recipient, numDocs) {
         assert(statsFromServerStatus[i].totalCriticalSectionCommitTimeMillis);
         assert(statsFromServerStatus[i].totalCriticalSectionTimeMillis);
         assert(statsFromServerStatus[i].totalDonorChunkCloneTimeMillis);
+        assert(statsFromServerStatus[i].totalRecipientChunkCloneTimeMillis);
         assert(statsFromServerStatus[i].countDonorMoveChunkLockTimeout);
         assert(statsFromServerStatus[i].countDonorMoveChunkAbortConflictingIndexOperation);
         assert.eq(stats[i].countDonorMoveChunkStarted,
                   statsFromServerStatus[i].countDonorMoveChunkStarted);
         assert.eq(stats[i].countDocsClonedOnRecipient,
                   statsFromServerStatus[i].countDocsClonedOnRecipient);
+        assert.eq(stats[i].countBytesClonedOnRecipient,
+                  statsFromServerStatus[i].countBytesClonedOnRecipient);
         assert.eq(stats[i].countDocsClonedOnDonor, statsFromServerStatus[i].countDocsClonedOnDonor);
         assert.eq(stats[i].countDocsDeletedOnDonor,
                   statsFromServerStatus[i].countDocsDeletedOnDonor);
@@ -45,6 +45,7 @@
 #include "mongo/db/repl/dbcheck.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/db/server_options.h"
 #include "mongo/util/background.h"
 
 #include "mongo/logv2/log.h"
@@ -55,6 +56,10 @@ namespace {
 constexpr uint64_t kBatchDocs = 5'000;
 constexpr uint64_t kBatchBytes = 20'000'000;
 
+// Each batch is also hashed in subranges of this many documents, so that secondaries can narrow an
+// inconsistent batch down to the subranges that differ.
+constexpr uint64_t kSubrangeDocs = 500;
+
 
 /**
  * All the information needed to run dbCheck on a single collection.
@@ -66,6 +71,7 @@ struct DbCheckCollectionInfo {
     int64_t maxCount;
     int64_t maxSize;
     int64_t maxRate;
+    int64_t maxBytesRate;
 };
 
 /**
@@ -117,7 +123,8 @@ std::unique_ptr<DbCheckRun> singleCollectionRun(OperationContext* opCtx,
     auto maxCount = invocation.getMaxCount();
     auto maxSize = invocation.getMaxSize();
     auto maxRate = invocation.getMaxCountPerSecond();
-    auto info = DbCheckCollectionInfo{nss, start, end, maxCount, maxSize, maxRate};
+    auto maxBytesRate = invocation.getMaxBytesPerSecond();
+    auto info = DbCheckCollectionInfo{nss, start, end, maxCount, maxSize, maxRate, maxBytesRate};
     auto result = std::make_unique<DbCheckRun>();
     result->push_back(info);
     return result;
@@ -138,6 +145,7 @@ std::unique_ptr<DbCheckRun> fullDatabaseRun(OperationContext* opCtx,
 
     int64_t max = std::numeric_limits<int64_t>::max();
     auto rate = invocation.getMaxCountPerSecond();
+    auto bytesRate = invocation.getMaxBytesPerSecond();
 
     for (auto collIt = db->begin(opCtx); collIt != db->end(opCtx); ++collIt) {
         auto coll = *collIt;
@@ -145,7 +153,8 @@ std::unique_ptr<DbCheckRun> fullDatabaseRun(OperationContext* opCtx,
             break;
         }
 
-        DbCheckCollectionInfo info{coll->ns(), BSONKey::min(), BSONKey::max(), max, max, rate};
+        DbCheckCollectionInfo info{
+            coll->ns(), BSONKey::min(), BSONKey::max(), max, max, rate, bytesRate};
         result->push_back(info);
     }
 
@@ -240,6 +249,13 @@ private:
         using TimePoint = stdx::chrono::time_point<Clock>;
         TimePoint lastStart = Clock::now();
         int64_t docsInCurrentInterval = 0;
+        int64_t bytesInCurrentInterval = 0;
+
+        // Don't let a single batch read more than a second's worth of bytes.
+        int64_t batchBytes = kBatchBytes;
+        if (info.maxBytesRate > 0) {
+            batchBytes = std::min(batchBytes, info.maxBytesRate);
+        }
 
         do {
             using namespace std::literals::chrono_literals;
@@ -247,9 +263,10 @@ private:
             if (Clock::now() - lastStart > 1s) {
                 lastStart = Clock::now();
                 docsInCurrentInterval = 0;
+                bytesInCurrentInterval = 0;
             }
 
-            auto result = _runBatch(info, start, kBatchDocs, kBatchBytes);
+            auto result = _runBatch(info, start, kBatchDocs, batchBytes);
 
             if (_done) {
                 return;
@@ -283,6 +300,7 @@ private:
             totalDocsSeen += stats.nDocs;
             totalBytesSeen += stats.nBytes;
             docsInCurrentInterval += stats.nDocs;
+            bytesInCurrentInterval += stats.nBytes;
 
             // Check if we've exceeded any limits.
             bool reachedLast = stats.lastKey >= info.end;
@@ -290,11 +308,18 @@ private:
             bool tooManyBytes = totalBytesSeen >= info.maxSize;
             reachedEnd = reachedLast || tooManyDocs || tooManyBytes;
 
+            // If an extremely low max rate has been set (substantially smaller than the batch
+            // size) we might want to sleep for multiple seconds between batches.
+            int64_t timesExceeded = 0;
             if (docsInCurrentInterval > info.maxRate && info.maxRate > 0) {
-                // If an extremely low max rate has been set (substantially smaller than the batch
-                // size) we might want to sleep for multiple seconds between batches.
-                int64_t timesExceeded = docsInCurrentInterval / info.maxRate;
+                timesExceeded = docsInCurrentInterval / info.maxRate;
+            }
+            if (bytesInCurrentInterval > info.maxBytesRate && info.maxBytesRate > 0) {
+                timesExceeded =
+                    std::max(timesExceeded, bytesInCurrentInterval / info.maxBytesRate);
+            }
 
+            if (timesExceeded > 0) {
                 stdx::this_thread::sleep_for(timesExceeded * 1s - (Clock::now() - lastStart));
             }
         } while (!reachedEnd);
@@ -400,6 +425,12 @@ private:
             return {ErrorCodes::NamespaceNotFound, "dbCheck collection no longer exists"};
         }
 
+        // Secondaries parse the batch entry strictly, so only send subranges once every member of
+        // the replica set is known to understand them.
+        const bool withSubranges = serverGlobalParams.featureCompatibility.isVersionInitialized() &&
+            serverGlobalParams.featureCompatibility.getVersion() ==
+                ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo44;
+
         boost::optional<DbCheckHasher> hasher;
         try {
             hasher.emplace(opCtx,
@@ -407,7 +438,8 @@ private:
                            first,
                            info.end,
                            std::min(batchDocs, info.maxCount),
-                           std::min(batchBytes, info.maxSize));
+                           std::min(batchBytes, info.maxSize),
+                           withSubranges ? kSubrangeDocs : 0);
         } catch (const DBException& e) {
             return e.toStatus();
         }
@@ -425,6 +457,9 @@ private:
         batch.setMd5(md5);
         batch.setMinKey(first);
         batch.setMaxKey(BSONKey(hasher->lastKey()));
+        if (withSubranges) {
+            batch.setSubranges(hasher->subranges());
+        }
 
         BatchStats result;
 
@@ -510,7 +545,8 @@ public:
                "              maxKey: <last key, inclusive>,\n"
                "              maxCount: <max number of docs>,\n"
                "              maxSize: <max size of docs>,\n"
-               "              maxCountPerSecond: <max rate in docs/sec> } "
+               "              maxCountPerSecond: <max rate in docs/sec>,\n"
+               "              maxBytesPerSecond: <max rate in bytes/sec> } "
                "to check a collection.\n"
                "Invoke with {dbCheck: 1} to check all collections in the database.";
     }
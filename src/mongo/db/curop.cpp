@@ -750,6 +750,9 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
     }
 
     OPDEBUG_TOSTRING_HELP(nShards);
+    if (writeRoutingStats) {
+        s << " writeRouting: " << makeWriteRoutingStatsObject().toString();
+    }
     OPDEBUG_TOSTRING_HELP(cursorid);
     if (mongotCursorId) {
         s << " mongot: " << makeMongotDebugStatsObject().toString();
@@ -915,6 +918,9 @@ void OpDebug::report(OperationContext* opCtx,
     }
 
     OPDEBUG_TOATTR_HELP(nShards);
+    if (writeRoutingStats) {
+        pAttrs->add("writeRouting", makeWriteRoutingStatsObject());
+    }
     OPDEBUG_TOATTR_HELP(cursorid);
     if (mongotCursorId) {
         pAttrs->add("mongot", makeMongotDebugStatsObject());
@@ -1035,6 +1041,9 @@ void OpDebug::append(OperationContext* opCtx,
     }
 
     OPDEBUG_APPEND_NUMBER(nShards);
+    if (writeRoutingStats) {
+        b.append("writeRouting", makeWriteRoutingStatsObject());
+    }
     OPDEBUG_APPEND_NUMBER(cursorid);
     if (mongotCursorId) {
         b.append("mongot", makeMongotDebugStatsObject());
@@ -1161,6 +1170,18 @@ BSONObj OpDebug::makeMongotDebugStatsObject() const {
     return cursorBuilder.obj();
 }
 
+BSONObj OpDebug::makeWriteRoutingStatsObject() const {
+    BSONObjBuilder builder;
+    invariant(writeRoutingStats);
+    builder.append("rounds", writeRoutingStats->rounds);
+    builder.append("targetingMillis",
+                   durationCount<Milliseconds>(writeRoutingStats->targetingTime));
+    builder.append("shardResponseWaitMillis",
+                   durationCount<Milliseconds>(writeRoutingStats->shardResponseWaitTime));
+    builder.append("refreshMillis", durationCount<Milliseconds>(writeRoutingStats->refreshTime));
+    return builder.obj();
+}
+
 
 namespace {
 
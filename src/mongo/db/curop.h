@@ -185,6 +185,11 @@ public:
      */
     BSONObj makeMongotDebugStatsObject() const;
 
+    /**
+     * Make object from the stats of a write routed by mongos.
+     */
+    BSONObj makeWriteRoutingStatsObject() const;
+
     // -------------------
 
     // basic options
@@ -240,6 +245,16 @@ public:
     // Shard targeting info.
     int nShards{-1};
 
+    // For writes routed by mongos, the number of rounds of child batches sent to the shards and
+    // the time spent in each stage of them.
+    struct WriteRoutingStats {
+        int rounds{0};
+        Milliseconds targetingTime{0};
+        Milliseconds shardResponseWaitTime{0};
+        Milliseconds refreshTime{0};
+    };
+    boost::optional<WriteRoutingStats> writeRoutingStats;
+
     // Stores the duration of time spent blocked on prepare conflicts.
     Milliseconds prepareConflictDurationMillis{0};
 
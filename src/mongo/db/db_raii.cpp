@@ -39,6 +39,7 @@
 #include "mongo/db/db_raii_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
+#include "mongo/db/storage/snapshot_manager.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo {
@@ -52,6 +53,21 @@ const boost::optional<int> kDoNotChangeProfilingLevel = boost::none;
 const auto allowSecondaryReadsDuringBatchApplication_DONT_USE =
     OperationContext::declareDecoration<boost::optional<bool>>();
 
+/**
+ * Returns the timestamp that reads at the last applied timestamp use. Replication sets the storage
+ * engine's local snapshot to the last applied timestamp at every batch boundary, so reading it from
+ * there keeps secondary reads off the replication coordinator mutex, which batch application
+ * holds while it advances the last applied optime.
+ */
+Timestamp getLastAppliedReadTimestamp(OperationContext* opCtx) {
+    auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+    if (auto snapshotManager = storageEngine->getSnapshotManager()) {
+        // Without a local snapshot, reads at the last applied timestamp read the latest data.
+        return snapshotManager->getLocalSnapshot().value_or(Timestamp());
+    }
+    return repl::ReplicationCoordinator::get(opCtx)->getMyLastAppliedOpTime().getTimestamp();
+}
+
 }  // namespace
 
 AutoStatsTracker::AutoStatsTracker(OperationContext* opCtx,
@@ -166,7 +182,7 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
         // because it is set asynchonously. This is not problematic because holding the collection
         // lock guarantees no metadata changes will occur in that time.
         auto lastAppliedTimestamp = readAtLastAppliedTimestamp
-            ? boost::optional<Timestamp>(replCoord->getMyLastAppliedOpTime().getTimestamp())
+            ? boost::optional<Timestamp>(getLastAppliedReadTimestamp(opCtx))
             : boost::none;
 
         if (!_conflictingCatalogChanges(opCtx, minSnapshot, lastAppliedTimestamp)) {
@@ -38,6 +38,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/shard_key_pattern.h"
 
@@ -103,6 +104,12 @@ PlanStage::StageState ShardFilterStage::doWork(WorkingSetID* out) {
                 ++_specificStats.chunkSkips;
                 return PlanStage::NEED_TIME;
             }
+
+            // Chunk loads are only needed by the balancer when it balances by load, so don't pay
+            // for extracting the shard key of the sampled documents otherwise.
+            if (loadAwareBalancing.load() && ++_numPassed % kReadSampleInterval == 0) {
+                _shardFilterer.addReads(*member, kReadSampleInterval);
+            }
         }
 
         // If we're here either we have shard state and our doc passed, or we have no shard
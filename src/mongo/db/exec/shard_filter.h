@@ -91,11 +91,18 @@ public:
     static const char* kStageType;
 
 private:
+    // Only one in this many of the documents which pass the filter is looked up to count it in
+    // the load statistics of its chunk, with a weight of this many reads.
+    static constexpr uint64_t kReadSampleInterval = 16;
+
     WorkingSet* _ws;
 
     // Stats
     ShardingFilterStats _specificStats;
 
+    // The number of documents which passed the filter, for sampling reads.
+    uint64_t _numPassed = 0;
+
     // Note: it is important that this owns the ScopedCollectionFilter from the time this stage
     // is constructed. See ScopedCollectionFilter class comment and MetadataManager comment for
     // details. The existence of the ScopedCollectionFilter prevents data which may have been
@@ -80,4 +80,16 @@ ShardFilterer::DocumentBelongsResult ShardFiltererImpl::documentBelongsToMe(
     }
     return _shardKeyBelongsToMe(_keyPattern->extractShardKeyFromDoc(doc.toBson()));
 }
+
+void ShardFiltererImpl::addReads(const WorkingSetMember& wsm, uint64_t numReads) const {
+    if (!_collectionFilter.isSharded() || !wsm.hasObj()) {
+        return;
+    }
+
+    const auto doc = wsm.doc.value().toBson();
+    const auto shardKey = _keyPattern->extractShardKeyFromDoc(doc);
+    if (!shardKey.isEmpty()) {
+        _collectionFilter.addReads(shardKey, numReads, numReads * doc.objsize());
+    }
+}
 }  // namespace mongo
@@ -42,6 +42,12 @@ public:
     DocumentBelongsResult documentBelongsToMe(const WorkingSetMember& wsm) const override;
     DocumentBelongsResult documentBelongsToMe(const Document& doc) const override;
 
+    /**
+     * Counts 'numReads' reads of the document in 'wsm' in the load statistics of the chunk which
+     * owns it. Members which only have index keys are not counted.
+     */
+    void addReads(const WorkingSetMember& wsm, uint64_t numReads) const;
+
     bool isCollectionSharded() const override {
         return _collectionFilter.isSharded();
     }
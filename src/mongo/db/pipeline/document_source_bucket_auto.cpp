@@ -32,6 +32,7 @@
 #include "mongo/db/pipeline/document_source_bucket_auto.h"
 
 #include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 
 namespace mongo {
@@ -130,6 +131,11 @@ DepsTracker::State DocumentSourceBucketAuto::getDependencies(DepsTracker* deps)
         // ExpressionConstant doesn't have dependencies.
     }
 
+    // When merging, each partial group also carries the number of documents in it.
+    if (_mergeCountField) {
+        deps->fields.insert(*_mergeCountField);
+    }
+
     // We know exactly which fields will be present in the output document. Future stages cannot
     // depend on any further fields. The grouping process will remove any metadata from the
     // documents, so there can be no further dependencies on metadata.
@@ -156,12 +162,25 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
     auto next = pSource->getNext();
     for (; next.isAdvanced(); next = pSource->getNext()) {
         auto nextDoc = next.releaseDocument();
+        _nDocuments += countDocuments(nextDoc);
         _sorter->add(extractKey(nextDoc), nextDoc);
-        _nDocuments++;
     }
     return next;
 }
 
+long long DocumentSourceBucketAuto::countDocuments(const Document& doc) const {
+    if (!_mergeCountField) {
+        return 1;
+    }
+
+    Value count = doc[*_mergeCountField];
+    uassert(4948610,
+            str::stream() << "$bucketAuto expected the partial group " << doc.toString()
+                          << " to have a numeric '" << *_mergeCountField << "' field",
+            count.numeric());
+    return count.coerceToLong();
+}
+
 Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     if (!_groupByExpression) {
         return Value(BSONNULL);
@@ -193,8 +212,8 @@ Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     return key.missing() ? Value(BSONNULL) : std::move(key);
 }
 
-void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>& entry,
-                                                   Bucket& bucket) {
+long long DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>& entry,
+                                                        Bucket& bucket) {
     invariant(pExpCtx->getValueComparator().evaluate(entry.first >= bucket._max));
     bucket._max = entry.first;
 
@@ -202,8 +221,9 @@ void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>&
     for (size_t k = 0; k < numAccumulators; k++) {
         bucket._accums[k]->process(
             _accumulatedFields[k].expr.argument->evaluate(entry.second, &pExpCtx->variables),
-            false);
+            doingMerge());
     }
+    return countDocuments(entry.second);
 }
 
 void DocumentSourceBucketAuto::populateBuckets() {
@@ -258,7 +278,7 @@ void DocumentSourceBucketAuto::populateBuckets() {
         }
 
         // Add the first value into the current bucket.
-        addDocumentToBucket(currentValue, currentBucket);
+        long long bucketSize = addDocumentToBucket(currentValue, currentBucket);
 
         if (isLastBucket) {
             // If this is the last bucket allowed, we need to put any remaining documents in
@@ -267,15 +287,11 @@ void DocumentSourceBucketAuto::populateBuckets() {
                 addDocumentToBucket(_sortedInput->next(), currentBucket);
             }
         } else {
-            // We go to approxBucketSize - 1 because we already added the first value in order
-            // to keep track of the minimum value.
-            for (long long j = 0; j < approxBucketSize - 1; j++) {
-                if (_sortedInput->more()) {
-                    addDocumentToBucket(_sortedInput->next(), currentBucket);
-                } else {
-                    // No more values to process.
-                    break;
-                }
+            // Fill the bucket until it holds approxBucketSize documents. When merging, a value
+            // stands for a whole group of documents with the same 'groupBy' value, so the bucket
+            // ends on the same boundary value as if the documents had been added one by one.
+            while (bucketSize < approxBucketSize && _sortedInput->more()) {
+                bucketSize += addDocumentToBucket(_sortedInput->next(), currentBucket);
             }
 
             boost::optional<pair<Value, Document>> nextValue = _sortedInput->more()
@@ -413,9 +429,64 @@ Value DocumentSourceBucketAuto::serialize(
     }
     insides["output"] = outputSpec.freezeToValue();
 
+    if (_mergeCountField) {
+        insides["$mergeCountField"] = Value(*_mergeCountField);
+    }
+
     return Value{Document{{getSourceName(), insides.freezeToValue()}}};
 }
 
+boost::optional<DocumentSource::DistributedPlanLogic>
+DocumentSourceBucketAuto::distributedPlanLogic() {
+    if (doingMerge()) {
+        // {shardsStage, mergingStage, sortPattern}
+        return DistributedPlanLogic{nullptr, this, boost::none};
+    }
+
+    // Pick a name for the document count which doesn't collide with any of the output fields.
+    std::string countField = "nDocuments";
+    while (std::any_of(_accumulatedFields.begin(),
+                       _accumulatedFields.end(),
+                       [&](const auto& stmt) { return stmt.fieldName == countField; })) {
+        countField += "_";
+    }
+
+    // The shards group their documents by the 'groupBy' value and compute a partial result of
+    // every accumulator for each group, plus the number of documents in the group.
+    std::vector<AccumulationStatement> partialStatements = _accumulatedFields;
+    partialStatements.emplace_back(
+        countField,
+        AccumulationExpression(ExpressionConstant::create(pExpCtx, Value(BSONNULL)),
+                               ExpressionConstant::create(pExpCtx, Value(1)),
+                               [expCtx = pExpCtx] { return AccumulatorSum::create(expCtx); }));
+    auto shardsStage = DocumentSourceGroup::create(
+        pExpCtx,
+        _groupByExpression ? _groupByExpression
+                           : ExpressionConstant::create(pExpCtx, Value(BSONNULL)),
+        std::move(partialStatements));
+
+    // The merger buckets the groups by their _id and merges the partial results of the
+    // accumulators of the same name.
+    VariablesParseState vps = pExpCtx->variablesParseState;
+    std::vector<AccumulationStatement> mergingStatements;
+    for (auto&& accumulatedField : _accumulatedFields) {
+        auto copiedAccumulatedField = accumulatedField;
+        copiedAccumulatedField.expr.argument =
+            ExpressionFieldPath::parse(pExpCtx, "$$ROOT." + copiedAccumulatedField.fieldName, vps);
+        mergingStatements.push_back(std::move(copiedAccumulatedField));
+    }
+    auto mergingStage = create(pExpCtx,
+                               ExpressionFieldPath::parse(pExpCtx, "$$ROOT._id", vps),
+                               _nBuckets,
+                               std::move(mergingStatements),
+                               _granularityRounder,
+                               _maxMemoryUsageBytes);
+    mergingStage->_mergeCountField = std::move(countField);
+
+    // {shardsStage, mergingStage, sortPattern}
+    return DistributedPlanLogic{shardsStage, mergingStage, boost::none};
+}
+
 intrusive_ptr<DocumentSourceBucketAuto> DocumentSourceBucketAuto::create(
     const intrusive_ptr<ExpressionContext>& pExpCtx,
     const boost::intrusive_ptr<Expression>& groupByExpression,
@@ -482,6 +553,7 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
     boost::intrusive_ptr<Expression> groupByExpression;
     boost::optional<int> numBuckets;
     boost::intrusive_ptr<GranularityRounder> granularityRounder;
+    boost::optional<std::string> mergeCountField;
 
     for (auto&& argument : elem.Obj()) {
         const auto argName = argument.fieldNameStringData();
@@ -527,6 +599,13 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
                         << typeName(argument.type()),
                     argument.type() == BSONType::String);
             granularityRounder = GranularityRounder::getGranularityRounder(pExpCtx, argument.str());
+        } else if ("$mergeCountField" == argName) {
+            uassert(4948609,
+                    str::stream() << "The $bucketAuto '$mergeCountField' field must be a string, "
+                                     "but found type: "
+                                  << typeName(argument.type()),
+                    argument.type() == BSONType::String);
+            mergeCountField = argument.str();
         } else {
             uasserted(40245, str::stream() << "Unrecognized option to $bucketAuto: " << argName);
         }
@@ -536,8 +615,10 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
             "$bucketAuto requires 'groupBy' and 'buckets' to be specified",
             groupByExpression && numBuckets);
 
-    return DocumentSourceBucketAuto::create(
+    auto bucketAuto = DocumentSourceBucketAuto::create(
         pExpCtx, groupByExpression, numBuckets.get(), accumulationStatements, granularityRounder);
+    bucketAuto->_mergeCountField = std::move(mergeCountField);
+    return bucketAuto;
 }
 
 }  // namespace mongo
@@ -63,12 +63,13 @@ public:
     }
 
     /**
-     * The $bucketAuto stage must be run on the merging shard.
+     * The bucket boundaries depend on all of the input, so the buckets must be computed on the
+     * merging node. Each shard instead runs a $group on the 'groupBy' value which computes the
+     * partial result of every accumulator along with the number of documents in each group. The
+     * merging $bucketAuto weighs each group by that count, which yields the same boundaries as if
+     * it had seen the raw documents, and merges the partial results into its buckets.
      */
-    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
-        // {shardsStage, mergingStage, sortPattern}
-        return DistributedPlanLogic{nullptr, this, boost::none};
-    }
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final;
 
     static const uint64_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
 
@@ -95,6 +96,14 @@ public:
     const boost::intrusive_ptr<Expression> getGroupByExpression() const;
     const std::vector<AccumulationStatement>& getAccumulatedFields() const;
 
+    /**
+     * Returns true if this stage merges the partial groups produced by the shards half of a split
+     * $bucketAuto, rather than raw documents.
+     */
+    bool doingMerge() const {
+        return _mergeCountField.has_value();
+    }
+
 protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
@@ -137,9 +146,16 @@ private:
     void populateBuckets();
 
     /**
-     * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'.
+     * Returns the number of input documents that 'doc' stands for. This is 1, unless this stage is
+     * merging partial groups, in which case each group carries the number of documents in it.
      */
-    void addDocumentToBucket(const std::pair<Value, Document>& entry, Bucket& bucket);
+    long long countDocuments(const Document& doc) const;
+
+    /**
+     * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'. Returns
+     * the number of input documents that were added.
+     */
+    long long addDocumentToBucket(const std::pair<Value, Document>& entry, Bucket& bucket);
 
     /**
      * Adds 'newBucket' to _buckets and updates any boundaries if necessary.
@@ -165,6 +181,10 @@ private:
     boost::intrusive_ptr<Expression> _groupByExpression;
     boost::intrusive_ptr<GranularityRounder> _granularityRounder;
     long long _nDocuments = 0;
+
+    // Set when merging partial groups, to the name of the field which holds the number of documents
+    // in each group.
+    boost::optional<std::string> _mergeCountField;
 };
 
 }  // namespace mongo
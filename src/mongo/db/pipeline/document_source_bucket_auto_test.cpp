@@ -44,6 +44,7 @@
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_source_bucket_auto.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/unittest/temp_dir.h"
@@ -65,7 +66,10 @@ public:
     vector<Document> getResults(BSONObj bucketAutoSpec, deque<Document> inputs) {
         auto bucketAutoStage = createBucketAuto(bucketAutoSpec);
         assertBucketAutoType(bucketAutoStage);
+        return getResults(bucketAutoStage, std::move(inputs));
+    }
 
+    vector<Document> getResults(intrusive_ptr<DocumentSource> stage, deque<Document> inputs) {
         // Convert Documents to GetNextResults.
         deque<DocumentSource::GetNextResult> mockInputs;
         for (auto&& input : inputs) {
@@ -73,17 +77,66 @@ public:
         }
 
         auto source = DocumentSourceMock::createForTest(std::move(mockInputs), getExpCtx());
-        bucketAutoStage->setSource(source.get());
+        stage->setSource(source.get());
 
         vector<Document> results;
-        for (auto next = bucketAutoStage->getNext(); next.isAdvanced();
-             next = bucketAutoStage->getNext()) {
+        for (auto next = stage->getNext(); next.isAdvanced(); next = stage->getNext()) {
             results.push_back(next.releaseDocument());
         }
 
         return results;
     }
 
+    /**
+     * Splits 'bucketAutoSpec' for a sharded cluster, runs the shards half over each of 'shards' and
+     * the merging half over their output, and checks that the result is the same as running the
+     * unsplit stage over all of the documents. Returns the serialized merging stage.
+     */
+    BSONObj assertSplitMatchesUnsplit(BSONObj bucketAutoSpec, vector<deque<Document>> shards) {
+        unittest::TempDir tempDir("DocumentSourceBucketAutoTest");
+        getExpCtx()->tempDir = tempDir.path();
+
+        deque<Document> allDocs;
+        for (auto&& shard : shards) {
+            allDocs.insert(allDocs.end(), shard.begin(), shard.end());
+        }
+        auto expected = getResults(bucketAutoSpec, allDocs);
+
+        auto logic = createBucketAuto(bucketAutoSpec)->distributedPlanLogic();
+        ASSERT(logic);
+        ASSERT(dynamic_cast<DocumentSourceGroup*>(logic->shardsStage.get()));
+        ASSERT(logic->mergingStage);
+
+        // Each shard, and the merger, parse their half of the split from its serialization.
+        vector<Value> serialized;
+        logic->shardsStage->serializeToArray(serialized);
+        logic->mergingStage->serializeToArray(serialized);
+        ASSERT_EQ(serialized.size(), 2UL);
+        const auto shardsSpec = serialized[0].getDocument().toBson();
+        const auto mergingSpec = serialized[1].getDocument().toBson();
+
+        getExpCtx()->needsMerge = true;
+        deque<Document> partialGroups;
+        for (auto&& shard : shards) {
+            auto group =
+                DocumentSourceGroup::createFromBson(shardsSpec.firstElement(), getExpCtx());
+            for (auto&& partialGroup : getResults(group, shard)) {
+                partialGroups.push_back(std::move(partialGroup));
+            }
+        }
+        getExpCtx()->needsMerge = false;
+
+        // The shards send at most one document per distinct 'groupBy' value.
+        ASSERT_LTE(partialGroups.size(), allDocs.size());
+
+        auto results = getResults(mergingSpec, std::move(partialGroups));
+        ASSERT_EQ(results.size(), expected.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            ASSERT_DOCUMENT_EQ(results[i], expected[i]);
+        }
+        return mergingSpec;
+    }
+
     void testSerialize(BSONObj bucketAutoSpec, BSONObj expectedObj) {
         auto bucketAutoStage = createBucketAuto(bucketAutoSpec);
         assertBucketAutoType(bucketAutoStage);
@@ -815,5 +868,37 @@ TEST_F(BucketAutoTests, ShouldFailOnNegativeNumbersWhenGranularitySpecified) {
         AssertionException,
         40260);
 }
+
+TEST_F(BucketAutoTests, SplitMergesPartialGroupsFromShardsIntoSameBuckets) {
+    auto bucketAutoSpec = fromjson(
+        "{$bucketAuto : {groupBy : '$x', buckets : 3, output : {nDocuments : {$sum : 1}, "
+        "avgY : {$avg : '$y'}, minY : {$min : '$y'}, maxY : {$max : '$y'}}}}");
+    auto mergingSpec = assertSplitMatchesUnsplit(
+        bucketAutoSpec,
+        {{Document{{"x", 1}, {"y", 1}},
+          Document{{"x", 2}, {"y", 2}},
+          Document{{"x", 2}, {"y", 4}},
+          Document{{"x", 5}, {"y", 3}},
+          Document{{"x", 7}, {"y", 1}}},
+         {Document{{"x", 1}, {"y", 5}},
+          Document{{"x", 2}, {"y", 6}},
+          Document{{"x", 3}, {"y", 2}},
+          Document{{"x", 5}, {"y", 7}},
+          Document{{"x", 8}, {"y", 2}},
+          Document{{"x", 9}, {"y", 9}},
+          Document{}}});
+
+    // The count of documents in each partial group must not collide with an output field.
+    ASSERT_EQ(mergingSpec["$bucketAuto"]["$mergeCountField"].str(), "nDocuments_");
+}
+
+TEST_F(BucketAutoTests, SplitMergesPartialGroupsFromShardsIntoSameBucketsWithGranularity) {
+    auto bucketAutoSpec =
+        fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, granularity : 'R5'}}");
+    assertSplitMatchesUnsplit(bucketAutoSpec,
+                              {{Document{{"x", 0}}, Document{{"x", 1.3}}, Document{{"x", 4}}},
+                               {Document{{"x", 0}}, Document{{"x", 1.5}}, Document{{"x", 9}}},
+                               {Document{{"x", 1.3}}, Document{{"x", 25}}}});
+}
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_pack_bucket.h"
+
+#include <iterator>
+#include <limits>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(_internalPackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalPackBucket::createFromBson);
+
+namespace {
+
+void validateFieldName(StringData option, BSONElement elem) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << DocumentSourceInternalPackBucket::kStageName << " '" << option
+                          << "' must be a string, got " << typeName(elem.type()),
+            elem.type() == BSONType::String);
+    const auto name = elem.valueStringData();
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << DocumentSourceInternalPackBucket::kStageName << " '" << option
+                          << "' must be a non-empty top-level field name, got '" << name << "'",
+            !name.empty() && name.find('.') == std::string::npos && name[0] != '$');
+}
+
+int parsePositiveInt(StringData option, BSONElement elem) {
+    const auto value = elem.parseIntegerElementToNonNegativeLong();
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << DocumentSourceInternalPackBucket::kStageName << " '" << option
+                          << "' must be a positive integer no greater than "
+                          << std::numeric_limits<int>::max() << ", got " << elem,
+            value.isOK() && value.getValue() > 0 &&
+                value.getValue() <= std::numeric_limits<int>::max());
+    return static_cast<int>(value.getValue());
+}
+
+}  // namespace
+
+DocumentSourceInternalPackBucket::DocumentSourceInternalPackBucket(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    timeseries::BucketGrouper::Options options)
+    : DocumentSource(kStageName, expCtx), _bucketGrouper(std::move(options)) {}
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceInternalPackBucket::createFromBson(
+    BSONElement specElem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " specification must be an object, got "
+                          << typeName(specElem.type()),
+            specElem.type() == BSONType::Object);
+
+    timeseries::BucketGrouper::Options options;
+    bool hasTimeField = false;
+    for (auto&& elem : specElem.embeddedObject()) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kTimeFieldName) {
+            validateFieldName(kTimeFieldName, elem);
+            options.spec.timeField = elem.str();
+            hasTimeField = true;
+        } else if (fieldName == kMetaFieldName) {
+            validateFieldName(kMetaFieldName, elem);
+            options.spec.metaField = elem.str();
+        } else if (fieldName == kBucketMaxSpanSecondsFieldName) {
+            options.maxSpan = Seconds(parsePositiveInt(kBucketMaxSpanSecondsFieldName, elem));
+        } else if (fieldName == kBucketMaxCountFieldName) {
+            options.maxCount = parsePositiveInt(kBucketMaxCountFieldName, elem);
+        } else {
+            uasserted(ErrorCodes::FailedToParse,
+                      str::stream() << "unrecognized option to " << kStageName << ": "
+                                    << fieldName);
+        }
+    }
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " requires a '" << kTimeFieldName << "'",
+            hasTimeField);
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " '" << kTimeFieldName << "' and '" << kMetaFieldName
+                          << "' must differ",
+            !options.spec.metaField || *options.spec.metaField != options.spec.timeField);
+
+    return make_intrusive<DocumentSourceInternalPackBucket>(expCtx, std::move(options));
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalPackBucket::doGetNext() {
+    while (_closedBuckets.empty()) {
+        auto nextInput = pSource->getNext();
+        std::vector<BSONObj> closed;
+        if (nextInput.isAdvanced()) {
+            closed = _bucketGrouper.insert(nextInput.releaseDocument().toBson());
+        } else if (nextInput.isEOF()) {
+            closed = _bucketGrouper.closeAll();
+            if (closed.empty()) {
+                return nextInput;
+            }
+        } else {
+            return nextInput;
+        }
+        std::move(closed.begin(), closed.end(), std::back_inserter(_closedBuckets));
+    }
+    auto bucket = std::move(_closedBuckets.front());
+    _closedBuckets.pop_front();
+    return Document(bucket);
+}
+
+Value DocumentSourceInternalPackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    const auto& options = _bucketGrouper.options();
+    MutableDocument out;
+    out.addField(kTimeFieldName, Value(options.spec.timeField));
+    if (options.spec.metaField) {
+        out.addField(kMetaFieldName, Value(*options.spec.metaField));
+    }
+    out.addField(kBucketMaxSpanSecondsFieldName, Value(durationCount<Seconds>(options.maxSpan)));
+    out.addField(kBucketMaxCountFieldName, Value(static_cast<long long>(options.maxCount)));
+    return Value(DOC(getSourceName() << out.freeze()));
+}
+
+}  // namespace mongo
@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/timeseries/bucket_builder.h"
+
+namespace mongo {
+
+/**
+ * Packs time-series measurements into bucket documents, the inverse of $_internalUnpackBucket:
+ *
+ * {$_internalPackBucket: {timeField: <field>, metaField: <field>, bucketMaxSpanSeconds: <n>,
+ *                         bucketMaxCount: <n>}}
+ *
+ * Measurements are grouped by meta value and time window, and a bucket is returned as soon as it
+ * is closed, so the stage streams. Followed by $merge or $out, it writes a collection of buckets
+ * from a collection with one document per measurement.
+ */
+class DocumentSourceInternalPackBucket final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalPackBucket"_sd;
+    static constexpr StringData kTimeFieldName = "timeField"_sd;
+    static constexpr StringData kMetaFieldName = "metaField"_sd;
+    static constexpr StringData kBucketMaxSpanSecondsFieldName = "bucketMaxSpanSeconds"_sd;
+    static constexpr StringData kBucketMaxCountFieldName = "bucketMaxCount"_sd;
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    DocumentSourceInternalPackBucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                     timeseries::BucketGrouper::Options options);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed,
+                LookupRequirement::kAllowed,
+                UnionRequirement::kAllowed};
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+private:
+    GetNextResult doGetNext() final;
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    timeseries::BucketGrouper _bucketGrouper;
+
+    // Buckets closed by the last measurement, or at the end of the input, not yet returned.
+    std::deque<BSONObj> _closedBuckets;
+};
+
+}  // namespace mongo
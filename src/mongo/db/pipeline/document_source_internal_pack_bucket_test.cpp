@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_pack_bucket.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/timeseries/bucket_builder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using InternalPackBucketTest = AggregationContextFixture;
+
+const Date_t kStart = Date_t::fromMillisSinceEpoch(1600000000000);
+
+boost::intrusive_ptr<DocumentSource> makePackStage(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, int maxSpanSeconds, int maxCount) {
+    auto spec = BSON("$_internalPackBucket" << BSON("timeField"
+                                                    << "t"
+                                                    << "metaField"
+                                                    << "m"
+                                                    << "bucketMaxSpanSeconds" << maxSpanSeconds
+                                                    << "bucketMaxCount" << maxCount));
+    return DocumentSourceInternalPackBucket::createFromBson(spec.firstElement(), expCtx);
+}
+
+BSONObj makeMeasurement(int seconds, StringData sensor) {
+    return BSON("t" << kStart + Seconds(seconds) << "m" << sensor << "v" << seconds * 0.5);
+}
+
+TEST_F(InternalPackBucketTest, ReturnsBucketsAsTheyAreClosed) {
+    auto pack = makePackStage(getExpCtx(), 3600, 2);
+    auto mock = DocumentSourceMock::createForTest(
+        {Document(makeMeasurement(0, "a")),
+         Document(makeMeasurement(1, "b")),
+         Document(makeMeasurement(2, "a")),
+         DocumentSource::GetNextResult::makePauseExecution(),
+         Document(makeMeasurement(3, "a"))},
+        getExpCtx());
+    pack->setSource(mock.get());
+
+    // No bucket is full before the pause, which is passed on.
+    ASSERT_TRUE(pack->getNext().isPaused());
+
+    // The third measurement of series "a" closes its full bucket.
+    auto next = pack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto bucket = next.releaseDocument().toBson();
+    ASSERT_BSONOBJ_EQ(bucket[timeseries::kBucketMetaFieldName].wrap(), BSON("meta" << "a"));
+    ASSERT_EQ(bucket[timeseries::kBucketControlFieldName][timeseries::kControlCountFieldName]
+                  .numberInt(),
+              2);
+
+    // The end of the input closes the remaining buckets.
+    std::vector<BSONObj> remaining;
+    for (next = pack->getNext(); next.isAdvanced(); next = pack->getNext()) {
+        remaining.push_back(next.releaseDocument().toBson());
+    }
+    ASSERT_TRUE(next.isEOF());
+    ASSERT_EQ(remaining.size(), 2U);
+    ASSERT_TRUE(pack->getNext().isEOF());
+}
+
+TEST_F(InternalPackBucketTest, UnpackRestoresPackedMeasurements) {
+    std::deque<DocumentSource::GetNextResult> measurements;
+    for (int i = 0; i < 10; ++i) {
+        measurements.emplace_back(Document(makeMeasurement(i * 30, i % 2 ? "a" : "b")));
+    }
+    auto mock = DocumentSourceMock::createForTest(measurements, getExpCtx());
+    auto pack = makePackStage(getExpCtx(), 60, 1000);
+    pack->setSource(mock.get());
+    auto unpackSpec = BSON("$_internalUnpackBucket" << BSON("timeField"
+                                                            << "t"
+                                                            << "metaField"
+                                                            << "m"));
+    auto unpack =
+        DocumentSourceInternalUnpackBucket::createFromBson(unpackSpec.firstElement(), getExpCtx());
+    unpack->setSource(pack.get());
+
+    std::vector<BSONObj> unpacked;
+    for (auto next = unpack->getNext(); next.isAdvanced(); next = unpack->getNext()) {
+        unpacked.push_back(next.releaseDocument().toBson());
+    }
+    ASSERT_EQ(unpacked.size(), 10U);
+    std::sort(unpacked.begin(), unpacked.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs["t"].Date() < rhs["t"].Date();
+    });
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_BSONOBJ_EQ(unpacked[i], makeMeasurement(i * 30, i % 2 ? "a" : "b"));
+    }
+}
+
+TEST_F(InternalPackBucketTest, RejectsInvalidSpecs) {
+    auto expCtx = getExpCtx();
+    auto parse = [&](BSONObj spec) {
+        return DocumentSourceInternalPackBucket::createFromBson(
+            BSON("$_internalPackBucket" << spec).firstElement(), expCtx);
+    };
+    ASSERT_THROWS_CODE(parse(BSONObj()), AssertionException, ErrorCodes::FailedToParse);
+    ASSERT_THROWS_CODE(parse(BSON("timeField" << 1)), AssertionException, ErrorCodes::TypeMismatch);
+    ASSERT_THROWS_CODE(parse(BSON("timeField"
+                                  << "t"
+                                  << "metaField"
+                                  << "t")),
+                       AssertionException,
+                       ErrorCodes::FailedToParse);
+    for (auto&& option : {"bucketMaxSpanSeconds", "bucketMaxCount"}) {
+        for (auto&& value : {BSON("" << 0), BSON("" << -1), BSON("" << 1.5), BSON("" << "1")}) {
+            ASSERT_THROWS_CODE(parse(BSON("timeField"
+                                          << "t" << option << value.firstElement())),
+                               AssertionException,
+                               ErrorCodes::FailedToParse);
+        }
+    }
+}
+
+TEST_F(InternalPackBucketTest, SerializesSpec) {
+    auto pack = makePackStage(getExpCtx(), 60, 100);
+    std::vector<Value> serialized;
+    pack->serializeToArray(serialized);
+    ASSERT_EQ(serialized.size(), 1U);
+    ASSERT_BSONOBJ_EQ(serialized[0].getDocument().toBson(),
+                      BSON("$_internalPackBucket" << BSON("timeField"
+                                                          << "t"
+                                                          << "metaField"
+                                                          << "m"
+                                                          << "bucketMaxSpanSeconds" << 60LL
+                                                          << "bucketMaxCount" << 100LL)));
+}
+
+}  // namespace
+}  // namespace mongo
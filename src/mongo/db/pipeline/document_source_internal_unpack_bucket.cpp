@@ -0,0 +1,235 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(_internalUnpackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalUnpackBucket::createFromBson);
+
+namespace {
+
+void validateFieldName(StringData option, BSONElement elem) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << DocumentSourceInternalUnpackBucket::kStageName << " '" << option
+                          << "' must be a string, got " << typeName(elem.type()),
+            elem.type() == BSONType::String);
+    const auto name = elem.valueStringData();
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << DocumentSourceInternalUnpackBucket::kStageName << " '" << option
+                          << "' must be a non-empty top-level field name, got '" << name << "'",
+            !name.empty() && name.find('.') == std::string::npos && name[0] != '$');
+}
+
+/**
+ * Appends to 'out' the bucket-level predicates implied by the predicate 'elem' on the time field
+ * of measurements. Only comparisons against dates are translated, since the bounds in a bucket's
+ * control fields are dates.
+ */
+void appendTimeBucketPredicates(const timeseries::BucketSpec& spec,
+                                BSONElement elem,
+                                BSONArrayBuilder* out) {
+    const std::string minField = str::stream() << timeseries::kBucketControlFieldName << "."
+                                               << timeseries::kControlMinFieldName << "."
+                                               << spec.timeField;
+    const std::string maxField = str::stream() << timeseries::kBucketControlFieldName << "."
+                                               << timeseries::kControlMaxFieldName << "."
+                                               << spec.timeField;
+
+    auto appendPredicate = [&](const std::string& field, StringData op, BSONElement operand) {
+        BSONObjBuilder predicate(out->subobjStart());
+        BSONObjBuilder comparison(predicate.subobjStart(field));
+        comparison.appendAs(operand, op);
+    };
+    // A bucket can hold a measurement equal to 'operand' only if 'operand' is within its bounds.
+    auto appendEquality = [&](BSONElement operand) {
+        appendPredicate(minField, "$lte", operand);
+        appendPredicate(maxField, "$gte", operand);
+    };
+
+    if (elem.type() == BSONType::Date) {
+        appendEquality(elem);
+        return;
+    }
+    if (elem.type() != BSONType::Object ||
+        !elem.Obj().firstElementFieldNameStringData().startsWith("$")) {
+        return;
+    }
+    for (auto&& opElem : elem.Obj()) {
+        if (opElem.type() != BSONType::Date) {
+            continue;
+        }
+        const auto op = opElem.fieldNameStringData();
+        if (op == "$gt" || op == "$gte") {
+            appendPredicate(maxField, op, opElem);
+        } else if (op == "$lt" || op == "$lte") {
+            appendPredicate(minField, op, opElem);
+        } else if (op == "$eq") {
+            appendEquality(opElem);
+        }
+    }
+}
+
+}  // namespace
+
+DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, timeseries::BucketSpec spec)
+    : DocumentSource(kStageName, expCtx), _bucketUnpacker(std::move(spec)) {}
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBson(
+    BSONElement specElem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " specification must be an object, got "
+                          << typeName(specElem.type()),
+            specElem.type() == BSONType::Object);
+
+    timeseries::BucketSpec spec;
+    bool hasTimeField = false;
+    for (auto&& elem : specElem.embeddedObject()) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kTimeFieldName) {
+            validateFieldName(kTimeFieldName, elem);
+            spec.timeField = elem.str();
+            hasTimeField = true;
+        } else if (fieldName == kMetaFieldName) {
+            validateFieldName(kMetaFieldName, elem);
+            spec.metaField = elem.str();
+        } else {
+            uasserted(ErrorCodes::FailedToParse,
+                      str::stream() << "unrecognized option to " << kStageName << ": "
+                                    << fieldName);
+        }
+    }
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " requires a '" << kTimeFieldName << "'",
+            hasTimeField);
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " '" << kTimeFieldName << "' and '" << kMetaFieldName
+                          << "' must differ",
+            !spec.metaField || *spec.metaField != spec.timeField);
+
+    return make_intrusive<DocumentSourceInternalUnpackBucket>(expCtx, std::move(spec));
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
+    while (!_bucketUnpacker.hasNext()) {
+        auto nextInput = pSource->getNext();
+        if (!nextInput.isAdvanced()) {
+            return nextInput;
+        }
+        _bucketUnpacker.reset(nextInput.releaseDocument().toBson());
+    }
+    return Document(_bucketUnpacker.getNext());
+}
+
+BSONObj DocumentSourceInternalUnpackBucket::createBucketFilter(const BSONObj& matchQuery) const {
+    const auto& spec = _bucketUnpacker.spec();
+    BSONArrayBuilder predicates;
+
+    auto addPredicate = [&](BSONElement elem) {
+        const auto path = elem.fieldNameStringData();
+        if (path == spec.timeField) {
+            appendTimeBucketPredicates(spec, elem, &predicates);
+            return;
+        }
+        // Every measurement in a bucket has the bucket's meta value, so a predicate on it can be
+        // applied to the bucket as is.
+        if (spec.metaField &&
+            (path == *spec.metaField || path.startsWith(*spec.metaField + "."))) {
+            BSONObjBuilder predicate(predicates.subobjStart());
+            predicate.appendAs(elem,
+                               str::stream() << timeseries::kBucketMetaFieldName
+                                             << path.substr(spec.metaField->size()));
+        }
+    };
+
+    for (auto&& elem : matchQuery) {
+        if (elem.fieldNameStringData() == "$and" && elem.type() == BSONType::Array) {
+            for (auto&& clause : elem.Obj()) {
+                if (clause.type() == BSONType::Object) {
+                    for (auto&& clauseElem : clause.Obj()) {
+                        addPredicate(clauseElem);
+                    }
+                }
+            }
+        } else {
+            addPredicate(elem);
+        }
+    }
+
+    auto array = predicates.arr();
+    if (array.isEmpty()) {
+        return BSONObj();
+    }
+    return BSON("$and" << array);
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    if (std::next(itr) == container->end()) {
+        return container->end();
+    }
+
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>((*std::next(itr)).get());
+    if (nextMatch && !_triedBucketFilterPushdown) {
+        _triedBucketFilterPushdown = true;
+        const BSONObj bucketFilter = createBucketFilter(nextMatch->getQuery());
+        if (!bucketFilter.isEmpty()) {
+            // As with $redact, the original $match stays after this stage to filter individual
+            // measurements, so we must not step back to optimize the new $match.
+            container->insert(itr, DocumentSourceMatch::create(bucketFilter, pExpCtx));
+        }
+    }
+    return std::next(itr);
+}
+
+Value DocumentSourceInternalUnpackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    const auto& spec = _bucketUnpacker.spec();
+    MutableDocument out;
+    out.addField(kTimeFieldName, Value(spec.timeField));
+    if (spec.metaField) {
+        out.addField(kMetaFieldName, Value(*spec.metaField));
+    }
+    return Value(DOC(getSourceName() << out.freeze()));
+}
+
+}  // namespace mongo
@@ -0,0 +1,176 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/timeseries/bucket_builder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using InternalUnpackBucketTest = AggregationContextFixture;
+
+const Date_t kStart = Date_t::fromMillisSinceEpoch(1600000000000);
+
+boost::intrusive_ptr<DocumentSource> makeUnpackStage(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    auto spec = BSON("$_internalUnpackBucket" << BSON("timeField"
+                                                      << "t"
+                                                      << "metaField"
+                                                      << "m"));
+    return DocumentSourceInternalUnpackBucket::createFromBson(spec.firstElement(), expCtx);
+}
+
+BSONObj makeBucket(int first, int count) {
+    timeseries::BucketBuilder builder({"t", std::string("m")});
+    for (int i = first; i < first + count; ++i) {
+        builder.add(BSON("t" << kStart + Seconds(i) << "m"
+                             << "sensor"
+                             << "v" << i * 0.5));
+    }
+    return builder.finish(OID::gen());
+}
+
+TEST_F(InternalUnpackBucketTest, UnpacksEveryMeasurementOfEveryBucket) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    auto mock = DocumentSourceMock::createForTest(
+        {Document(makeBucket(0, 2)),
+         DocumentSource::GetNextResult::makePauseExecution(),
+         Document(makeBucket(2, 1))},
+        getExpCtx());
+    unpack->setSource(mock.get());
+
+    for (int i = 0; i < 3; ++i) {
+        auto next = unpack->getNext();
+        if (i == 2) {
+            // The pause is only seen once the first bucket is exhausted.
+            ASSERT_TRUE(next.isPaused());
+            next = unpack->getNext();
+        }
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.getDocument(),
+                           Document(BSON("t" << kStart + Seconds(i) << "m"
+                                             << "sensor"
+                                             << "v" << i * 0.5)));
+    }
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(InternalUnpackBucketTest, RejectsInvalidSpecs) {
+    auto expCtx = getExpCtx();
+    auto parse = [&](BSONObj spec) {
+        return DocumentSourceInternalUnpackBucket::createFromBson(
+            BSON("$_internalUnpackBucket" << spec).firstElement(), expCtx);
+    };
+    ASSERT_THROWS_CODE(parse(BSONObj()), AssertionException, ErrorCodes::FailedToParse);
+    ASSERT_THROWS_CODE(parse(BSON("timeField" << 1)), AssertionException, ErrorCodes::TypeMismatch);
+    ASSERT_THROWS_CODE(parse(BSON("timeField"
+                                  << "a.b")),
+                       AssertionException,
+                       ErrorCodes::FailedToParse);
+    ASSERT_THROWS_CODE(parse(BSON("timeField"
+                                  << "t"
+                                  << "metaField"
+                                  << "t")),
+                       AssertionException,
+                       ErrorCodes::FailedToParse);
+    ASSERT_THROWS_CODE(parse(BSON("timeField"
+                                  << "t"
+                                  << "other" << 1)),
+                       AssertionException,
+                       ErrorCodes::FailedToParse);
+}
+
+TEST_F(InternalUnpackBucketTest, SerializesSpec) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    std::vector<Value> serialized;
+    unpack->serializeToArray(serialized);
+    ASSERT_EQ(serialized.size(), 1U);
+    ASSERT_BSONOBJ_EQ(serialized[0].getDocument().toBson(),
+                      BSON("$_internalUnpackBucket" << BSON("timeField"
+                                                            << "t"
+                                                            << "metaField"
+                                                            << "m")));
+}
+
+TEST_F(InternalUnpackBucketTest, TranslatesTimeAndMetaPredicates) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    auto* stage = static_cast<DocumentSourceInternalUnpackBucket*>(unpack.get());
+    const auto date = kStart + Seconds(10);
+
+    ASSERT_BSONOBJ_EQ(
+        stage->createBucketFilter(BSON("t" << BSON("$gte" << date << "$lt" << date) << "m.a" << 1
+                                           << "v" << 2)),
+        BSON("$and" << BSON_ARRAY(BSON("control.max.t" << BSON("$gte" << date))
+                                  << BSON("control.min.t" << BSON("$lt" << date))
+                                  << BSON("meta.a" << 1))));
+    ASSERT_BSONOBJ_EQ(
+        stage->createBucketFilter(BSON("$and" << BSON_ARRAY(BSON("t" << date) << BSON("m" << 2)))),
+        BSON("$and" << BSON_ARRAY(BSON("control.min.t" << BSON("$lte" << date))
+                                  << BSON("control.max.t" << BSON("$gte" << date))
+                                  << BSON("meta" << 2))));
+
+    // Predicates on other fields, or that do not compare the time against a date, stay behind.
+    ASSERT_BSONOBJ_EQ(stage->createBucketFilter(BSON("v" << 1 << "t" << BSON("$gt" << 5))),
+                      BSONObj());
+    ASSERT_BSONOBJ_EQ(stage->createBucketFilter(BSON("mm" << 1)), BSONObj());
+}
+
+TEST_F(InternalUnpackBucketTest, AddsBucketFilterBeforeItselfOnlyOnce) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    auto match =
+        DocumentSourceMatch::create(BSON("t" << BSON("$gt" << kStart) << "v" << 1), getExpCtx());
+
+    Pipeline::SourceContainer pipeline;
+    pipeline.push_back(unpack);
+    pipeline.push_back(match);
+
+    unpack->optimizeAt(pipeline.begin(), &pipeline);
+    ASSERT_EQUALS(pipeline.size(), 3U);
+    auto bucketMatch = dynamic_cast<DocumentSourceMatch*>(pipeline.front().get());
+    ASSERT(bucketMatch);
+    ASSERT_BSONOBJ_EQ(bucketMatch->getQuery(),
+                      BSON("$and" << BSON_ARRAY(BSON("control.max.t" << BSON("$gt" << kStart)))));
+
+    unpack->optimizeAt(std::next(pipeline.begin()), &pipeline);
+    ASSERT_EQUALS(pipeline.size(), 3U);
+}
+
+}  // namespace
+}  // namespace mongo
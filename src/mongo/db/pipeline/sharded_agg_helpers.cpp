@@ -36,6 +36,7 @@
 #include "mongo/db/logical_clock.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -668,6 +669,87 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, mergePipeline, *routingInfo.cm());
 }
 
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx,
+    const Pipeline* mergePipeline,
+    const std::set<ShardId>& targetedShards) {
+    if (internalQueryDisableExchange.load() || !internalQueryEnableGroupExchange.load()) {
+        return boost::none;
+    }
+
+    // The consumers are already participants in the transaction, so they would reject the read
+    // concern which is sent with the consumer pipelines.
+    if (TransactionRouter::get(opCtx)) {
+        return boost::none;
+    }
+
+    if (targetedShards.size() < 2u) {
+        return boost::none;
+    }
+
+    const auto& sources = mergePipeline->getSources();
+    if (sources.empty()) {
+        return boost::none;
+    }
+
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+    if (!groupStage || !groupStage->doingMerge()) {
+        return boost::none;
+    }
+
+    // Group keys which compare equal under a non-simple collation may hash differently, and would
+    // then be finalized on different shards.
+    if (mergePipeline->getContext()->getCollator()) {
+        return boost::none;
+    }
+
+    // Every stage after the $group must be able to process each consumer's slice of the groups
+    // independently. Stages with their own merge logic (e.g. $sort, $limit) need to see all of the
+    // groups at once, and stages which must run on a particular host or which write data cannot be
+    // duplicated across the consumers.
+    for (auto it = std::next(sources.begin()); it != sources.end(); ++it) {
+        const auto constraints = (*it)->constraints(Pipeline::SplitState::kSplitForMerge);
+        if ((*it)->distributedPlanLogic() ||
+            constraints.streamType != StageConstraints::StreamType::kStreaming ||
+            constraints.hostRequirement != StageConstraints::HostTypeRequirement::kNone ||
+            constraints.writesPersistentData()) {
+            return boost::none;
+        }
+    }
+
+    // Use the targeted shards as the consumers, so that no additional shard has to take part in the
+    // query, and split the hashed key space into equal ranges, one for each consumer.
+    const size_t numConsumers = std::min(targetedShards.size(), Exchange::kMaxNumberConsumers);
+    const long long step = std::numeric_limits<long long>::max() / numConsumers;
+
+    std::vector<BSONObj> boundaries;
+    std::vector<int> consumerIds;
+    boundaries.push_back(BSON("_id" << MINKEY));
+    for (size_t idx = 1; idx < numConsumers; ++idx) {
+        // The hashed key space is twice as large as 'max()', so the offset is added twice.
+        const long long offset = step * static_cast<long long>(idx);
+        const long long split = std::numeric_limits<long long>::min() + offset + offset;
+        boundaries.push_back(BSON("_id" << split));
+    }
+    boundaries.push_back(BSON("_id" << MAXKEY));
+    for (size_t idx = 0; idx < numConsumers; ++idx) {
+        consumerIds.push_back(idx);
+    }
+
+    std::vector<ShardId> consumerShards(targetedShards.begin(), targetedShards.end());
+    consumerShards.resize(numConsumers);
+
+    ExchangeSpec exchangeSpec;
+    exchangeSpec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    exchangeSpec.setKey(BSON("_id"
+                             << "hashed"));
+    exchangeSpec.setBoundaries(std::move(boundaries));
+    exchangeSpec.setConsumers(numConsumers);
+    exchangeSpec.setConsumerIds(std::move(consumerIds));
+
+    return ShardedExchangePolicy{std::move(exchangeSpec), std::move(consumerShards)};
+}
+
 SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
     auto& expCtx = pipeline->getContext();
     // Re-brand 'pipeline' as the merging pipeline. We will move stages one by one from the merging
@@ -818,6 +900,10 @@ DispatchShardPipelineResults dispatchShardPipeline(
         splitPipelines = splitPipeline(std::move(pipeline));
 
         exchangeSpec = checkIfEligibleForExchange(opCtx, splitPipelines->mergePipeline.get());
+        if (!exchangeSpec) {
+            exchangeSpec = checkIfEligibleForGroupExchange(
+                opCtx, splitPipelines->mergePipeline.get(), shardIds);
+        }
     }
 
     // Generate the command object for the targeted shards.
@@ -105,6 +105,19 @@ struct DispatchShardPipelineResults {
 boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationContext* opCtx,
                                                                   const Pipeline* mergePipeline);
 
+/**
+ * If the merging pipeline begins with a merging $group whose output can be finalized in parallel,
+ * returns an exchange which hash-partitions the partial groups by their _id across
+ * 'targetedShards'. Each of those shards then merges a disjoint subset of the groups, and the
+ * results are unioned. Returns boost::none if the pipeline is not eligible, for instance because a
+ * later stage needs to see every group, because the query has a non-simple collation or because
+ * it runs in a multi-document transaction.
+ */
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    OperationContext* opCtx,
+    const Pipeline* mergePipeline,
+    const std::set<ShardId>& targetedShards);
+
 /**
  * Split the current Pipeline into a Pipeline for each shard, and a Pipeline that combines the
  * results within a merging process. This call also performs optimizations with the aim of reducing
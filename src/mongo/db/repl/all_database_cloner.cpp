@@ -56,51 +56,6 @@ BaseCloner::ClonerStages AllDatabaseCloner::getStages() {
     return {&_connectStage, &_getInitialSyncIdStage, &_listDatabasesStage};
 }
 
-Status AllDatabaseCloner::ensurePrimaryOrSecondary(
-    const executor::RemoteCommandResponse& isMasterReply) {
-    if (!isMasterReply.isOK()) {
-        LOGV2(21054, "Cannot reconnect because isMaster command failed");
-        return isMasterReply.status;
-    }
-    if (isMasterReply.data["ismaster"].trueValue() || isMasterReply.data["secondary"].trueValue())
-        return Status::OK();
-
-    // There is a window during startup where a node has an invalid configuration and will have
-    // an isMaster response the same as a removed node.  So we must check to see if the node is
-    // removed by checking local configuration.
-    auto memberData = ReplicationCoordinator::get(getGlobalServiceContext())->getMemberData();
-    auto syncSourceIter = std::find_if(
-        memberData.begin(), memberData.end(), [source = getSource()](const MemberData& member) {
-            return member.getHostAndPort() == source;
-        });
-    if (syncSourceIter == memberData.end()) {
-        Status status(ErrorCodes::NotMasterOrSecondary,
-                      str::stream() << "Sync source " << getSource()
-                                    << " has been removed from the replication configuration.");
-        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
-        // Setting the status in the shared data will cancel the initial sync.
-        getSharedData()->setInitialSyncStatusIfOK(lk, status);
-        return status;
-    }
-
-    // We also check if the sync source has gone into initial sync itself.  If so, we'll never be
-    // able to sync from it and we should abort the attempt.  Because there is a window during
-    // startup where a node will report being in STARTUP2 even if it is not in initial sync,
-    // we also check to see if it has a sync source.  A node in STARTUP2 will not have a sync
-    // source unless it is in initial sync.
-    if (syncSourceIter->getState().startup2() && !syncSourceIter->getSyncSource().empty()) {
-        Status status(ErrorCodes::NotMasterOrSecondary,
-                      str::stream() << "Sync source " << getSource() << " has been resynced.");
-        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
-        // Setting the status in the shared data will cancel the initial sync.
-        getSharedData()->setInitialSyncStatusIfOK(lk, status);
-        return status;
-    }
-    return Status(ErrorCodes::NotMasterOrSecondary,
-                  str::stream() << "Cannot connect because sync source " << getSource()
-                                << " is neither primary nor secondary.");
-}
-
 BaseCloner::AfterStageBehavior AllDatabaseCloner::connectStage() {
     auto* client = getClient();
     // If the client already has the address (from a previous attempt), we must allow it to
@@ -0,0 +1,209 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kReplicationInitialSync
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/backup_file_cloner.h"
+
+#include <boost/filesystem.hpp>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/client/dbclient_connection.h"
+#include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+/**
+ * Throws unless 'fileName', as named by the sync source, is a relative path that stays under
+ * 'destinationDir' once joined to it.
+ */
+void validateBackupFileName(const std::string& fileName, const std::string& destinationDir) {
+    const boost::filesystem::path relativePath(fileName);
+    uassert(ErrorCodes::InvalidPath,
+            str::stream() << "Sync source returned an empty or absolute backup file path: '"
+                          << fileName << "'",
+            !relativePath.empty() && !relativePath.has_root_name() &&
+                !relativePath.has_root_directory());
+    for (auto&& component : relativePath) {
+        uassert(ErrorCodes::InvalidPath,
+                str::stream() << "Sync source returned a backup file path with a '..' component: "
+                              << fileName,
+                component != "..");
+    }
+
+    const auto destination = boost::filesystem::path(destinationDir).lexically_normal();
+    const auto localPath = (destination / relativePath).lexically_normal();
+    const auto pathUnderDestination = localPath.lexically_relative(destination);
+    uassert(ErrorCodes::InvalidPath,
+            str::stream() << "Backup file " << fileName << " is not under " << destinationDir,
+            !pathUnderDestination.empty() && pathUnderDestination != "." &&
+                *pathUnderDestination.begin() != "..");
+}
+
+}  // namespace
+
+BackupFileCloner::BackupFileCloner(const UUID& backupId,
+                                   const std::string& fileName,
+                                   uint64_t fileSize,
+                                   const std::string& destinationDir,
+                                   InitialSyncSharedData* sharedData,
+                                   const HostAndPort& source,
+                                   DBClientConnection* client,
+                                   StorageInterface* storageInterface,
+                                   ThreadPool* dbPool)
+    : BaseCloner("BackupFileCloner"_sd, sharedData, source, client, storageInterface, dbPool),
+      _backupId(backupId),
+      _fileName(fileName),
+      _fileSize(fileSize),
+      _destinationDir(destinationDir),
+      _localPath((boost::filesystem::path(destinationDir) / fileName).string()),
+      _copyFileStage("copyFile", this, &BackupFileCloner::copyFileStage) {
+    _stats.file = fileName;
+    _stats.fileSize = fileSize;
+}
+
+BaseCloner::ClonerStages BackupFileCloner::getStages() {
+    return {&_copyFileStage};
+}
+
+void BackupFileCloner::preStage() {
+    validateBackupFileName(_fileName, _destinationDir);
+    const boost::filesystem::path localPath(_localPath);
+    boost::filesystem::create_directories(localPath.parent_path());
+    _localFile.open(_localPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    uassert(ErrorCodes::FileOpenFailed,
+            str::stream() << "Failed to open file " << _localPath << " for writing",
+            _localFile.is_open());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.start = getSharedData()->getClock()->now();
+}
+
+BaseCloner::AfterStageBehavior BackupFileCloner::copyFileStage() {
+    uint64_t bytesCopied = getStats().bytesCopied;
+    while (bytesCopied < _fileSize) {
+        const auto length =
+            std::min(static_cast<uint64_t>(kChunkSizeBytes), _fileSize - bytesCopied);
+        BSONObj reply;
+        getClient()->runCommand("admin",
+                                BSON("_replBackupReadFileChunk"
+                                     << _backupId << "file" << _fileName << "offset"
+                                     << static_cast<long long>(bytesCopied) << "length"
+                                     << static_cast<long long>(length)),
+                                reply);
+        uassertStatusOK(getStatusFromCommandResult(reply));
+
+        const auto data = reply["data"];
+        uassert(ErrorCodes::TypeMismatch,
+                str::stream() << "Sync source returned an invalid backup file chunk: " << reply,
+                data.type() == BinData);
+        int dataLength;
+        const char* chunk = data.binData(dataLength);
+        uassert(ErrorCodes::InitialSyncFailure,
+                str::stream() << "Backup file " << _fileName << " ended after " << bytesCopied
+                              << " of " << _fileSize << " bytes",
+                dataLength > 0 && static_cast<uint64_t>(dataLength) <= length);
+
+        _localFile.write(chunk, dataLength);
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to write to file " << _localPath,
+                _localFile.good());
+        bytesCopied += dataLength;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _stats.bytesCopied = bytesCopied;
+            ++_stats.receivedBatches;
+        }
+        // The chunk is in the local file, so a retry after this point resumes from the next one.
+        clearRetryingState();
+    }
+    return kContinueNormally;
+}
+
+void BackupFileCloner::postStage() {
+    _localFile.close();
+    uassert(ErrorCodes::FileStreamFailed,
+            str::stream() << "Failed to close file " << _localPath,
+            !_localFile.fail());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.end = getSharedData()->getClock()->now();
+    LOGV2_DEBUG(4948603,
+                1,
+                "Copied backup file",
+                "file"_attr = _fileName,
+                "bytesCopied"_attr = _stats.bytesCopied,
+                "receivedBatches"_attr = _stats.receivedBatches);
+}
+
+bool BackupFileCloner::isMyFailPoint(const BSONObj& data) const {
+    auto file = data["file"].str();
+    return (file.empty() || file == _fileName) && BaseCloner::isMyFailPoint(data);
+}
+
+BackupFileCloner::Stats BackupFileCloner::getStats() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _stats;
+}
+
+std::string BackupFileCloner::Stats::toString() const {
+    return toBSON().toString();
+}
+
+BSONObj BackupFileCloner::Stats::toBSON() const {
+    BSONObjBuilder bob;
+    bob.append("file", file);
+    append(&bob);
+    return bob.obj();
+}
+
+void BackupFileCloner::Stats::append(BSONObjBuilder* builder) const {
+    builder->appendNumber("fileSize", static_cast<long long>(fileSize));
+    builder->appendNumber("bytesCopied", static_cast<long long>(bytesCopied));
+    builder->appendNumber("receivedBatches", static_cast<long long>(receivedBatches));
+    if (start != Date_t()) {
+        builder->appendDate("start", start);
+        if (end != Date_t()) {
+            builder->appendDate("end", end);
+            auto elapsed = end - start;
+            long long elapsedMillis = duration_cast<Milliseconds>(elapsed).count();
+            builder->appendNumber("elapsedMillis", elapsedMillis);
+        }
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <fstream>
+#include <string>
+
+#include "mongo/db/repl/base_cloner.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Copies one data file of a backup opened on the sync source with '_replBackupOpen' into a local
+ * directory, reading it in chunks with '_replBackupReadFileChunk'. Each chunk is appended to the
+ * local file before the next is requested, so a transient error only retries the chunk in flight.
+ */
+class BackupFileCloner final : public BaseCloner {
+public:
+    struct Stats {
+        std::string file;
+        uint64_t fileSize{0};
+        uint64_t bytesCopied{0};
+        size_t receivedBatches{0};
+        Date_t start;
+        Date_t end;
+
+        std::string toString() const;
+        BSONObj toBSON() const;
+        void append(BSONObjBuilder* builder) const;
+    };
+
+    // The number of bytes requested from the sync source at a time.
+    static constexpr size_t kChunkSizeBytes = 8 * 1024 * 1024;
+
+    /**
+     * Copies the file 'fileName', which is 'fileSize' bytes long in backup 'backupId', to the
+     * same relative path under 'destinationDir'.
+     */
+    BackupFileCloner(const UUID& backupId,
+                     const std::string& fileName,
+                     uint64_t fileSize,
+                     const std::string& destinationDir,
+                     InitialSyncSharedData* sharedData,
+                     const HostAndPort& source,
+                     DBClientConnection* client,
+                     StorageInterface* storageInterface,
+                     ThreadPool* dbPool);
+
+    virtual ~BackupFileCloner() = default;
+
+    Stats getStats() const;
+
+protected:
+    ClonerStages getStages() final;
+
+    bool isMyFailPoint(const BSONObj& data) const final;
+
+private:
+    std::string describeForFuzzer(BaseClonerStage* stage) const final {
+        return "admin db: { " + stage->getName() + ": " + _backupId.toString() +
+            " file: " + _fileName + " }";
+    }
+
+    /**
+     * The preStage checks that the file name stays under the destination directory, creates the
+     * local file and sets the start time in _stats.
+     */
+    void preStage() final;
+
+    /**
+     * The postStage closes the local file and sets the end time in _stats.
+     */
+    void postStage() final;
+
+    /**
+     * Stage function that reads the file from the sync source and appends it to the local file,
+     * starting from the first byte not yet copied.
+     */
+    AfterStageBehavior copyFileStage();
+
+    // All member variables are labeled with one of the following codes indicating the
+    // synchronization rules for accessing them.
+    //
+    // (R)  Read-only in concurrent operation; no synchronization required.
+    // (M)  Reads and writes guarded by _mutex (defined in base class).
+    // (X)  Access only allowed from the main flow of control called from run() or constructor.
+    const UUID _backupId;                          // (R)
+    const std::string _fileName;                   // (R)
+    const uint64_t _fileSize;                      // (R)
+    const std::string _destinationDir;             // (R)
+    const std::string _localPath;                  // (R)
+    ClonerStage<BackupFileCloner> _copyFileStage;  // (R)
+    std::ofstream _localFile;                      // (X)
+    Stats _stats;                                  // (M)
+};
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+
+#include "mongo/db/repl/backup_file_cloner.h"
+#include "mongo/db/repl/cloner_test_fixture.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace repl {
+
+class BackupFileClonerTest : public ClonerTestFixture {
+protected:
+    void setUp() override {
+        ClonerTestFixture::setUp();
+        setInitialSyncId();
+    }
+
+    std::unique_ptr<BackupFileCloner> makeBackupFileCloner(uint64_t fileSize) {
+        return makeBackupFileCloner(_fileName, fileSize);
+    }
+
+    std::unique_ptr<BackupFileCloner> makeBackupFileCloner(const std::string& fileName,
+                                                           uint64_t fileSize) {
+        return std::make_unique<BackupFileCloner>(_backupId,
+                                                  fileName,
+                                                  fileSize,
+                                                  _destination.path(),
+                                                  _sharedData.get(),
+                                                  _source,
+                                                  _mockClient.get(),
+                                                  &_storageInterface,
+                                                  _dbWorkThreadPool.get());
+    }
+
+    static BSONObj createChunkResponse(StringData data) {
+        BSONObjBuilder bob;
+        bob.appendBinData("data", data.size(), BinDataGeneral, data.rawData());
+        bob.append("ok", 1);
+        return bob.obj();
+    }
+
+    std::string readLocalFile() {
+        std::ifstream file((boost::filesystem::path(_destination.path()) / _fileName).string(),
+                           std::ios::in | std::ios::binary);
+        ASSERT_TRUE(file.is_open());
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    const UUID _backupId = UUID::gen();
+    const std::string _fileName = "journal/WiredTigerLog.0000000001";
+    unittest::TempDir _destination{"backup_file_cloner_test"};
+};
+
+TEST_F(BackupFileClonerTest, CopiesFileChunks) {
+    _mockServer->setCommandReply("_replBackupReadFileChunk",
+                                 {createChunkResponse("hello "), createChunkResponse("world")});
+    auto cloner = makeBackupFileCloner(11);
+
+    ASSERT_OK(cloner->run());
+    ASSERT_EQ("hello world", readLocalFile());
+
+    auto stats = cloner->getStats();
+    ASSERT_EQ(_fileName, stats.file);
+    ASSERT_EQ(11U, stats.fileSize);
+    ASSERT_EQ(11U, stats.bytesCopied);
+    ASSERT_EQ(2U, stats.receivedBatches);
+}
+
+TEST_F(BackupFileClonerTest, CopiesEmptyFileWithoutReading) {
+    _mockServer->setCommandReply("_replBackupReadFileChunk",
+                                 Status(ErrorCodes::UnknownError, "should not be called"));
+    auto cloner = makeBackupFileCloner(0);
+
+    ASSERT_OK(cloner->run());
+    ASSERT_EQ("", readLocalFile());
+    ASSERT_EQ(0U, cloner->getStats().receivedBatches);
+}
+
+TEST_F(BackupFileClonerTest, FileEndingEarlyFailsClone) {
+    _mockServer->setCommandReply("_replBackupReadFileChunk",
+                                 {createChunkResponse("hello "), createChunkResponse("")});
+    auto cloner = makeBackupFileCloner(11);
+
+    ASSERT_EQ(ErrorCodes::InitialSyncFailure, cloner->run());
+    ASSERT_EQ(6U, cloner->getStats().bytesCopied);
+}
+
+TEST_F(BackupFileClonerTest, ClosedBackupFailsClone) {
+    _mockServer->setCommandReply("_replBackupReadFileChunk",
+                                 BSON("ok" << 0 << "code" << ErrorCodes::NoSuchKey << "errmsg"
+                                           << "Backup is not open"));
+    auto cloner = makeBackupFileCloner(11);
+
+    ASSERT_EQ(ErrorCodes::NoSuchKey, cloner->run());
+}
+
+TEST_F(BackupFileClonerTest, FileNameOutsideDestinationFailsClone) {
+    _mockServer->setCommandReply("_replBackupReadFileChunk",
+                                 Status(ErrorCodes::UnknownError, "should not be called"));
+    const auto outside =
+        (boost::filesystem::path(_destination.path()).parent_path() / "outside").string();
+    for (auto&& fileName : {std::string(""),
+                            std::string("../outside"),
+                            std::string("journal/../../outside"),
+                            std::string("/tmp/outside"),
+                            outside}) {
+        auto cloner = makeBackupFileCloner(fileName, 11);
+        ASSERT_EQ(ErrorCodes::InvalidPath, cloner->run()) << fileName;
+    }
+    ASSERT_FALSE(boost::filesystem::exists(outside));
+}
+
+}  // namespace repl
+}  // namespace mongo
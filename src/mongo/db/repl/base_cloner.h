@@ -213,6 +213,29 @@ protected:
      */
     void clearRetryingState();
 
+    /**
+     * Validation function to ensure we connect only to primary or secondary nodes.
+     *
+     * Because the cloner connection is separate from the usual inter-node connection pool and
+     * did not have the 'hangUpOnStepDown:false' flag set in the initial isMaster request, we
+     * will always disconnect if the sync source transitions to a state other than PRIMARY
+     * or SECONDARY.  It will not disconnect on a PRIMARY to SECONDARY or SECONDARY to PRIMARY
+     * transition because we no longer do that (the flag name is anachronistic).  After
+     * disconnecting, this validation function will prevent us from reconnecting until the node
+     * re-enters PRIMARY or SECONDARY state.
+     *
+     * The reason this is necessary is that in 4.2, commands which read metadata (listDatabases,
+     * listCollections, listIndexes) succeed while the sync source is in RECOVERING or ROLLBACK.
+     * In those states, this metadata may be out of date compared to the end of the oplog. So
+     * we could for instance do a listCollections on a database while in RECOVERING, and miss an
+     * entire collection that was recently added.  Then before we read any data (which would cause
+     * a failure) the node could finish recovery, and we could end up missing an entire collection.
+     * If the only data added to that collection was within the recovery period, the initial sync
+     * would succeed and we would have an inconsistent node.  If other data was added we would
+     * invariant during oplog application with a NamespaceNotFound error.
+     */
+    Status ensurePrimaryOrSecondary(const executor::RemoteCommandResponse& isMasterReply);
+
 private:
     virtual ClonerStages getStages() = 0;
 
@@ -32,11 +32,17 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -49,7 +55,9 @@ DatabaseCloner::DatabaseCloner(const std::string& dbName,
                                ThreadPool* dbPool)
     : BaseCloner("DatabaseCloner"_sd, sharedData, source, client, storageInterface, dbPool),
       _dbName(dbName),
-      _listCollectionsStage("listCollections", this, &DatabaseCloner::listCollectionsStage) {
+      _listCollectionsStage("listCollections", this, &DatabaseCloner::listCollectionsStage),
+      _createClientFn(
+          [] { return std::make_unique<DBClientConnection>(true /* autoReconnect */); }) {
     invariant(!dbName.empty());
     _stats.dbname = dbName;
 }
@@ -63,6 +71,10 @@ CollectionOptions DatabaseCloner::parseCollectionOptions(const BSONObj& obj) {
     return uassertStatusOK(CollectionOptions::parse(obj, CollectionOptions::parseForStorage));
 }
 
+void DatabaseCloner::setCreateClientFn_forTest(const CreateClientFn& createClientFn) {
+    _createClientFn = createClientFn;
+}
+
 void DatabaseCloner::preStage() {
     stdx::lock_guard<Latch> lk(_mutex);
     _stats.start = getSharedData()->getClock()->now();
@@ -130,58 +142,174 @@ void DatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
+    const size_t concurrency =
+        std::min(static_cast<size_t>(initialSyncCollectionClonerConcurrency), _collections.size());
+    const bool cloned = concurrency > 1 ? _cloneCollectionsInParallel(concurrency)
+                                        : _cloneCollectionsSerially();
+    // Abort the database cloner if a collection clone failed.
+    if (!cloned)
+        return;
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.end = getSharedData()->getClock()->now();
+}
+
+bool DatabaseCloner::_runCollectionCloner(size_t index, DBClientConnection* client) {
+    auto& sourceNss = _collections[index].first;
+    auto& collectionOptions = _collections[index].second;
+    CollectionCloner* collectionCloner;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto& cloner = _activeCollectionCloners[index];
+        cloner = std::make_unique<CollectionCloner>(sourceNss,
+                                                    collectionOptions,
+                                                    getSharedData(),
+                                                    getSource(),
+                                                    client,
+                                                    getStorageInterface(),
+                                                    getDBPool());
+        collectionCloner = cloner.get();
+    }
+    auto collStatus = collectionCloner->run();
+    if (collStatus.isOK()) {
+        LOGV2_DEBUG(21148,
+                    1,
+                    "collection clone finished: {namespace}",
+                    "Collection clone finished",
+                    "namespace"_attr = sourceNss);
+    } else {
+        LOGV2_ERROR(21149,
+                    "collection clone for '{namespace}' failed due to {error}",
+                    "Collection clone failed",
+                    "namespace"_attr = sourceNss,
+                    "error"_attr = collStatus.toString());
+        setInitialSyncFailedStatus(
+            {ErrorCodes::InitialSyncFailure,
+             collStatus
+                 .withContext(str::stream()
+                              << "Error cloning collection '" << sourceNss.toString() << "'")
+                 .toString()});
+    }
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.collectionStats[index] = collectionCloner->getStats();
+    _activeCollectionCloners.erase(index);
+    if (!collStatus.isOK())
+        return false;
+    _stats.clonedCollections++;
+    return true;
+}
+
+bool DatabaseCloner::_cloneCollectionsSerially() {
+    for (size_t i = 0; i < _collections.size(); ++i) {
+        if (!_runCollectionCloner(i, getClient()))
+            return false;
+    }
+    return true;
+}
+
+bool DatabaseCloner::_cloneCollectionsInParallel(size_t concurrency) {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _workersCanceled = false;
+    }
+
+    auto workersMutex = MONGO_MAKE_LATCH("DatabaseCloner::workersMutex");
+    stdx::condition_variable workersDone;
+    size_t runningWorkers = concurrency;
+    AtomicWord<size_t> nextCollection{0};
+    AtomicWord<bool> failed{false};
+
+    auto runWorker = [&] {
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(workersMutex);
+            if (--runningWorkers == 0)
+                workersDone.notify_all();
+        });
+
+        auto client = _createClientFn();
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _currentCollectionCloner = std::make_unique<CollectionCloner>(sourceNss,
-                                                                          collectionOptions,
-                                                                          getSharedData(),
-                                                                          getSource(),
-                                                                          getClient(),
-                                                                          getStorageInterface(),
-                                                                          getDBPool());
-        }
-        auto collStatus = _currentCollectionCloner->run();
-        if (collStatus.isOK()) {
-            LOGV2_DEBUG(21148,
-                        1,
-                        "collection clone finished: {namespace}",
-                        "Collection clone finished",
-                        "namespace"_attr = sourceNss);
-        } else {
-            LOGV2_ERROR(21149,
-                        "collection clone for '{namespace}' failed due to {error}",
-                        "Collection clone failed",
-                        "namespace"_attr = sourceNss,
-                        "error"_attr = collStatus.toString());
-            setInitialSyncFailedStatus(
-                {ErrorCodes::InitialSyncFailure,
-                 collStatus
-                     .withContext(str::stream()
-                                  << "Error cloning collection '" << sourceNss.toString() << "'")
-                     .toString()});
+            if (_workersCanceled)
+                return;
+            _workerClients.push_back(client.get());
         }
-        {
+        // Unregister the connection before it is destroyed so that _cancelWorkers() never sees a
+        // dangling pointer.
+        ON_BLOCK_EXIT([&] {
             stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _currentCollectionCloner = nullptr;
-            // Abort the database cloner if the collection clone failed.
-            if (!collStatus.isOK())
+            _workerClients.erase(
+                std::find(_workerClients.begin(), _workerClients.end(), client.get()));
+        });
+
+        try {
+            // Like the connection of the AllDatabaseCloner, the worker connections must not
+            // (re)connect to a sync source that is no longer primary or secondary.
+            client->setHandshakeValidationHook(
+                [this](const executor::RemoteCommandResponse& isMasterReply) {
+                    return ensurePrimaryOrSecondary(isMasterReply);
+                });
+            uassertStatusOK(client->connect(getSource(), StringData()));
+            uassertStatusOK(replAuthenticate(client.get())
+                                .withContext(str::stream()
+                                             << "Failed to authenticate to " << getSource()));
+        } catch (const DBException& e) {
+            failed.store(true);
+            setInitialSyncFailedStatus(e.toStatus());
+            return;
+        }
+
+        for (auto index = nextCollection.fetchAndAdd(1); index < _collections.size();
+             index = nextCollection.fetchAndAdd(1)) {
+            if (mustExit() || !_runCollectionCloner(index, client.get())) {
+                failed.store(true);
                 return;
-            _stats.clonedCollections++;
+            }
+        }
+    };
+
+    ThreadPool::Options options;
+    options.poolName = "DatabaseClonerThreadPool";
+    options.threadNamePrefix = "DatabaseCloner-";
+    options.minThreads = 0;
+    options.maxThreads = concurrency;
+    options.onCreateThread = [](const std::string& threadName) { Client::initThread(threadName); };
+    ThreadPool workers(options);
+    workers.startup();
+    for (size_t i = 0; i < concurrency; ++i) {
+        workers.schedule([&](auto status) {
+            invariant(status);
+            runWorker();
+        });
+    }
+
+    {
+        // A worker blocked on the network only notices that initial sync failed or was canceled
+        // once its connection is shut down, so poll for that while waiting.
+        stdx::unique_lock<Latch> lk(workersMutex);
+        while (!workersDone.wait_for(lk, Milliseconds(100).toSystemDuration(), [&] {
+            return runningWorkers == 0;
+        })) {
+            if (mustExit())
+                _cancelWorkers();
         }
     }
+    workers.shutdown();
+    workers.join();
+    return !failed.load() && !mustExit();
+}
+
+void DatabaseCloner::_cancelWorkers() {
     stdx::lock_guard<Latch> lk(_mutex);
-    _stats.end = getSharedData()->getClock()->now();
+    _workersCanceled = true;
+    for (auto client : _workerClients) {
+        client->shutdownAndDisallowReconnect();
+    }
 }
 
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     DatabaseCloner::Stats stats = _stats;
-    if (_currentCollectionCloner) {
-        stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
+    for (auto&& [index, collectionCloner] : _activeCollectionCloners) {
+        stats.collectionStats[index] = collectionCloner->getStats();
     }
     return stats;
 }
@@ -29,10 +29,13 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
 #include "mongo/db/repl/collection_cloner.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 namespace repl {
@@ -52,6 +55,8 @@ public:
         void append(BSONObjBuilder* builder) const;
     };
 
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
     DatabaseCloner(const std::string& dbName,
                    InitialSyncSharedData* sharedData,
                    const HostAndPort& source,
@@ -67,6 +72,11 @@ public:
 
     static CollectionOptions parseCollectionOptions(const BSONObj& element);
 
+    /**
+     * Overrides how the extra connections used to clone collections in parallel are created.
+     */
+    void setCreateClientFn_forTest(const CreateClientFn& createClientFn);
+
 protected:
     ClonerStages getStages() final;
 
@@ -88,9 +98,36 @@ private:
     /**
      * The postStage creates and runs the individual CollectionCloners on each database found on
      * the sync source, and sets the end time in _stats when done.
+     *
+     * Up to 'initialSyncCollectionClonerConcurrency' collections are cloned at once. When more
+     * than one is, each worker thread opens its own connection to the sync source.
      */
     void postStage() final;
 
+    /**
+     * Creates and runs the CollectionCloner for '_collections[index]' over 'client' and records
+     * its stats. Returns false if the clone failed, in which case the initial sync status has
+     * already been set.
+     */
+    bool _runCollectionCloner(size_t index, DBClientConnection* client);
+
+    /**
+     * Clones the collections in order over the connection this cloner was created with.
+     */
+    bool _cloneCollectionsSerially();
+
+    /**
+     * Clones the collections with 'concurrency' worker threads, which take the next uncloned
+     * collection whenever they finish one. Interrupts the workers' connections if initial sync
+     * fails or is canceled in the meantime.
+     */
+    bool _cloneCollectionsInParallel(size_t concurrency);
+
+    /**
+     * Shuts down the connections of the parallel workers and prevents new ones from being used.
+     */
+    void _cancelWorkers();
+
     std::string describeForFuzzer(BaseClonerStage* stage) const final {
         return _dbName + " db: { " + stage->getName() + ": 1 } ";
     }
@@ -107,8 +144,16 @@ private:
     const std::string _dbName;                                                // (R)
     ClonerStage<DatabaseCloner> _listCollectionsStage;                        // (R)
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<CollectionCloner> _currentCollectionCloner;               // (MX)
-    Stats _stats;                                                             // (MX)
+    CreateClientFn _createClientFn;                                           // (X)
+
+    // The running CollectionCloners, keyed by their index in '_collections'.
+    stdx::unordered_map<size_t, std::unique_ptr<CollectionCloner>> _activeCollectionCloners;  // (M)
+
+    // Connections owned by the parallel workers, so that they can be interrupted.
+    std::vector<DBClientConnection*> _workerClients;  // (M)
+    bool _workersCanceled = false;                    // (M)
+
+    Stats _stats;  // (MX)
 };
 
 }  // namespace repl
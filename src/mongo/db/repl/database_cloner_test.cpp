@@ -32,6 +32,7 @@
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/repl/cloner_test_fixture.h"
 #include "mongo/db/repl/database_cloner.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
@@ -39,6 +40,7 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -494,5 +496,91 @@ TEST_F(DatabaseClonerTest, DatabaseAndCollectionStats) {
     ASSERT_EQ(_clock.now(), stats.collectionStats[1].end);
 }
 
+TEST_F(DatabaseClonerTest, CreateCollectionsInParallel) {
+    const auto originalConcurrency = initialSyncCollectionClonerConcurrency;
+    initialSyncCollectionClonerConcurrency = 2;
+    ON_BLOCK_EXIT([&] { initialSyncCollectionClonerConcurrency = originalConcurrency; });
+
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    const std::vector<std::string> names = {"a", "b", "c"};
+    std::vector<BSONObj> sourceInfos;
+    for (auto&& name : names) {
+        sourceInfos.push_back(BSON("name" << name << "type"
+                                          << "collection"
+                                          << "options" << BSONObj() << "info"
+                                          << BSON("readOnly" << false << "uuid" << UUID::gen())));
+    }
+    _mockServer->setCommandReply("listCollections", createListCollectionsResponse(sourceInfos));
+    _mockServer->setCommandReply(
+        "count", {createCountResponse(0), createCountResponse(0), createCountResponse(0)});
+    // The collections are cloned in no particular order, so they all get the same reply.
+    const auto listIndexesResponse = createCursorResponse(_dbName + ".a", BSON_ARRAY(idIndexSpec));
+    _mockServer->setCommandReply("listIndexes",
+                                 {listIndexesResponse, listIndexesResponse, listIndexesResponse});
+
+    // The collections are created from several threads at once.
+    auto collectionsMutex = MONGO_MAKE_LATCH("CreateCollectionsInParallel::collectionsMutex");
+    _storageInterface.createCollectionForBulkFn =
+        [&](const NamespaceString& nss,
+            const CollectionOptions& options,
+            const BSONObj& idIndexSpec,
+            const std::vector<BSONObj>& secondaryIndexSpecs)
+        -> StatusWith<std::unique_ptr<CollectionBulkLoaderMock>> {
+        stdx::lock_guard<Latch> lk(collectionsMutex);
+        const auto collInfo = &_collections[nss];
+        auto localLoader = std::make_unique<CollectionBulkLoaderMock>(collInfo->stats);
+        auto status = localLoader->init(secondaryIndexSpecs);
+        if (!status.isOK())
+            return status;
+        collInfo->loader = localLoader.get();
+        return std::move(localLoader);
+    };
+
+    auto cloner = makeDatabaseCloner();
+    cloner->setCreateClientFn_forTest([this] {
+        return std::unique_ptr<DBClientConnection>(
+            new MockDBClientConnection(_mockServer.get(), true /* autoReconnect */));
+    });
+
+    // Hold every collection cloner before its count stage so we can see two running at once.
+    auto collClonerBeforeFailPoint = globalFailPointRegistry().find("hangBeforeClonerStage");
+    collClonerBeforeFailPoint->setMode(
+        FailPoint::alwaysOn, 0, fromjson("{cloner: 'CollectionCloner', stage: 'count'}"));
+
+    stdx::thread clonerThread([&] {
+        Client::initThread("ClonerRunner");
+        ASSERT_OK(cloner->run());
+    });
+
+    auto countStarted = [&] {
+        auto stats = cloner->getStats();
+        return std::count_if(
+            stats.collectionStats.begin(), stats.collectionStats.end(), [](const auto& coll) {
+                return coll.start != Date_t();
+            });
+    };
+    for (int attempt = 0; countStarted() < 2; ++attempt) {
+        ASSERT_LT(attempt, 3000) << "collections were not cloned concurrently";
+        sleepmillis(10);
+    }
+    ASSERT_EQ(2, countStarted());
+    ASSERT_EQ(0, cloner->getStats().clonedCollections);
+
+    collClonerBeforeFailPoint->setMode(FailPoint::off, 0);
+    clonerThread.join();
+
+    auto stats = cloner->getStats();
+    ASSERT_EQ(3, stats.collections);
+    ASSERT_EQ(3, stats.clonedCollections);
+    ASSERT_EQ(_clock.now(), stats.end);
+    ASSERT_EQUALS(3U, _collections.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        auto collInfo = _collections[NamespaceString{_dbName, names[i]}];
+        ASSERT(collInfo.stats->commitCalled) << names[i];
+        ASSERT_EQ(_dbName + "." + names[i], stats.collectionStats[i].ns);
+    }
+}
+
 }  // namespace repl
 }  // namespace mongo
@@ -150,25 +150,30 @@ std::unique_ptr<HealthLogEntry> dbCheckErrorHealthLogEntry(const NamespaceString
 /**
  * Get a HealthLogEntry for a dbCheck batch.
  */
-std::unique_ptr<HealthLogEntry> dbCheckBatchEntry(const NamespaceString& nss,
-                                                  int64_t count,
-                                                  int64_t bytes,
-                                                  const std::string& expectedHash,
-                                                  const std::string& foundHash,
-                                                  const BSONKey& minKey,
-                                                  const BSONKey& maxKey,
-                                                  const repl::OpTime& optime) {
+std::unique_ptr<HealthLogEntry> dbCheckBatchEntry(
+    const NamespaceString& nss,
+    int64_t count,
+    int64_t bytes,
+    const std::string& expectedHash,
+    const std::string& foundHash,
+    const BSONKey& minKey,
+    const BSONKey& maxKey,
+    const repl::OpTime& optime,
+    const std::vector<BSONObj>& inconsistentSubranges) {
     auto hashes = expectedFound(expectedHash, foundHash);
 
-    auto data = BSON("success" << true << "count" << count << "bytes" << bytes << "md5"
-                               << hashes.second << "minKey" << minKey.elem() << "maxKey"
-                               << maxKey.elem() << "optime" << optime);
+    BSONObjBuilder data;
+    data << "success" << true << "count" << count << "bytes" << bytes << "md5" << hashes.second
+         << "minKey" << minKey.elem() << "maxKey" << maxKey.elem() << "optime" << optime;
+    if (!inconsistentSubranges.empty()) {
+        data.append("inconsistentSubranges", inconsistentSubranges);
+    }
 
     auto severity = hashes.first ? SeverityEnum::Info : SeverityEnum::Error;
     std::string msg =
         "dbCheck batch " + (hashes.first ? std::string("consistent") : std::string("inconsistent"));
 
-    return dbCheckHealthLogEntry(nss, severity, msg, OplogEntriesEnum::Batch, data);
+    return dbCheckHealthLogEntry(nss, severity, msg, OplogEntriesEnum::Batch, data.obj());
 }
 
 DbCheckHasher::DbCheckHasher(OperationContext* opCtx,
@@ -176,11 +181,17 @@ DbCheckHasher::DbCheckHasher(OperationContext* opCtx,
                              const BSONKey& start,
                              const BSONKey& end,
                              int64_t maxCount,
-                             int64_t maxBytes)
-    : _opCtx(opCtx), _maxKey(end), _maxCount(maxCount), _maxBytes(maxBytes) {
+                             int64_t maxBytes,
+                             int64_t subrangeDocs)
+    : _opCtx(opCtx),
+      _maxKey(end),
+      _maxCount(maxCount),
+      _maxBytes(maxBytes),
+      _subrangeDocs(subrangeDocs) {
 
     // Get the MD5 hasher set up.
     md5_init(&_state);
+    md5_init(&_subrangeState);
 
     // Get the _id index.
     const IndexDescriptor* desc = collection->getIndexCatalog()->findIdIndex(opCtx);
@@ -305,6 +316,13 @@ Status DbCheckHasher::hashAll(void) {
         _countSeen += 1;
 
         md5_append(&_state, md5Cast(currentObj.objdata()), currentObj.objsize());
+
+        if (_subrangeDocs > 0) {
+            md5_append(&_subrangeState, md5Cast(currentObj.objdata()), currentObj.objsize());
+            if (++_docsInSubrange == _subrangeDocs) {
+                _closeSubrange();
+            }
+        }
     }
 
     // If we got to the end of the collection, set the last key to MaxKey.
@@ -322,6 +340,28 @@ std::string DbCheckHasher::total(void) {
     return digestToString(digest);
 }
 
+std::vector<DbCheckSubrange> DbCheckHasher::subranges(void) {
+    invariant(_subrangeDocs > 0);
+
+    if (_docsInSubrange > 0 || _subranges.empty()) {
+        _closeSubrange();
+    }
+
+    // No document follows the last subrange up to the last key, so extending it there leaves its
+    // hash unchanged while making sure the subranges cover the whole batch.
+    _subranges.back().setMaxKey(_last);
+    return _subranges;
+}
+
+void DbCheckHasher::_closeSubrange(void) {
+    md5digest digest;
+    md5_finish(&_subrangeState, digest);
+    _subranges.emplace_back(_last, digestToString(digest));
+
+    md5_init(&_subrangeState);
+    _docsInSubrange = 0;
+}
+
 BSONKey DbCheckHasher::lastKey(void) const {
     return _last;
 }
@@ -407,6 +447,36 @@ AutoGetCollectionForDbCheck::AutoGetCollectionForDbCheck(OperationContext* opCtx
 
 namespace {
 
+/**
+ * Rehash each subrange of a batch whose overall hash did not match, and return the bounds and
+ * expected/found hashes of the subranges that differ.
+ */
+StatusWith<std::vector<BSONObj>> findInconsistentSubranges(OperationContext* opCtx,
+                                                           Collection* collection,
+                                                           const DbCheckOplogBatch& entry) {
+    std::vector<BSONObj> inconsistent;
+    BSONKey start = entry.getMinKey();
+
+    for (const auto& subrange : *entry.getSubranges()) {
+        DbCheckHasher hasher(opCtx, collection, start, subrange.getMaxKey());
+        Status status = hasher.hashAll();
+        if (!status.isOK()) {
+            return status;
+        }
+
+        auto hashes = expectedFound(subrange.getMd5().toString(), hasher.total());
+        if (!hashes.first) {
+            inconsistent.push_back(BSON("minKey" << start.elem() << "maxKey"
+                                                 << subrange.getMaxKey().elem() << "md5"
+                                                 << hashes.second));
+        }
+
+        start = subrange.getMaxKey();
+    }
+
+    return inconsistent;
+}
+
 Status dbCheckBatchOnSecondary(OperationContext* opCtx,
                                const repl::OpTime& optime,
                                const DbCheckOplogBatch& entry) {
@@ -446,6 +516,19 @@ Status dbCheckBatchOnSecondary(OperationContext* opCtx,
     std::string expected = entry.getMd5().toString();
     std::string found = hasher->total();
 
+    // Only descend into the subranges of the batch if it is inconsistent as a whole.
+    std::vector<BSONObj> inconsistentSubranges;
+    if (expected != found && entry.getSubranges()) {
+        auto swSubranges = findInconsistentSubranges(opCtx, collection, entry);
+        if (!swSubranges.isOK()) {
+            auto logEntry = dbCheckErrorHealthLogEntry(
+                entry.getNss(), msg, OplogEntriesEnum::Batch, swSubranges.getStatus());
+            HealthLog::get(opCtx).log(*logEntry);
+            return Status::OK();
+        }
+        inconsistentSubranges = std::move(swSubranges.getValue());
+    }
+
     auto logEntry = dbCheckBatchEntry(entry.getNss(),
                                       hasher->docsSeen(),
                                       hasher->bytesSeen(),
@@ -453,7 +536,8 @@ Status dbCheckBatchOnSecondary(OperationContext* opCtx,
                                       found,
                                       entry.getMinKey(),
                                       hasher->lastKey(),
-                                      optime);
+                                      optime,
+                                      inconsistentSubranges);
 
     HealthLog::get(opCtx).log(*logEntry);
 
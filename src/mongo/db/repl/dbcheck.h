@@ -56,16 +56,19 @@ std::unique_ptr<HealthLogEntry> dbCheckErrorHealthLogEntry(const NamespaceString
                                                            const Status& err);
 
 /**
- * Get a HealthLogEntry for a dbCheck batch.
+ * Get a HealthLogEntry for a dbCheck batch, including the bounds and hashes of any subranges of
+ * the batch found to be inconsistent.
  */
-std::unique_ptr<HealthLogEntry> dbCheckBatchEntry(const NamespaceString& nss,
-                                                  int64_t count,
-                                                  int64_t bytes,
-                                                  const std::string& expectedHash,
-                                                  const std::string& foundHash,
-                                                  const BSONKey& minKey,
-                                                  const BSONKey& maxKey,
-                                                  const repl::OpTime& optime);
+std::unique_ptr<HealthLogEntry> dbCheckBatchEntry(
+    const NamespaceString& nss,
+    int64_t count,
+    int64_t bytes,
+    const std::string& expectedHash,
+    const std::string& foundHash,
+    const BSONKey& minKey,
+    const BSONKey& maxKey,
+    const repl::OpTime& optime,
+    const std::vector<BSONObj>& inconsistentSubranges = {});
 
 /**
  * The collection metadata dbCheck sends between nodes.
@@ -116,13 +119,15 @@ public:
      * @param end The last key to hash (inclusive).
      * @param maxCount The maximum number of documents to hash.
      * @param maxBytes The maximum number of bytes to hash.
+     * @param subrangeDocs If positive, also hash every run of this many documents separately.
      */
     DbCheckHasher(OperationContext* opCtx,
                   Collection* collection,
                   const BSONKey& start,
                   const BSONKey& end,
                   int64_t maxCount = std::numeric_limits<int64_t>::max(),
-                  int64_t maxBytes = std::numeric_limits<int64_t>::max());
+                  int64_t maxBytes = std::numeric_limits<int64_t>::max(),
+                  int64_t subrangeDocs = 0);
 
     /**
      * Hash all of our documents.
@@ -134,6 +139,13 @@ public:
      */
     std::string total(void);
 
+    /**
+     * Return the hashes of consecutive subranges of the documents seen so far, each covering up to
+     * `subrangeDocs` documents. The last subrange ends at `lastKey()`, so together they cover the
+     * same range as `total()`. Only valid if `subrangeDocs` was positive.
+     */
+    std::vector<DbCheckSubrange> subranges(void);
+
     /**
      * Get the last key this hasher has hashed.
      *
@@ -151,6 +163,11 @@ private:
      */
     bool _canHash(const BSONObj& obj);
 
+    /**
+     * Finish the hash of the current subrange, ending at `_last`, and start a new one.
+     */
+    void _closeSubrange(void);
+
     OperationContext* _opCtx;
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> _exec;
     md5_state_t _state;
@@ -163,6 +180,11 @@ private:
 
     int64_t _maxBytes = 0;
     int64_t _bytesSeen = 0;
+
+    int64_t _subrangeDocs = 0;
+    int64_t _docsInSubrange = 0;
+    md5_state_t _subrangeState;
+    std::vector<DbCheckSubrange> _subranges;
 };
 
 /**
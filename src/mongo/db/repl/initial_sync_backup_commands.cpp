@@ -0,0 +1,270 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include <boost/filesystem.hpp>
+
+#include "mongo/bson/util/bson_extract.h"
+#include "mongo/client/dbclient_connection.h"
+#include "mongo/db/commands/test_commands_enabled.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/backup_file_cloner.h"
+#include "mongo/db/repl/initial_sync_backup_source.h"
+#include "mongo/db/repl/initial_sync_shared_data.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/repl_set_command.h"
+#include "mongo/db/repl/replication_auth.h"
+#include "mongo/db/repl/replication_consistency_markers_gen.h"
+#include "mongo/db/repl/replication_consistency_markers_impl.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/repl/storage_interface.h"
+#include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+UUID parseBackupId(const BSONObj& cmdObj) {
+    return uassertStatusOK(UUID::parse(cmdObj.firstElement()));
+}
+
+/**
+ * Opens a backup of this node's data files for a node copying them to initialize itself.
+ *
+ * { _replBackupOpen: 1 }
+ */
+class CmdReplBackupOpen : public ReplSetCommand {
+public:
+    CmdReplBackupOpen() : ReplSetCommand("_replBackupOpen") {}
+
+    std::string help() const override {
+        return "Internal command used by file copy based initial sync to open a backup of the "
+               "data files.";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string&,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        uassertStatusOK(ReplicationCoordinator::get(opCtx)->checkReplEnabledForCommand(&result));
+
+        auto backup = InitialSyncBackupSource::get(opCtx->getServiceContext())->open(opCtx);
+        backup.backupId.appendToBuilder(&result, "backupId");
+        if (backup.checkpointTimestamp) {
+            result.append("checkpointTimestamp", *backup.checkpointTimestamp);
+        }
+        BSONArrayBuilder files(result.subarrayStart("files"));
+        for (auto&& file : backup.files) {
+            files.append(BSON("name" << file.name << "size" << static_cast<long long>(file.size)));
+        }
+        return true;
+    }
+} cmdReplBackupOpen;
+
+/**
+ * Returns a chunk of a file of the open backup.
+ *
+ * { _replBackupReadFileChunk: <backupId>, file: <name>, offset: <bytes>, length: <bytes> }
+ */
+class CmdReplBackupReadFileChunk : public ReplSetCommand {
+public:
+    CmdReplBackupReadFileChunk() : ReplSetCommand("_replBackupReadFileChunk") {}
+
+    std::string help() const override {
+        return "Internal command used by file copy based initial sync to read a backup file.";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string&,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const auto backupId = parseBackupId(cmdObj);
+        std::string file;
+        uassertStatusOK(bsonExtractStringField(cmdObj, "file", &file));
+        long long offset;
+        uassertStatusOK(bsonExtractIntegerField(cmdObj, "offset", &offset));
+        long long length;
+        uassertStatusOK(bsonExtractIntegerField(cmdObj, "length", &length));
+        uassert(ErrorCodes::BadValue,
+                str::stream() << "Invalid offset " << offset << " or length " << length,
+                offset >= 0 && length > 0);
+
+        auto chunk = InitialSyncBackupSource::get(opCtx->getServiceContext())
+                         ->readFileChunk(backupId, file, offset, length);
+        result.appendBinData("data", chunk.size(), BinDataGeneral, chunk.data());
+        return true;
+    }
+} cmdReplBackupReadFileChunk;
+
+/**
+ * Closes the open backup.
+ *
+ * { _replBackupClose: <backupId> }
+ */
+class CmdReplBackupClose : public ReplSetCommand {
+public:
+    CmdReplBackupClose() : ReplSetCommand("_replBackupClose") {}
+
+    std::string help() const override {
+        return "Internal command used by file copy based initial sync to close a backup.";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string&,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        InitialSyncBackupSource::get(opCtx->getServiceContext())
+            ->close(opCtx, parseBackupId(cmdObj));
+        return true;
+    }
+} cmdReplBackupClose;
+
+/**
+ * Test-only command that copies a backup of the data files of 'source' into 'destination', an
+ * empty directory that can then be used as the dbpath of a new node.
+ *
+ * { _replCopyBackupFiles: 1, source: <host:port>, destination: <path> }
+ */
+class CmdReplCopyBackupFiles : public ReplSetCommand {
+public:
+    CmdReplCopyBackupFiles() : ReplSetCommand("_replCopyBackupFiles") {}
+
+    std::string help() const override {
+        return "Copies a backup of the data files of another node into a local directory. "
+               "For testing only.";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string&,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        std::string sourceStr;
+        uassertStatusOK(bsonExtractStringField(cmdObj, "source", &sourceStr));
+        const auto source = HostAndPort::parseThrowing(sourceStr);
+        std::string destination;
+        uassertStatusOK(bsonExtractStringField(cmdObj, "destination", &destination));
+        // The dbpath is never empty, so this also refuses to overwrite this node's own files.
+        uassert(ErrorCodes::BadValue,
+                str::stream() << "Destination " << destination << " must be an empty directory",
+                !boost::filesystem::exists(destination) ||
+                    boost::filesystem::is_empty(destination));
+
+        DBClientConnection client(true /* autoReconnect */);
+        uassertStatusOK(client.connect(source, "InitialSyncBackupCopy"));
+        uassertStatusOK(replAuthenticate(&client).withContext(
+            str::stream() << "Failed to authenticate to " << source));
+
+        BSONObj rbidReply;
+        client.simpleCommand("admin", &rbidReply, "replSetGetRBID");
+        uassert(ErrorCodes::InvalidReplicaSetConfig,
+                str::stream() << "Sync source returned invalid result from replSetGetRBID: "
+                              << rbidReply,
+                rbidReply["rbid"].isNumber());
+        InitialSyncSharedData sharedData(
+            rbidReply["rbid"].numberInt(),
+            Seconds(initialSyncTransientErrorRetryPeriodSeconds.load()),
+            opCtx->getServiceContext()->getFastClockSource());
+        auto initialSyncId = client.findOne(
+            ReplicationConsistencyMarkersImpl::kDefaultInitialSyncIdNamespace.toString(), Query());
+        uassert(ErrorCodes::InitialSyncFailure,
+                "Cannot retrieve sync source initial sync ID",
+                !initialSyncId.isEmpty());
+        {
+            stdx::lock_guard<InitialSyncSharedData> lk(sharedData);
+            sharedData.setSyncSourceWireVersion(
+                lk, static_cast<WireVersion>(client.getMaxWireVersion()));
+            sharedData.setInitialSyncSourceId(
+                lk,
+                InitialSyncIdDocument::parse(IDLParserErrorContext("initialSyncId"), initialSyncId)
+                    .get_id());
+        }
+
+        BSONObj openReply;
+        client.runCommand("admin", BSON("_replBackupOpen" << 1), openReply);
+        uassertStatusOK(getStatusFromCommandResult(openReply));
+        const auto backupId = uassertStatusOK(UUID::parse(openReply["backupId"]));
+        ON_BLOCK_EXIT([&] {
+            try {
+                BSONObj closeReply;
+                client.runCommand("admin", BSON("_replBackupClose" << backupId), closeReply);
+            } catch (const DBException& e) {
+                LOGV2_WARNING(4948604,
+                              "Failed to close backup on sync source",
+                              "backupId"_attr = backupId,
+                              "error"_attr = e);
+            }
+        });
+
+        ThreadPool::Options options;
+        options.poolName = "InitialSyncBackupCopy";
+        options.maxThreads = 1;
+        ThreadPool dbPool(options);
+        dbPool.startup();
+        ON_BLOCK_EXIT([&] {
+            dbPool.shutdown();
+            dbPool.join();
+        });
+
+        long long numFiles = 0;
+        long long bytesCopied = 0;
+        for (auto&& file : openReply["files"].Array()) {
+            BackupFileCloner cloner(backupId,
+                                    file["name"].str(),
+                                    file["size"].safeNumberLong(),
+                                    destination,
+                                    &sharedData,
+                                    source,
+                                    &client,
+                                    StorageInterface::get(opCtx),
+                                    &dbPool);
+            uassertStatusOK(cloner.run());
+            ++numFiles;
+            bytesCopied += cloner.getStats().bytesCopied;
+        }
+
+        if (auto checkpointTimestamp = openReply["checkpointTimestamp"]) {
+            result.append(checkpointTimestamp);
+        }
+        result.append("numFiles", numFiles);
+        result.append("bytesCopied", bytesCopied);
+        return true;
+    }
+};
+
+MONGO_REGISTER_TEST_COMMAND(CmdReplCopyBackupFiles);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/initial_sync_backup_source.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/backup_cursor_hooks.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const auto getInitialSyncBackupSource =
+    ServiceContext::declareDecoration<InitialSyncBackupSource>();
+
+}  // namespace
+
+InitialSyncBackupSource* InitialSyncBackupSource::get(ServiceContext* service) {
+    return &getInitialSyncBackupSource(service);
+}
+
+InitialSyncBackupSource::OpenedBackup InitialSyncBackupSource::open(OperationContext* opCtx) {
+    auto service = opCtx->getServiceContext();
+    auto storageEngine = service->getStorageEngine();
+    auto backupCursorHooks = BackupCursorHooks::get(service);
+    uassert(ErrorCodes::ConflictingOperationInProgress,
+            "Cannot open a backup for initial sync while a backup cursor is open",
+            !backupCursorHooks->enabled() || !backupCursorHooks->isBackupCursorOpen());
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    // Let a close in progress finish, so that the backup is either open or fully closed.
+    _stateChanged.wait(lk, [&] { return !_closing; });
+    if (_backupId) {
+        uassert(ErrorCodes::ConflictingOperationInProgress,
+                str::stream() << "A backup for initial sync is already open: " << *_backupId,
+                Date_t::now() - _lastUsed >= kIdleTimeout);
+        LOGV2(4948600,
+              "Closing idle backup for initial sync",
+              "backupId"_attr = *_backupId,
+              "lastUsed"_attr = _lastUsed);
+        _close(lk, opCtx);
+    }
+
+    StorageEngine::BackupInformation backupInformation;
+    OpenedBackup opened{UUID::gen(), boost::none, {}};
+    {
+        // A checkpoint completing between pinning the backup's checkpoint and reading the stable
+        // recovery timestamp would report a timestamp newer than the data in the backup, so hold
+        // off checkpoints until both are done.
+        auto checkpointLock = storageEngine->getCheckpointLock(opCtx);
+        backupInformation = uassertStatusOK(
+            storageEngine->beginNonBlockingBackup(opCtx, StorageEngine::BackupOptions()));
+        opened.checkpointTimestamp = storageEngine->getLastStableRecoveryTimestamp();
+    }
+
+    const boost::filesystem::path dbpath(storageGlobalParams.dbpath);
+    for (auto&& [path, file] : backupInformation) {
+        auto name = boost::filesystem::path(path).lexically_relative(dbpath).generic_string();
+        _fileSizes[name] = file.fileSize;
+        opened.files.push_back({std::move(name), file.fileSize});
+    }
+    _backupId = opened.backupId;
+    _lastUsed = Date_t::now();
+    _startIdleBackupReaper(lk, service);
+
+    LOGV2(4948601,
+          "Opened backup for initial sync",
+          "backupId"_attr = opened.backupId,
+          "checkpointTimestamp"_attr = opened.checkpointTimestamp,
+          "numFiles"_attr = opened.files.size());
+    return opened;
+}
+
+std::string InitialSyncBackupSource::readFileChunk(const UUID& backupId,
+                                                   const std::string& name,
+                                                   uint64_t offset,
+                                                   size_t length) {
+    uint64_t fileSize;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        uassert(ErrorCodes::NoSuchKey,
+                str::stream() << "Backup " << backupId << " is not open",
+                _backupId == backupId && !_closing);
+        auto it = _fileSizes.find(name);
+        uassert(ErrorCodes::NoSuchKey,
+                str::stream() << "File '" << name << "' is not part of backup " << backupId,
+                it != _fileSizes.end());
+        fileSize = it->second;
+        _lastUsed = Date_t::now();
+        ++_numReaders;
+    }
+    // Keep the backup open until the read is done.
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (--_numReaders == 0) {
+            _stateChanged.notify_all();
+        }
+    });
+
+    if (offset >= fileSize) {
+        return {};
+    }
+    length = std::min({static_cast<uint64_t>(length),
+                       static_cast<uint64_t>(kMaxChunkSizeBytes),
+                       fileSize - offset});
+
+    // Files are only read up to the size recorded when the backup was opened. The storage engine
+    // does not change that part of them until the backup is closed, which waits for this read.
+    const auto path = boost::filesystem::path(storageGlobalParams.dbpath) / name;
+    std::ifstream file(path.string(), std::ios::in | std::ios::binary);
+    uassert(ErrorCodes::FileOpenFailed,
+            str::stream() << "Failed to open backup file " << path.string(),
+            file.is_open());
+
+    std::string chunk(length, '\0');
+    file.seekg(offset);
+    file.read(&chunk[0], length);
+    uassert(ErrorCodes::FileStreamFailed,
+            str::stream() << "Failed to read " << length << " bytes at offset " << offset
+                          << " of backup file " << path.string(),
+            file && static_cast<size_t>(file.gcount()) == length);
+    return chunk;
+}
+
+void InitialSyncBackupSource::close(OperationContext* opCtx, const UUID& backupId) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    if (_backupId != backupId || _closing) {
+        return;
+    }
+    LOGV2(4948602, "Closing backup for initial sync", "backupId"_attr = backupId);
+    _close(lk, opCtx);
+}
+
+void InitialSyncBackupSource::closeIfIdle(OperationContext* opCtx) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    if (!_backupId || _closing || Date_t::now() - _lastUsed < kIdleTimeout) {
+        return;
+    }
+    LOGV2(4948612,
+          "Closing idle backup for initial sync",
+          "backupId"_attr = *_backupId,
+          "lastUsed"_attr = _lastUsed);
+    _close(lk, opCtx);
+}
+
+void InitialSyncBackupSource::_startIdleBackupReaper(WithLock, ServiceContext* service) {
+    if (_idleBackupReaper) {
+        return;
+    }
+
+    auto periodicRunner = service->getPeriodicRunner();
+    invariant(periodicRunner);
+
+    PeriodicRunner::PeriodicJob job(
+        "closeIdleInitialSyncBackup",
+        [](Client* client) {
+            auto opCtx = client->makeOperationContext();
+            try {
+                InitialSyncBackupSource::get(client->getServiceContext())->closeIfIdle(opCtx.get());
+            } catch (ExceptionForCat<ErrorCategory::CancelationError>& ex) {
+                LOGV2_DEBUG(4948613, 2, "Periodic job canceled", "reason"_attr = ex.reason());
+            }
+        },
+        kIdleCheckInterval);
+
+    _idleBackupReaper =
+        std::make_shared<PeriodicJobAnchor>(periodicRunner->makeJob(std::move(job)));
+    _idleBackupReaper->start();
+}
+
+void InitialSyncBackupSource::_close(stdx::unique_lock<Latch>& lk, OperationContext* opCtx) {
+    invariant(_backupId && !_closing);
+    _closing = true;
+    ON_BLOCK_EXIT([&] {
+        _closing = false;
+        _stateChanged.notify_all();
+    });
+
+    // Reads are short, so wait for them without checking for interrupts.
+    _stateChanged.wait(lk, [&] { return _numReaders == 0; });
+    opCtx->getServiceContext()->getStorageEngine()->endNonBlockingBackup(opCtx);
+    _backupId = boost::none;
+    _fileSizes.clear();
+}
+
+}  // namespace repl
+}  // namespace mongo
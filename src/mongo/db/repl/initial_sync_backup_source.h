@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/timestamp.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/periodic_runner.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+namespace repl {
+
+/**
+ * Serves the data files of a non-blocking storage engine backup to a node that copies them to
+ * initialize itself. While the backup is open the storage engine keeps the files of its checkpoint
+ * intact, so reading each file up to the size recorded when the backup was opened yields a
+ * consistent copy of the data as of that checkpoint, which can be recovered like any other
+ * backup.
+ *
+ * At most one backup is open at a time. A backup that has not been read from for kIdleTimeout is
+ * assumed to be abandoned, for instance because the node copying it died, and is closed by a
+ * periodic job, or when another one is requested. Closing a backup waits for the reads in progress
+ * to finish.
+ */
+class InitialSyncBackupSource {
+public:
+    static constexpr Minutes kIdleTimeout{10};
+
+    // How often the periodic job looks for an idle backup to close.
+    static constexpr Minutes kIdleCheckInterval{1};
+
+    // The largest chunk returned by a single read, which keeps replies well under the BSON limit.
+    static constexpr size_t kMaxChunkSizeBytes = 8 * 1024 * 1024;
+
+    struct BackupFile {
+        // The path of the file relative to the dbpath.
+        std::string name;
+        uint64_t size;
+    };
+
+    struct OpenedBackup {
+        UUID backupId;
+        // The stable timestamp of the checkpoint the backup contains, if there is one.
+        boost::optional<Timestamp> checkpointTimestamp;
+        std::vector<BackupFile> files;
+    };
+
+    static InitialSyncBackupSource* get(ServiceContext* service);
+
+    /**
+     * Opens a backup of the storage engine's data files. Throws if the storage engine does not
+     * support non-blocking backups or if another backup is already open.
+     */
+    OpenedBackup open(OperationContext* opCtx);
+
+    /**
+     * Returns up to 'length' bytes, at most kMaxChunkSizeBytes, of the backup file 'name' starting
+     * at 'offset'. Fewer bytes are returned only at the end of the file, as recorded when the
+     * backup was opened. Throws if 'backupId' is not the open backup or 'name' is not one of its
+     * files.
+     */
+    std::string readFileChunk(const UUID& backupId,
+                              const std::string& name,
+                              uint64_t offset,
+                              size_t length);
+
+    /**
+     * Closes the backup if it is still open and not already being closed.
+     */
+    void close(OperationContext* opCtx, const UUID& backupId);
+
+    /**
+     * Closes the backup if it has not been read from for kIdleTimeout. Called periodically once a
+     * backup has been opened.
+     */
+    void closeIfIdle(OperationContext* opCtx);
+
+private:
+    /**
+     * Refuses new reads of the open backup, waits for the reads in progress to finish and ends the
+     * backup. Releases 'lk' while waiting.
+     */
+    void _close(stdx::unique_lock<Latch>& lk, OperationContext* opCtx);
+
+    /**
+     * Starts the periodic job which closes idle backups, unless it is already running.
+     */
+    void _startIdleBackupReaper(WithLock, ServiceContext* service);
+
+    Mutex _mutex = MONGO_MAKE_LATCH("InitialSyncBackupSource::_mutex");
+    boost::optional<UUID> _backupId;
+    StringMap<uint64_t> _fileSizes;
+    Date_t _lastUsed;
+
+    // The number of readFileChunk() calls reading the files of the open backup, and whether the
+    // backup is being closed. Signaled when the last read finishes and when a close completes.
+    size_t _numReaders = 0;
+    bool _closing = false;
+    stdx::condition_variable _stateChanged;
+
+    std::shared_ptr<PeriodicJobAnchor> _idleBackupReaper;
+};
+
+}  // namespace repl
+}  // namespace mongo
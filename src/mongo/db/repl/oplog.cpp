@@ -1568,12 +1568,15 @@ Status applyCommand_inlock(OperationContext* opCtx,
             case ErrorCodes::BackgroundOperationInProgressForNamespace: {
                 Lock::TempRelease release(opCtx->lockState());
 
+                // 'emptycapped' is only registered as a test command, but the range deleter also
+                // replicates truncations with it, so its namespace is read from the entry instead.
                 Command* cmd = CommandHelpers::findCommand(o.firstElement().fieldName());
-                invariant(cmd);
+                invariant(cmd || entry.getCommandType() == OplogEntry::CommandType::kEmptyCapped);
 
                 // TODO: This parse could be expensive and not worth it.
-                auto ns =
-                    cmd->parse(opCtx, OpMsgRequest::fromDBAndBody(nss.db(), o))->ns().toString();
+                auto ns = cmd
+                    ? cmd->parse(opCtx, OpMsgRequest::fromDBAndBody(nss.db(), o))->ns().toString()
+                    : extractNs(nss, o).ns();
                 auto swUUID = entry.getUuid();
                 if (!swUUID) {
                     LOGV2_ERROR(21261,
@@ -32,6 +32,8 @@
 
 #include "mongo/db/repl/oplog_applier_impl.h"
 
+#include <numeric>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database.h"
@@ -75,6 +77,11 @@ ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
 
+// Number of batches whose oplog writes overlapped with the application of the previous batch.
+Counter64 pipelinedBatchesStats;
+ServerStatusMetricField<Counter64> displayPipelinedBatches("repl.apply.pipelinedBatches",
+                                                           &pipelinedBatchesStats);
+
 NamespaceString parseUUIDOrNs(OperationContext* opCtx, const OplogEntry& oplogEntry) {
     auto optionalUuid = oplogEntry.getUuid();
     if (!optionalUuid) {
@@ -424,6 +431,14 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
             ? new ApplyBatchFinalizerForJournal(_replCoord)
             : new ApplyBatchFinalizer(_replCoord)};
 
+    // When oplog writes are pipelined, holds the batch that was written to the oplog while the
+    // previous batch was being applied. It is applied before asking the batcher for more.
+    std::function<OplogBatch()> getNextBatchIfReady;
+    if (oplogApplicationPipelinesOplogWrites) {
+        getNextBatchIfReady = [this] { return _oplogBatcher->getNextBatchIfReady(); };
+    }
+    OplogBatch prefetchedOps(0);
+
     while (true) {  // Exits on message from OplogBatcher.
         // Use a new operation context each iteration, as otherwise we may appear to use a single
         // collection name to refer to collections with different UUIDs.
@@ -447,8 +462,11 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
         _replCoord->finishRecoveryIfEligible(&opCtx);
 
         // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't become
-        // ready in time, we'll loop again so we can do the above checks periodically.
-        OplogBatch ops = _oplogBatcher->getNextBatch(Seconds(1));
+        // ready in time, we'll loop again so we can do the above checks periodically. A batch that
+        // was already written to the oplog must be applied before any other.
+        const bool opsWrittenToOplog = !prefetchedOps.empty();
+        OplogBatch ops = opsWrittenToOplog ? std::exchange(prefetchedOps, OplogBatch(0))
+                                           : _oplogBatcher->getNextBatch(Seconds(1));
         if (ops.empty()) {
             if (ops.mustShutdown()) {
                 // Shut down and exit oplog application loop.
@@ -488,9 +506,12 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
         // Don't allow the fsync+lock thread to see intermediate states of batch application.
         stdx::lock_guard<SimpleMutex> fsynclk(filesLockedFsync);
 
-        // Apply the operations in this batch. '_applyOplogBatch' returns the optime of the
-        // last op that was applied, which should be the last optime in the batch.
-        auto swLastOpTimeAppliedInBatch = _applyOplogBatch(&opCtx, ops.releaseBatch());
+        // Apply the operations in this batch. '_applyOplogBatchPipelined' returns the optime of
+        // the last op that was applied, which should be the last optime in the batch. If oplog
+        // writes are pipelined, it also writes the next ready batch to the oplog and stores it in
+        // 'prefetchedOps'.
+        auto swLastOpTimeAppliedInBatch = _applyOplogBatchPipelined(
+            &opCtx, ops.releaseBatch(), opsWrittenToOplog, getNextBatchIfReady, &prefetchedOps);
         if (swLastOpTimeAppliedInBatch.getStatus().code() == ErrorCodes::InterruptedAtShutdown) {
             // If an operation was interrupted at shutdown, fail the batch without advancing
             // appliedThrough as if this were an unclean shutdown. This ensures the stable timestamp
@@ -604,7 +625,17 @@ void scheduleWritesToOplog(OperationContext* opCtx,
 
 StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                                                       std::vector<OplogEntry> ops) {
+    return _applyOplogBatchPipelined(opCtx, std::move(ops), false, nullptr, nullptr);
+}
+
+StatusWith<OpTime> OplogApplierImpl::_applyOplogBatchPipelined(
+    OperationContext* opCtx,
+    std::vector<OplogEntry> ops,
+    bool opsWrittenToOplog,
+    const std::function<OplogBatch()>& getNextBatch,
+    OplogBatch* nextBatch) {
     invariant(!ops.empty());
+    invariant(!getNextBatch || nextBatch);
 
     LOGV2_DEBUG(21230,
                 2,
@@ -626,7 +657,15 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
     // Increment the batch size stat.
     oplogApplicationBatchSize.increment(ops.size());
 
-    std::vector<WorkerMultikeyPathInfo> multikeyVector(_writerPool->getStats().numThreads);
+    const bool writeOpsToOplog = !getOptions().skipWritesToOplog && !opsWrittenToOplog;
+    bool wroteNextBatchToOplog = false;
+
+    // Split the batch into more writer vectors than there are threads so that a thread which
+    // finishes its share early can pick up the remaining vectors when the hash is skewed.
+    const size_t numWriterVectors =
+        _writerPool->getStats().numThreads * static_cast<size_t>(replWriterVectorsPerThread);
+
+    std::vector<WorkerMultikeyPathInfo> multikeyVector(numWriterVectors);
     {
         // Each node records cumulative batch application stats for itself using this timer.
         TimerHolder timer(&applyBatchStats);
@@ -636,7 +675,7 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         ON_BLOCK_EXIT([&] { _writerPool->waitForIdle(); });
 
         // Write batch of ops into oplog.
-        if (!getOptions().skipWritesToOplog) {
+        if (writeOpsToOplog) {
             _consistencyMarkers->setOplogTruncateAfterPoint(
                 opCtx, _replCoord->getMyLastAppliedOpTime().getTimestamp());
             scheduleWritesToOplog(opCtx, _storageInterface, _writerPool, ops);
@@ -651,8 +690,7 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         //   and create a pseudo oplog.
         std::vector<std::vector<OplogEntry>> derivedOps;
 
-        std::vector<std::vector<const OplogEntry*>> writerVectors(
-            _writerPool->getStats().numThreads);
+        std::vector<std::vector<const OplogEntry*>> writerVectors(numWriterVectors);
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
 
         // Wait for writes to finish before applying ops.
@@ -668,18 +706,28 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         }
 
         // Reset consistency markers in case the node fails while applying ops.
-        if (!getOptions().skipWritesToOplog) {
+        if (writeOpsToOplog) {
             _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, Timestamp());
+        }
+        if (!getOptions().skipWritesToOplog) {
             _consistencyMarkers->setMinValidToAtLeast(opCtx, ops.back().getOpTime());
         }
 
         {
-            std::vector<Status> statusVector(_writerPool->getStats().numThreads, Status::OK());
+            std::vector<Status> statusVector(numWriterVectors, Status::OK());
+
+            // Schedule the largest writer vectors first so that the smaller ones fill in the gaps
+            // as threads become idle, instead of leaving one long vector to run at the end.
+            std::vector<size_t> scheduleOrder(writerVectors.size());
+            std::iota(scheduleOrder.begin(), scheduleOrder.end(), 0);
+            std::stable_sort(scheduleOrder.begin(), scheduleOrder.end(), [&](size_t l, size_t r) {
+                return writerVectors[l].size() > writerVectors[r].size();
+            });
 
             // Doles out all the work to the writer pool threads. writerVectors is not modified,
             // but  applyOplogBatchPerWorker will modify the vectors that it contains.
             invariant(writerVectors.size() == statusVector.size());
-            for (size_t i = 0; i < writerVectors.size(); i++) {
+            for (size_t i : scheduleOrder) {
                 if (writerVectors[i].empty())
                     continue;
 
@@ -702,6 +750,22 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                     });
             }
 
+            // Write the next batch into the oplog while this one is being applied. Everything
+            // after the last entry of this batch is truncated on startup if we crash before those
+            // writes are all done. 'minValid' is not advanced for the next batch until it is
+            // applied, so recovery still replays it after this batch.
+            if (getNextBatch && !getOptions().skipWritesToOplog) {
+                *nextBatch = getNextBatch();
+                if (!nextBatch->empty()) {
+                    _consistencyMarkers->setOplogTruncateAfterPoint(opCtx,
+                                                                    ops.back().getTimestamp());
+                    scheduleWritesToOplog(
+                        opCtx, _storageInterface, _writerPool, nextBatch->getBatch());
+                    wroteNextBatchToOplog = true;
+                    pipelinedBatchesStats.increment();
+                }
+            }
+
             _writerPool->waitForIdle();
 
             // If any of the statuses is not ok, return error.
@@ -724,6 +788,10 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                     return status;
                 }
             }
+
+            if (wroteNextBatchToOplog) {
+                _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, Timestamp());
+            }
         }
     }
 
@@ -126,6 +126,26 @@ private:
 
 protected:
     // Marked as protected for use in unit tests.
+    /**
+     * Implements _applyOplogBatch() with two additions used to overlap oplog writes with oplog
+     * application:
+     *
+     * If 'opsWrittenToOplog' is true, 'ops' were already written to the oplog while the previous
+     * batch was being applied, so only the apply phase runs.
+     *
+     * If 'getNextBatch' is set, it is called once the apply phase of 'ops' has been scheduled. A
+     * non-empty result is stored in 'nextBatch' and written to the oplog by the writer threads
+     * concurrently with the application of 'ops', under the same PBWM lock. The oplog truncate
+     * after point covers those writes until they are all done, so a crash in the middle can never
+     * leave a hole in the oplog. The caller must apply 'nextBatch' next with 'opsWrittenToOplog'
+     * set to true.
+     */
+    StatusWith<OpTime> _applyOplogBatchPipelined(OperationContext* opCtx,
+                                                 std::vector<OplogEntry> ops,
+                                                 bool opsWrittenToOplog,
+                                                 const std::function<OplogBatch()>& getNextBatch,
+                                                 OplogBatch* nextBatch);
+
     /**
      * This function is used by the thread pool workers to write ops to the db.
      * It modifies the passed-in vector, and callers should not make any assumptions about the
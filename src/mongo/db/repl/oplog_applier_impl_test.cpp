@@ -468,6 +468,7 @@ TEST_F(OplogApplierImplTest, applyOplogEntryOrGroupedInsertsCommand) {
  */
 class TrackOpsAppliedApplier : public OplogApplierImpl {
 public:
+    using OplogApplierImpl::_applyOplogBatchPipelined;
     using OplogApplierImpl::OplogApplierImpl;
 
     Status applyOplogBatchPerWorker(OperationContext* opCtx,
@@ -486,6 +487,28 @@ Status TrackOpsAppliedApplier::applyOplogBatchPerWorker(
     return Status::OK();
 }
 
+class RecordWriterVectorsApplier : public OplogApplierImpl {
+public:
+    using OplogApplierImpl::OplogApplierImpl;
+
+    Status applyOplogBatchPerWorker(OperationContext* opCtx,
+                                    std::vector<const OplogEntry*>* ops,
+                                    WorkerMultikeyPathInfo* workerMultikeyPathInfo) override {
+        std::vector<OplogEntry> writerVector;
+        for (auto&& opPtr : *ops) {
+            writerVector.push_back(*opPtr);
+        }
+        stdx::lock_guard<Latch> lock(_mutex);
+        writerVectorsApplied.push_back(std::move(writerVector));
+        return Status::OK();
+    }
+
+    std::vector<std::vector<OplogEntry>> writerVectorsApplied;
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("RecordWriterVectorsApplier::_mutex");
+};
+
 DEATH_TEST_F(OplogApplierImplTest, MultiApplyAbortsWhenNoOperationsAreGiven, "!ops.empty()") {
     auto writerPool = makeReplWriterPool();
     NoopOplogApplierObserver observer;
@@ -556,6 +579,140 @@ TEST_F(OplogApplierImplTest,
                                                      createOplogCollectionOptions()));
 }
 
+TEST_F(OplogApplierImplTest, MultiApplySplitsBatchIntoMoreWriterVectorsThanThreads) {
+    const int numThreads = 2;
+    const int numNamespaces = 50;
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < numNamespaces; ++i) {
+        NamespaceString nss("test.coll" + std::to_string(i));
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), 2 * i + 1), 1LL}, nss, BSON("_id" << 1)));
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), 2 * i + 2), 1LL}, nss, BSON("_id" << 2)));
+    }
+
+    auto writerPool = makeReplWriterPool(numThreads);
+    NoopOplogApplierObserver observer;
+    RecordWriterVectorsApplier oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+    auto lastOpTime = unittest::assertGet(oplogApplier.applyOplogBatch(_opCtx.get(), ops));
+    ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+
+    // The work is split across more vectors than there are threads, but the ops of a namespace
+    // still all land in one vector, in oplog order.
+    ASSERT_GT(oplogApplier.writerVectorsApplied.size(), static_cast<size_t>(numThreads));
+    ASSERT_LTE(oplogApplier.writerVectorsApplied.size(),
+               static_cast<size_t>(numThreads * replWriterVectorsPerThread));
+    StringMap<std::pair<size_t, OpTime>> lastOpForNamespace;
+    size_t numOpsApplied = 0;
+    for (size_t i = 0; i < oplogApplier.writerVectorsApplied.size(); ++i) {
+        const auto& writerVector = oplogApplier.writerVectorsApplied[i];
+        numOpsApplied += writerVector.size();
+        for (auto&& op : writerVector) {
+            const auto ns = op.getNss().ns();
+            auto [it, inserted] = lastOpForNamespace.emplace(ns, std::make_pair(i, op.getOpTime()));
+            if (!inserted) {
+                ASSERT_EQUALS(it->second.first, i) << ns;
+                ASSERT_LT(it->second.second, op.getOpTime()) << ns;
+                it->second.second = op.getOpTime();
+            }
+        }
+    }
+    ASSERT_EQUALS(ops.size(), numOpsApplied);
+}
+
+TEST_F(OplogApplierImplTest, PipelinedBatchWritesNextBatchToOplogWhileApplyingCurrentBatch) {
+    NamespaceString nss("test." + _agent.getTestName());
+    createCollection(_opCtx.get(), nss, CollectionOptions());
+
+    Mutex mutex = MONGO_MAKE_LATCH("PipelinedBatchWritesNextBatchToOplog::mutex");
+    std::vector<BSONObj> oplogDocs;
+    _opObserver->onInsertsFn =
+        [&](OperationContext*, const NamespaceString& insertNss, const std::vector<BSONObj>& docs) {
+            if (insertNss.isOplog()) {
+                stdx::lock_guard<Latch> lock(mutex);
+                oplogDocs.insert(oplogDocs.end(), docs.begin(), docs.end());
+            }
+        };
+
+    auto op1 = makeInsertDocumentOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss, BSON("_id" << 1));
+    auto op2 = makeInsertDocumentOplogEntry({Timestamp(Seconds(2), 0), 1LL}, nss, BSON("_id" << 2));
+    auto op3 = makeInsertDocumentOplogEntry({Timestamp(Seconds(3), 0), 1LL}, nss, BSON("_id" << 3));
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    TrackOpsAppliedApplier oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+
+    // The first batch writes both itself and the next batch to the oplog but only applies itself.
+    OplogBatch nextBatch(0);
+    auto lastOpTime = unittest::assertGet(oplogApplier._applyOplogBatchPipelined(
+        _opCtx.get(),
+        {op1},
+        false,
+        [&] {
+            OplogBatch batch(2);
+            batch.emplace_back(op2);
+            batch.emplace_back(op3);
+            return batch;
+        },
+        &nextBatch));
+    ASSERT_EQUALS(op1.getOpTime(), lastOpTime);
+    ASSERT_EQUALS(2U, nextBatch.getBatch().size());
+    ASSERT_EQUALS(1U, oplogApplier.operationsApplied.size());
+    ASSERT_EQUALS(3U, oplogDocs.size());
+    ASSERT_EQUALS(Timestamp(), getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get()));
+    ASSERT_EQUALS(op1.getOpTime(), getConsistencyMarkers()->getMinValid(_opCtx.get()));
+
+    // The next batch is only applied, and the oplog is not written again.
+    lastOpTime = unittest::assertGet(oplogApplier._applyOplogBatchPipelined(
+        _opCtx.get(), nextBatch.releaseBatch(), true, nullptr, nullptr));
+    ASSERT_EQUALS(op3.getOpTime(), lastOpTime);
+    ASSERT_EQUALS(3U, oplogApplier.operationsApplied.size());
+    ASSERT_EQUALS(3U, oplogDocs.size());
+    ASSERT_EQUALS(op3.getOpTime(), getConsistencyMarkers()->getMinValid(_opCtx.get()));
+}
+
+TEST_F(OplogApplierImplTest, PipelinedBatchWithNoNextBatchReadyBehavesLikeRegularBatch) {
+    NamespaceString nss("test." + _agent.getTestName());
+    createCollection(_opCtx.get(), nss, CollectionOptions());
+    auto op = makeInsertDocumentOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss, BSON("_id" << 1));
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    TrackOpsAppliedApplier oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+
+    OplogBatch nextBatch(0);
+    auto lastOpTime = unittest::assertGet(oplogApplier._applyOplogBatchPipelined(
+        _opCtx.get(), {op}, false, [] { return OplogBatch(0); }, &nextBatch));
+    ASSERT_EQUALS(op.getOpTime(), lastOpTime);
+    ASSERT_TRUE(nextBatch.empty());
+    ASSERT_EQUALS(1U, oplogApplier.operationsApplied.size());
+    ASSERT_EQUALS(Timestamp(), getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get()));
+}
+
 TEST_F(OplogApplierImplTest,
        OplogApplicationThreadFuncUsesApplyOplogEntryOrGroupedInsertsToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
@@ -70,6 +70,18 @@ OplogBatch OplogBatcher::getNextBatch(Seconds maxWaitTime) {
     return ops;
 }
 
+OplogBatch OplogBatcher::getNextBatchIfReady() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_ops.empty()) {
+        return OplogBatch(0);
+    }
+
+    OplogBatch ops = std::move(_ops);
+    _ops = OplogBatch(0);
+    _cv.notify_all();
+    return ops;
+}
+
 void OplogBatcher::startup(StorageInterface* storageInterface) {
     _thread = std::make_unique<stdx::thread>([this, storageInterface] { _run(storageInterface); });
 }
@@ -151,6 +151,13 @@ public:
      */
     OplogBatch getNextBatch(Seconds maxWaitTime);
 
+    /**
+     * Like getNextBatch() but never blocks. Returns the batch only if it contains oplog entries;
+     * otherwise returns an empty batch and leaves any shutdown or drain signal in place for the
+     * next call to getNextBatch().
+     */
+    OplogBatch getNextBatchIfReady();
+
     /**
      * Starts up a thread to continuously pull from the OplogBuffer into the OplogBatcher's oplog
      * batch.
@@ -31,6 +31,9 @@
 
 #include "mongo/db/repl/oplog_fetcher.h"
 
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+
 #include "mongo/base/counter.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/jsobj.h"
@@ -115,6 +118,18 @@ Milliseconds calculateAwaitDataTimeout(const ReplSetConfig& config) {
     return std::min((config.getElectionTimeoutPeriod() / 2), maximumAwaitDataTimeoutMS);
 }
 
+/**
+ * Returns the network message compressors listed in 'oplogFetcherNetworkCompressors'. Oplog
+ * entries are repetitive enough that a stronger compressor than the one preferred for other
+ * connections can be worth its cost when the sync source is far away.
+ */
+std::vector<std::string> getPreferredNetworkCompressors() {
+    std::vector<std::string> names;
+    boost::algorithm::split(names, oplogFetcherNetworkCompressors, boost::is_any_of(", "));
+    names.erase(std::remove(names.begin(), names.end(), std::string()), names.end());
+    return names;
+}
+
 /**
  * Checks the first batch of results from query.
  * 'documents' are the first batch of results returned from tailing the remote oplog.
@@ -291,8 +306,12 @@ OplogFetcher::OplogFetcher(executor::TaskExecutor* executor,
       _oplogFetcherRestartDecision(std::move(oplogFetcherRestartDecision)),
       _onShutdownCallbackFn(onShutdownCallbackFn),
       _lastFetched(lastFetched),
-      _createClientFn(
-          [] { return std::make_unique<DBClientConnection>(true /* autoReconnect */); }),
+      _createClientFn([] {
+          auto conn = std::make_unique<DBClientConnection>(true /* autoReconnect */);
+          conn->getCompressorManager().setClientCompressorPreference(
+              getPreferredNetworkCompressors());
+          return conn;
+      }),
       _requireFresherSyncSource(requireFresherSyncSource),
       _dataReplicatorExternalState(dataReplicatorExternalState),
       _enqueueDocumentsFn(enqueueDocumentsFn),
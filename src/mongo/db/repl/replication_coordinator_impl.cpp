@@ -146,6 +146,19 @@ Counter64 userOpsRunning;
 ServerStatusMetricField<Counter64> displayUserOpsRunning(
     "repl.stateTransition.userOperationsRunning", &userOpsRunning);
 
+// Tracks the number of clients waiting for their writes to replicate, and how long they waited.
+Counter64 numReplicationWaiters;
+ServerStatusMetricField<Counter64> displayNumReplicationWaiters("repl.waiters.replication",
+                                                                &numReplicationWaiters);
+TimerStats replicationWaitTimes;
+ServerStatusMetricField<TimerStats> displayReplicationWaitTimes("repl.waiters.replicationWaits",
+                                                                &replicationWaitTimes);
+
+// Tracks the number of clients waiting for this node to apply an optime.
+Counter64 numOpTimeWaiters;
+ServerStatusMetricField<Counter64> displayNumOpTimeWaiters("repl.waiters.opTime",
+                                                           &numOpTimeWaiters);
+
 using CallbackArgs = executor::TaskExecutor::CallbackArgs;
 using CallbackFn = executor::TaskExecutor::CallbackFn;
 using CallbackHandle = executor::TaskExecutor::CallbackHandle;
@@ -206,22 +219,63 @@ StatusOrStatusWith<T> futureGetNoThrowWithDeadline(OperationContext* opCtx,
 
 }  // namespace
 
+ReplicationCoordinatorImpl::WaiterList::WaiterList(Counter64* numWaiters, TimerStats* waitTimes)
+    : _numWaiters(numWaiters), _waitTimes(waitTimes) {}
+
+ReplicationCoordinatorImpl::WaiterList::~WaiterList() {
+    _numWaiters->decrement(_size);
+}
+
+ReplicationCoordinatorImpl::WaiterList::GroupKey
+ReplicationCoordinatorImpl::WaiterList::_makeGroupKey(const Waiter& waiter) {
+    if (!waiter.writeConcern) {
+        return {};
+    }
+    const auto& wc = *waiter.writeConcern;
+    return {wc.wNumNodes, wc.wMode, wc.syncMode, wc.checkCondition};
+}
+
+void ReplicationCoordinatorImpl::WaiterList::_signal_inlock(const SharedWaiterHandle& waiter,
+                                                            Status status) {
+    if (_waitTimes) {
+        _waitTimes->record(waiter->timer);
+    }
+    if (status.isOK()) {
+        waiter->promise.emplaceValue();
+    } else {
+        waiter->promise.setError(std::move(status));
+    }
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(const OpTime& opTime,
                                                         SharedWaiterHandle waiter) {
-    _waiters.emplace(opTime, std::move(waiter));
+    auto key = _makeGroupKey(*waiter);
+    _groups[std::move(key)].emplace(opTime, std::move(waiter));
+    ++_size;
+    _numWaiters->increment();
 }
 
 SharedSemiFuture<void> ReplicationCoordinatorImpl::WaiterList::add_inlock(
     const OpTime& opTime, boost::optional<WriteConcernOptions> wc) {
     auto pf = makePromiseFuture<void>();
-    _waiters.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
+    add_inlock(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
     return std::move(pf.future);
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle waiter) {
-    for (auto iter = _waiters.begin(); iter != _waiters.end(); iter++) {
+    auto groupIt = _groups.find(_makeGroupKey(*waiter));
+    if (groupIt == _groups.end()) {
+        return false;
+    }
+    auto& group = groupIt->second;
+    for (auto iter = group.begin(); iter != group.end(); iter++) {
         if (iter->second == waiter) {
-            _waiters.erase(iter);
+            group.erase(iter);
+            if (group.empty()) {
+                _groups.erase(groupIt);
+            }
+            --_size;
+            _numWaiters->decrement();
             return true;
         }
     }
@@ -231,35 +285,76 @@ bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle wa
 template <typename Func>
 void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
                                                                boost::optional<OpTime> opTime) {
-    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
-        const auto& waiter = it->second;
-        try {
-            if (func(it->first, waiter)) {
-                waiter->promise.emplaceValue();
-                it = _waiters.erase(it);
-            } else {
-                ++it;
+    for (auto groupIt = _groups.begin(); groupIt != _groups.end();) {
+        auto& group = groupIt->second;
+        for (auto it = group.begin(); it != group.end() && (!opTime || it->first <= *opTime);) {
+            const auto& waiter = it->second;
+            try {
+                if (!func(it->first, waiter)) {
+                    ++it;
+                    continue;
+                }
+                _signal_inlock(waiter, Status::OK());
+            } catch (const DBException& e) {
+                _signal_inlock(waiter, e.toStatus());
+            }
+            it = group.erase(it);
+            --_size;
+            _numWaiters->decrement();
+        }
+        groupIt = group.empty() ? _groups.erase(groupIt) : std::next(groupIt);
+    }
+}
+
+template <typename Func>
+void ReplicationCoordinatorImpl::WaiterList::setValueIfInOrder_inlock(
+    Func&& func, boost::optional<OpTime> opTime) {
+    for (auto groupIt = _groups.begin(); groupIt != _groups.end();) {
+        auto& group = groupIt->second;
+        for (auto it = group.begin(); it != group.end() && (!opTime || it->first <= *opTime);) {
+            const auto& waiter = it->second;
+            try {
+                if (!func(it->first, waiter)) {
+                    // The later waiters in this group are not ready either.
+                    break;
+                }
+                _signal_inlock(waiter, Status::OK());
+            } catch (const DBException& e) {
+                _signal_inlock(waiter, e.toStatus());
             }
-        } catch (const DBException& e) {
-            waiter->promise.setError(e.toStatus());
-            it = _waiters.erase(it);
+            it = group.erase(it);
+            --_size;
+            _numWaiters->decrement();
         }
+        groupIt = group.empty() ? _groups.erase(groupIt) : std::next(groupIt);
     }
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.emplaceValue();
+    for (auto& [key, group] : _groups) {
+        for (auto& [opTime, waiter] : group) {
+            _signal_inlock(waiter, Status::OK());
+        }
     }
-    _waiters.clear();
+    _groups.clear();
+    _numWaiters->decrement(_size);
+    _size = 0;
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
     invariant(!status.isOK());
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.setError(status);
+    for (auto& [key, group] : _groups) {
+        for (auto& [opTime, waiter] : group) {
+            _signal_inlock(waiter, status);
+        }
     }
-    _waiters.clear();
+    _groups.clear();
+    _numWaiters->decrement(_size);
+    _size = 0;
+}
+
+size_t ReplicationCoordinatorImpl::WaiterList::size_inlock() const {
+    return _size;
 }
 
 namespace {
@@ -310,6 +405,8 @@ ReplicationCoordinatorImpl::ReplicationCoordinatorImpl(
       _topCoord(std::move(topCoord)),
       _replExecutor(std::move(executor)),
       _externalState(std::move(externalState)),
+      _replicationWaiterList(&numReplicationWaiters, &replicationWaitTimes),
+      _opTimeWaiterList(&numOpTimeWaiters),
       _inShutdown(false),
       _memberState(MemberState::RS_STARTUP),
       _rsConfigState(kConfigPreStart),
@@ -1728,6 +1825,11 @@ Status ReplicationCoordinatorImpl::setLastDurableOptime_forTest(long long cfgVer
     return status;
 }
 
+size_t ReplicationCoordinatorImpl::getNumReplicationWaiters_forTest() {
+    stdx::lock_guard<Latch> lock(_mutex);
+    return _replicationWaiterList.size_inlock();
+}
+
 Status ReplicationCoordinatorImpl::setLastAppliedOptime_forTest(long long cfgVer,
                                                                 long long memberId,
                                                                 const OpTime& opTime,
@@ -4341,7 +4443,9 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
-    _replicationWaiterList.setValueIf_inlock(
+    // A write concern that is not satisfied at some OpTime is not satisfied at any later one
+    // either, so only the ready prefix of each write concern's waiters is visited.
+    _replicationWaiterList.setValueIfInOrder_inlock(
         [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
             return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
@@ -31,9 +31,11 @@
 
 #include <map>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include "mongo/base/counter.h"
 #include "mongo/base/status.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/concurrency/d_concurrency.h"
@@ -47,6 +49,7 @@
 #include "mongo/db/repl/sync_source_resolver.h"
 #include "mongo/db/repl/topology_coordinator.h"
 #include "mongo/db/repl/update_position_args.h"
+#include "mongo/db/stats/timer_stats.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/random.h"
@@ -56,6 +59,7 @@
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/future.h"
 #include "mongo/util/net/hostandport.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -431,6 +435,11 @@ public:
                                         const OpTime& opTime,
                                         Date_t wallTime = Date_t());
 
+    /**
+     * Returns the number of clients waiting for their writes to replicate.
+     */
+    size_t getNumReplicationWaiters_forTest();
+
     /**
      * Simple test wrappers that expose private methods.
      */
@@ -641,6 +650,8 @@ private:
     struct Waiter {
         Promise<void> promise;
         boost::optional<WriteConcernOptions> writeConcern;
+        // Started when the waiter is created, to report how long it waited.
+        Timer timer;
         explicit Waiter(Promise<void> p, boost::optional<WriteConcernOptions> w = boost::none)
             : promise(std::move(p)), writeConcern(w) {}
     };
@@ -649,6 +660,11 @@ private:
 
     class WaiterList {
     public:
+        // Keeps 'numWaiters' equal to the number of waiters in the list and, if given, records in
+        // 'waitTimes' how long each signaled waiter waited.
+        explicit WaiterList(Counter64* numWaiters, TimerStats* waitTimes = nullptr);
+        ~WaiterList();
+
         // Adds waiter into the list.
         void add_inlock(const OpTime& opTime, SharedWaiterHandle waiter);
         // Adds a waiter into the list and returns the future of the waiter's promise.
@@ -660,14 +676,40 @@ private:
         // condition in func.
         template <typename Func>
         void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+        // Like setValueIf_inlock, but stops considering the waiters with a given write concern at
+        // the first one for which func returns false. Only valid if func returning false for a
+        // waiter implies it returns false for all later waiters with the same write concern, as
+        // for a write concern being satisfied; each call then only visits the waiters it signals,
+        // plus one per distinct write concern.
+        template <typename Func>
+        void setValueIfInOrder_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
         // Signals all waiters from the list and fulfills promises with OK status.
         void setValueAll_inlock();
         // Signals all waiters from the list and fulfills promises with Error status.
         void setErrorAll_inlock(Status status);
+        // Returns the number of waiters in the list.
+        size_t size_inlock() const;
 
     private:
-        // Waiters sorted by OpTime.
-        std::multimap<OpTime, SharedWaiterHandle> _waiters;
+        // The parts of a write concern that decide whether it is satisfied at a given OpTime.
+        using GroupKey = std::tuple<int,
+                                    std::string,
+                                    WriteConcernOptions::SyncMode,
+                                    WriteConcernOptions::CheckCondition>;
+        using Group = std::multimap<OpTime, SharedWaiterHandle>;
+
+        static GroupKey _makeGroupKey(const Waiter& waiter);
+
+        // Fulfills the waiter's promise with 'status' and records how long it waited.
+        void _signal_inlock(const SharedWaiterHandle& waiter, Status status);
+
+        // Waiters grouped by the write concern they wait for, each group sorted by OpTime.
+        // Waiters without a write concern share a group.
+        std::map<GroupKey, Group> _groups;
+        size_t _size = 0;
+
+        Counter64* const _numWaiters;
+        TimerStats* const _waitTimes;
     };
 
     typedef std::vector<executor::TaskExecutor::CallbackHandle> HeartbeatHandles;
@@ -65,6 +65,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog/type_config_version.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace repl {
@@ -135,6 +136,15 @@ boost::optional<long long> _parseDroppedCollectionCount(const OplogEntry& oplogE
     return count;
 }
 
+/**
+ * Records the time elapsed on 'timer' as the duration of 'phase' and restarts the timer for the
+ * next phase.
+ */
+void recordPhaseDuration(RollbackStats* stats, StringData phase, Timer* timer) {
+    stats->phaseDurations.emplace_back(phase.toString(), Milliseconds(timer->millis()));
+    timer->reset();
+}
+
 }  // namespace
 
 constexpr const char* RollbackImpl::kRollbackRemoveSaverType;
@@ -183,11 +193,13 @@ RollbackImpl::~RollbackImpl() {
 
 Status RollbackImpl::runRollback(OperationContext* opCtx) {
     _rollbackStats.startTime = opCtx->getServiceContext()->getFastClockSource()->now();
+    Timer phaseTimer;
 
     auto status = _transitionToRollback(opCtx);
     if (!status.isOK()) {
         return status;
     }
+    recordPhaseDuration(&_rollbackStats, "transitionToRollback", &phaseTimer);
     _listener->onTransitionToRollback();
 
     if (MONGO_unlikely(rollbackHangAfterTransitionToRollback.shouldFail())) {
@@ -195,6 +207,7 @@ Status RollbackImpl::runRollback(OperationContext* opCtx) {
               "rollbackHangAfterTransitionToRollback fail point enabled. Blocking until fail "
               "point is disabled (rollback_impl)");
         rollbackHangAfterTransitionToRollback.pauseWhileSet(opCtx);
+        phaseTimer.reset();
     }
 
     // We clear the SizeRecoveryState before we recover to a stable timestamp. This ensures that we
@@ -215,6 +228,7 @@ Status RollbackImpl::runRollback(OperationContext* opCtx) {
     const auto commonPoint = commonPointSW.getValue();
     const OpTime commonPointOpTime = commonPoint.getOpTime();
     _rollbackStats.commonPoint = commonPointOpTime;
+    recordPhaseDuration(&_rollbackStats, "findCommonPoint", &phaseTimer);
     _listener->onCommonPointFound(commonPointOpTime.getTimestamp());
 
     // Now that we have found the common point, we make sure to proceed only if the rollback
@@ -237,6 +251,7 @@ Status RollbackImpl::runRollback(OperationContext* opCtx) {
     // This function cannot fail without terminating the process.
     _runPhaseFromAbortToReconstructPreparedTxns(opCtx, commonPoint);
     _listener->onPreparedTransactionsReconstructed();
+    phaseTimer.reset();
 
     // We can now accept interruptions again.
     if (_isInShutdown()) {
@@ -252,6 +267,7 @@ Status RollbackImpl::runRollback(OperationContext* opCtx) {
     if (!status.isOK()) {
         return status;
     }
+    recordPhaseDuration(&_rollbackStats, "triggerOpObserver", &phaseTimer);
     _listener->onRollbackOpObserver(_observerInfo);
 
     LOGV2(21592, "Rollback complete");
@@ -419,11 +435,9 @@ StatusWith<std::set<NamespaceString>> RollbackImpl::_namespacesForOp(const Oplog
                 break;
             }
             case OplogEntry::CommandType::kDbCheck:
-            case OplogEntry::CommandType::kConvertToCapped:
-            case OplogEntry::CommandType::kEmptyCapped: {
+            case OplogEntry::CommandType::kConvertToCapped: {
                 // These commands do not need to be supported by rollback. 'convertToCapped' should
-                // always be converted to lower level DDL operations, and 'emptycapped' is a
-                // testing-only command.
+                // always be converted to lower level DDL operations.
                 std::string message = str::stream()
                     << "Encountered unsupported command type '" << firstElem.fieldName()
                     << "' during rollback.";
@@ -436,7 +450,8 @@ StatusWith<std::set<NamespaceString>> RollbackImpl::_namespacesForOp(const Oplog
             case OplogEntry::CommandType::kStartIndexBuild:
             case OplogEntry::CommandType::kAbortIndexBuild:
             case OplogEntry::CommandType::kCommitIndexBuild:
-            case OplogEntry::CommandType::kCollMod: {
+            case OplogEntry::CommandType::kCollMod:
+            case OplogEntry::CommandType::kEmptyCapped: {
                 // For all other command types, we should be able to parse the collection name from
                 // the first command argument.
                 try {
@@ -463,9 +478,12 @@ StatusWith<std::set<NamespaceString>> RollbackImpl::_namespacesForOp(const Oplog
 
 void RollbackImpl::_runPhaseFromAbortToReconstructPreparedTxns(
     OperationContext* opCtx, RollBackLocalOperations::RollbackCommonPoint commonPoint) noexcept {
+    Timer phaseTimer;
+
     // Stop and wait for all background index builds to complete before starting the rollback
     // process.
     _stopAndWaitForIndexBuilds(opCtx);
+    recordPhaseDuration(&_rollbackStats, "stopAndWaitForIndexBuilds", &phaseTimer);
     _listener->onBgIndexesComplete();
 
     // Before computing record store counts, abort all active transactions. This ensures that
@@ -475,6 +493,7 @@ void RollbackImpl::_runPhaseFromAbortToReconstructPreparedTxns(
     // prepared transaction. This will require us to scan all sessions and call
     // abortPreparedTransactionForRollback() on any txnParticipant with a prepared transaction.
     killSessionsAbortAllPreparedTransactions(opCtx);
+    recordPhaseDuration(&_rollbackStats, "abortPreparedTransactions", &phaseTimer);
 
     // Ask the record store for the pre-rollback counts of any collections whose counts will
     // change and create a map with the adjusted counts for post-rollback. While finding the
@@ -483,6 +502,7 @@ void RollbackImpl::_runPhaseFromAbortToReconstructPreparedTxns(
     // and thus must be set after recovering from the oplog.
     auto status = _findRecordStoreCounts(opCtx);
     fassert(31227, status);
+    recordPhaseDuration(&_rollbackStats, "findRecordStoreCounts", &phaseTimer);
 
     if (shouldCreateDataFiles()) {
         // Write a rollback file for each namespace that has documents that would be deleted by
@@ -491,6 +511,7 @@ void RollbackImpl::_runPhaseFromAbortToReconstructPreparedTxns(
         // those prepared transactions, which we know we will abort anyway.
         status = _writeRollbackFiles(opCtx);
         fassert(31228, status);
+        recordPhaseDuration(&_rollbackStats, "writeRollbackFiles", &phaseTimer);
     } else {
         LOGV2(21598, "Not writing rollback files. 'createRollbackDataFiles' set to false");
     }
@@ -502,8 +523,10 @@ void RollbackImpl::_runPhaseFromAbortToReconstructPreparedTxns(
         MongoDSessionCatalog::invalidateAllSessions(opCtx);
     }
 
-    // Recover to the stable timestamp.
+    // Recover to the stable timestamp. This includes reopening the catalog and rebuilding any
+    // indexes that were not complete as of the stable timestamp.
     auto stableTimestamp = _recoverToStableTimestamp(opCtx);
+    recordPhaseDuration(&_rollbackStats, "recoverToStableTimestamp", &phaseTimer);
 
     _rollbackStats.stableTimestamp = stableTimestamp;
     _listener->onRecoverToStableTimestamp(stableTimestamp);
@@ -549,17 +572,20 @@ void RollbackImpl::_runPhaseFromAbortToReconstructPreparedTxns(
 
     // Run the recovery process.
     _replicationProcess->getReplicationRecovery()->recoverFromOplog(opCtx, stableTimestamp);
+    recordPhaseDuration(&_rollbackStats, "recoverFromOplog", &phaseTimer);
     _listener->onRecoverFromOplog();
 
     // Sets the correct post-rollback counts on any collections whose counts changed during the
     // rollback.
     _correctRecordStoreCounts(opCtx);
+    recordPhaseDuration(&_rollbackStats, "correctRecordStoreCounts", &phaseTimer);
 
     // Reconstruct prepared transactions after counts have been adjusted. Since prepared
     // transactions were aborted (i.e. the in-memory counts were rolled-back) before computing
     // collection counts, reconstruct the prepared transactions now, adding on any additional counts
     // to the now corrected record store.
     reconstructPreparedTransactions(opCtx, OplogApplication::Mode::kRecovering);
+    recordPhaseDuration(&_rollbackStats, "reconstructPreparedTransactions", &phaseTimer);
 }
 
 void RollbackImpl::_correctRecordStoreCounts(OperationContext* opCtx) {
@@ -676,6 +702,13 @@ Status RollbackImpl::_findRecordStoreCounts(OperationContext* opCtx) {
             continue;
         }
 
+        // A collection scan also determines the count of a collection truncated by 'emptycapped',
+        // which the operations rolled back cannot account for.
+        auto newCountIt = _newCounts.find(uuid);
+        if (newCountIt != _newCounts.end() && newCountIt->second == kCollectionScanRequired) {
+            continue;
+        }
+
         auto nss = catalog.lookupNSSByUUID(opCtx, uuid);
         StorageInterface::CollectionCount oldCount = 0;
 
@@ -889,6 +922,11 @@ Status RollbackImpl::_processRollbackOp(OperationContext* opCtx, const OplogEntr
             } else {
                 _newCounts[uuid] = kCollectionScanRequired;
             }
+        } else if (oplogEntry.getCommandType() == OplogEntry::CommandType::kEmptyCapped) {
+            // The range deleter truncates collections with 'emptycapped'. The documents it removed
+            // are not in the oplog, so the count is determined by a collection scan after the
+            // rollback.
+            _newCounts[oplogEntry.getUuid().get()] = kCollectionScanRequired;
         } else if (oplogEntry.getCommandType() == OplogEntry::CommandType::kRenameCollection &&
                    oplogEntry.getObject()[kDropTargetFieldName].trueValue()) {
             // If we roll back a rename with a dropped target collection, parse the o2 field for the
@@ -1294,6 +1332,12 @@ void RollbackImpl::_summarizeRollback(OperationContext* opCtx) const {
     attrs.add("affectedNamespaces", _observerInfo.rollbackNamespaces);
     attrs.add("rollbackCommandCounts", _observerInfo.rollbackCommandCounts);
     attrs.add("totalEntriesRolledBackIncludingNoops", _observerInfo.numberOfEntriesObserved);
+    BSONObjBuilder phaseDurations;
+    for (const auto& [phase, duration] : _rollbackStats.phaseDurations) {
+        phaseDurations.append(phase, durationCount<Milliseconds>(duration));
+    }
+    auto phaseDurationMillis = phaseDurations.obj();
+    attrs.add("phaseDurationMillis", phaseDurationMillis);
     LOGV2(21612, "Rollback summary", attrs);
 }
 
@@ -965,6 +965,52 @@ TEST_F(RollbackImplTest, RollbackSavesInsertedDocumentToFile) {
     ASSERT_BSONOBJ_EQ(deletedObjs.front(), obj);
 }
 
+TEST_F(RollbackImplTest, RollbackSummaryReportsTheDurationOfEveryPhase) {
+    const auto commonOp = makeOpAndRecordId(1);
+    _remoteOplog->setOperations({commonOp});
+    ASSERT_OK(_insertOplogEntry(commonOp.first));
+    _storageInterface->setStableTimestamp(nullptr, Timestamp(1, 1));
+
+    const auto nss = NamespaceString("db.people");
+    const auto uuid = UUID::gen();
+    const auto coll = _initializeCollection(_opCtx.get(), uuid, nss);
+    _insertDocAndGenerateOplogEntry(BSON("_id" << 0), uuid, nss);
+
+    startCapturingLogMessages();
+    ASSERT_OK(_rollback->runRollback(_opCtx.get()));
+    stopCapturingLogMessages();
+
+    // The phases in the order in which rollback runs them.
+    const std::vector<std::string> expectedPhases = {"transitionToRollback",
+                                                     "findCommonPoint",
+                                                     "stopAndWaitForIndexBuilds",
+                                                     "abortPreparedTransactions",
+                                                     "findRecordStoreCounts",
+                                                     "writeRollbackFiles",
+                                                     "recoverToStableTimestamp",
+                                                     "recoverFromOplog",
+                                                     "correctRecordStoreCounts",
+                                                     "reconstructPreparedTransactions",
+                                                     "triggerOpObserver"};
+
+    boost::optional<BSONObj> phaseDurations;
+    for (auto&& line : getCapturedBSONFormatLogMessages()) {
+        if (line["id"].numberInt() == 21612) {
+            ASSERT_FALSE(phaseDurations) << "More than one rollback summary was logged";
+            phaseDurations = line["attr"]["phaseDurationMillis"].Obj().getOwned();
+        }
+    }
+    ASSERT(phaseDurations) << "No rollback summary was logged";
+
+    std::vector<std::string> phases;
+    for (auto&& elem : *phaseDurations) {
+        ASSERT(elem.isNumber()) << *phaseDurations;
+        ASSERT_GTE(elem.numberLong(), 0) << *phaseDurations;
+        phases.push_back(elem.fieldName());
+    }
+    ASSERT(phases == expectedPhases) << *phaseDurations;
+}
+
 TEST_F(RollbackImplTest, RollbackSavesLatestVersionOfDocumentWhenThereAreMultipleInserts) {
     const auto commonOp = makeOpAndRecordId(1);
     _remoteOplog->setOperations({commonOp});
@@ -1340,6 +1386,36 @@ TEST_F(RollbackImplTest, CountChangesCancelOut) {
     ASSERT_EQ(_storageInterface->getFinalCollectionCount(uuid), 1);
 }
 
+TEST_F(RollbackImplTest, RollbackScansCollectionTruncatedByEmptyCapped) {
+    auto uuid = kGenericUUID;
+    _storageInterface->setStableTimestamp(nullptr, Timestamp(1, 1));
+
+    const auto commonOp = makeOpAndRecordId(1);
+    _remoteOplog->setOperations({commonOp});
+    ASSERT_OK(_insertOplogEntry(commonOp.first));
+
+    const auto coll = _initializeCollection(_opCtx.get(), uuid, nss);
+    const Timestamp time = Timestamp(1, 1);
+    ASSERT_OK(_storageInterface->insertDocument(
+        _opCtx.get(), {nss.db().toString(), uuid}, {BSON("_id" << 1), time}, time.asULL()));
+    _insertDocAndGenerateOplogEntry(BSON("_id" << 2), uuid, nss, 2);
+
+    // The truncation removed both documents, although only one of them has an oplog entry to roll
+    // back, so the count must come from a collection scan.
+    ASSERT_OK(_insertOplogEntry(makeCommandOp(Timestamp(3, 3),
+                                              uuid,
+                                              nss.getCommandNS().toString(),
+                                              BSON("emptycapped" << nss.coll()),
+                                              3)
+                                    .first));
+    ASSERT_OK(_storageInterface->setCollectionCount(nullptr, {"", uuid}, 0));
+
+    _assertDocsInOplog(_opCtx.get(), {1, 2, 3});
+
+    ASSERT_OK(_rollback->runRollback(_opCtx.get()));
+    ASSERT_EQ(_storageInterface->getFinalCollectionCount(uuid), 2);
+}
+
 TEST_F(RollbackImplTest, RollbackIgnoresSetCollectionCountError) {
     _storageInterface->setStableTimestamp(nullptr, Timestamp(1, 1));
 
@@ -1730,13 +1806,20 @@ TEST_F(RollbackImplObserverInfoTest, NamespacesForOpsFailsOnUnsupportedOplogEntr
     auto status =
         _rollback->_namespacesForOp_forTest(OplogEntry(convertToCappedOp.first)).getStatus();
     ASSERT_EQUALS(ErrorCodes::UnrecoverableRollbackError, status);
+}
 
-    // 'emptycapped' is not supported in rollback.
-    auto emptycappedOp =
-        makeCommandOp(Timestamp(2, 2), boost::none, "test.$cmd", BSON("emptycapped" << 1), 2);
+TEST_F(RollbackImplObserverInfoTest, NamespacesForOpsExtractsNamespaceOfEmptyCappedOplogEntry) {
+    auto nss = NamespaceString("test", "coll");
+    auto cmdOp = makeCommandOp(Timestamp(2, 2),
+                               UUID::gen(),
+                               nss.getCommandNS().toString(),
+                               BSON("emptycapped" << nss.coll()),
+                               2);
 
-    status = _rollback->_namespacesForOp_forTest(OplogEntry(emptycappedOp.first)).getStatus();
-    ASSERT_EQUALS(ErrorCodes::UnrecoverableRollbackError, status);
+    std::set<NamespaceString> expectedNamespaces = {nss};
+    auto namespaces =
+        unittest::assertGet(_rollback->_namespacesForOp_forTest(OplogEntry(cmdOp.first)));
+    ASSERT(expectedNamespaces == namespaces);
 }
 
 DEATH_TEST_F(RollbackImplObserverInfoTest,
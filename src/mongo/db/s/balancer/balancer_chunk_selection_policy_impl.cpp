@@ -392,8 +392,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
-        auto candidatesStatus =
-            _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards);
+        auto candidatesStatus = _getMigrateCandidatesForCollection(
+            opCtx, nss, shardStats, &usedShards, loadAwareBalancing.load());
         if (candidatesStatus == ErrorCodes::NamespaceNotFound) {
             // Namespace got dropped before we managed to get to it, so just skip it
             continue;
@@ -438,7 +438,10 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
 
     std::set<ShardId> usedShards;
 
-    auto candidatesStatus = _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards);
+    // Reporting the status of a single collection must not take the chunk loads from the shards,
+    // since the next balancer round would then miss them.
+    auto candidatesStatus =
+        _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards, false);
     if (!candidatesStatus.isOK()) {
         return candidatesStatus.getStatus();
     }
@@ -556,7 +559,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
     OperationContext* opCtx,
     const NamespaceString& nss,
     const ShardStatisticsVector& shardStats,
-    std::set<ShardId>* usedShards) {
+    std::set<ShardId>* usedShards,
+    bool useChunkLoads) {
     auto routingInfoStatus =
         Grid::get(opCtx)->catalogCache()->getShardedCollectionRoutingInfoWithRefresh(opCtx, nss);
     if (!routingInfoStatus.isOK()) {
@@ -567,12 +571,28 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
 
     const auto& shardKeyPattern = cm->getShardKeyPattern().getKeyPattern();
 
-    const auto collInfoStatus = createCollectionDistributionStatus(opCtx, shardStats, cm);
+    auto collInfoStatus = createCollectionDistributionStatus(opCtx, shardStats, cm);
     if (!collInfoStatus.isOK()) {
         return collInfoStatus.getStatus();
     }
 
-    const DistributionStatus& distribution = collInfoStatus.getValue();
+    DistributionStatus& distribution = collInfoStatus.getValue();
+
+    if (useChunkLoads) {
+        auto swChunkLoads = _clusterStats->getChunkLoads(opCtx, nss);
+        if (swChunkLoads.isOK()) {
+            for (const auto& chunkLoad : swChunkLoads.getValue()) {
+                distribution.addChunkLoad(chunkLoad.min, chunkLoad.numOperations);
+            }
+        } else {
+            // The chunk loads only refine the placement, so balance by the number of chunks alone
+            // rather than not at all
+            LOGV2(4948607,
+                  "Unable to obtain chunk loads, balancing by the number of chunks only",
+                  "namespace"_attr = nss,
+                  "error"_attr = swChunkLoads.getStatus());
+        }
+    }
 
     for (const auto& tagRangeEntry : distribution.tagRanges()) {
         const auto& tagRange = tagRangeEntry.second;
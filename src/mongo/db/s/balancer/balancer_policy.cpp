@@ -58,12 +58,21 @@ namespace {
 // optimal average across all shards for a zone for a rebalancing migration to be initiated.
 const size_t kDefaultImbalanceThreshold = 1;
 
+// How far above the average load across the shards for a zone a shard's load needs to be, as a
+// fraction of the average, for a migration to be initiated to reduce it.
+const double kLoadImbalanceThreshold = 0.2;
+
+// The minimum total load of the chunks of a zone for load based migrations to be considered, so
+// that a handful of operations do not move chunks around.
+const uint64_t kMinZoneLoadToBalance = 1000;
+
 }  // namespace
 
 DistributionStatus::DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap)
     : _nss(std::move(nss)),
       _shardChunks(std::move(shardToChunksMap)),
-      _zoneRanges(SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ZoneRange>()) {}
+      _zoneRanges(SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<ZoneRange>()),
+      _chunkLoads(SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<uint64_t>()) {}
 
 size_t DistributionStatus::totalChunks() const {
     size_t total = 0;
@@ -112,6 +121,28 @@ const vector<ChunkType>& DistributionStatus::getChunks(const ShardId& shardId) c
     return i->second;
 }
 
+void DistributionStatus::addChunkLoad(const BSONObj& chunkMin, uint64_t load) {
+    _chunkLoads[chunkMin] += load;
+}
+
+uint64_t DistributionStatus::getChunkLoad(const ChunkType& chunk) const {
+    const auto it = _chunkLoads.find(chunk.getMin());
+    return it == _chunkLoads.end() ? 0 : it->second;
+}
+
+uint64_t DistributionStatus::loadOfShardWithTag(const ShardId& shardId,
+                                                const string& tag) const {
+    uint64_t total = 0;
+
+    for (const auto& chunk : getChunks(shardId)) {
+        if (tag == getTagForChunk(chunk)) {
+            total += getChunkLoad(chunk);
+        }
+    }
+
+    return total;
+}
+
 Status DistributionStatus::addRangeToZone(const ZoneRange& range) {
     const auto minIntersect = _zoneRanges.upper_bound(range.min);
     const auto maxIntersect = _zoneRanges.upper_bound(range.max);
@@ -539,6 +570,21 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
             ;
     }
 
+    // 4) for each tag balance the load of the shards, which were not used above
+    if (distribution.hasChunkLoads()) {
+        for (const auto& tag : tagsPlusEmpty) {
+            while (_singleZoneLoadBalance(shardStats,
+                                          distribution,
+                                          tag,
+                                          &migrations,
+                                          usedShards,
+                                          forceJumbo
+                                              ? MoveChunkRequest::ForceJumbo::kForceBalancer
+                                              : MoveChunkRequest::ForceJumbo::kDoNotForce))
+                ;
+        }
+    }
+
     return migrations;
 }
 
@@ -618,6 +664,11 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
 
     unsigned numJumboChunks = 0;
 
+    // Move the coldest chunk, so that balancing the number of chunks disturbs the load of the
+    // shards as little as possible. Without chunk loads this is the first chunk.
+    const ChunkType* coldestChunk = nullptr;
+    uint64_t coldestChunkLoad = 0;
+
     for (const auto& chunk : chunks) {
         if (distribution.getTagForChunk(chunk) != tag)
             continue;
@@ -627,8 +678,16 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
             continue;
         }
 
-        migrations->emplace_back(to, chunk, forceJumbo, MigrateInfo::chunksImbalance);
-        invariant(usedShards->insert(chunk.getShard()).second);
+        const uint64_t chunkLoad = distribution.getChunkLoad(chunk);
+        if (!coldestChunk || chunkLoad < coldestChunkLoad) {
+            coldestChunk = &chunk;
+            coldestChunkLoad = chunkLoad;
+        }
+    }
+
+    if (coldestChunk) {
+        migrations->emplace_back(to, *coldestChunk, forceJumbo, MigrateInfo::chunksImbalance);
+        invariant(usedShards->insert(coldestChunk->getShard()).second);
         invariant(usedShards->insert(to).second);
         return true;
     }
@@ -648,6 +707,117 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+bool BalancerPolicy::_singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                            const DistributionStatus& distribution,
+                                            const string& tag,
+                                            vector<MigrateInfo>* migrations,
+                                            set<ShardId>* usedShards,
+                                            MoveChunkRequest::ForceJumbo forceJumbo) {
+    uint64_t totalLoad = 0;
+    size_t numShardsWithTag = 0;
+
+    ShardId from;
+    uint64_t maxLoad = 0;
+    ShardId to;
+    uint64_t minLoad = numeric_limits<uint64_t>::max();
+
+    for (const auto& stat : shardStats) {
+        if (!tag.empty() && !stat.shardTags.count(tag))
+            continue;
+
+        const uint64_t shardLoad = distribution.loadOfShardWithTag(stat.shardId, tag);
+        totalLoad += shardLoad;
+        numShardsWithTag++;
+
+        if (usedShards->count(stat.shardId))
+            continue;
+
+        if (shardLoad > maxLoad) {
+            from = stat.shardId;
+            maxLoad = shardLoad;
+        }
+
+        if (shardLoad < minLoad && isShardSuitableReceiver(stat, tag).isOK()) {
+            to = stat.shardId;
+            minLoad = shardLoad;
+        }
+    }
+
+    if (!from.isValid() || !to.isValid() || from == to || totalLoad < kMinZoneLoadToBalance)
+        return false;
+
+    // Check whether the most loaded shard is sufficiently above the average for this zone
+    const double averageLoad = static_cast<double>(totalLoad) / numShardsWithTag;
+    if (maxLoad <= averageLoad * (1 + kLoadImbalanceThreshold))
+        return false;
+
+    // Unless the donor has more chunks than the recipient, the migration leaves the recipient with
+    // too many chunks and balancing their number later moves its coldest chunk away, so only the
+    // load above that chunk's is actually moved
+    uint64_t returnedLoad = 0;
+    if (distribution.numberOfChunksInShardWithTag(to, tag) >=
+        distribution.numberOfChunksInShardWithTag(from, tag)) {
+        bool first = true;
+        for (const auto& chunk : distribution.getChunks(to)) {
+            if (distribution.getTagForChunk(chunk) != tag || chunk.getJumbo())
+                continue;
+
+            const uint64_t chunkLoad = distribution.getChunkLoad(chunk);
+            if (first || chunkLoad < returnedLoad) {
+                returnedLoad = chunkLoad;
+                first = false;
+            }
+        }
+    }
+
+    // Moving load L changes the loads of the two shards to (max - L) and (min + L), which only
+    // lowers the higher of the two if L < max - min. The best chunk is the one which moves the load
+    // closest to half of the difference.
+    const uint64_t loadDifference = maxLoad - minLoad;
+    const ChunkType* bestChunk = nullptr;
+    uint64_t bestDistance = 0;
+
+    for (const auto& chunk : distribution.getChunks(from)) {
+        if (distribution.getTagForChunk(chunk) != tag)
+            continue;
+
+        if (chunk.getJumbo())
+            continue;
+
+        const uint64_t chunkLoad = distribution.getChunkLoad(chunk);
+        const uint64_t movedLoad = chunkLoad > returnedLoad ? chunkLoad - returnedLoad : 0;
+        if (movedLoad == 0 || movedLoad >= loadDifference)
+            continue;
+
+        const uint64_t distance = movedLoad * 2 > loadDifference ? movedLoad * 2 - loadDifference
+                                                                : loadDifference - movedLoad * 2;
+        if (!bestChunk || distance < bestDistance) {
+            bestChunk = &chunk;
+            bestDistance = distance;
+        }
+    }
+
+    LOGV2_DEBUG(4948606,
+                1,
+                "Balancing single zone by load",
+                "namespace"_attr = distribution.nss().ns(),
+                "zone"_attr = tag,
+                "fromShardId"_attr = from,
+                "fromShardLoad"_attr = maxLoad,
+                "toShardId"_attr = to,
+                "toShardLoad"_attr = minLoad,
+                "averageLoad"_attr = averageLoad,
+                "chunk"_attr = bestChunk ? redact(bestChunk->toString()) : "none");
+
+    if (!bestChunk)
+        return false;
+
+    migrations->emplace_back(to, *bestChunk, forceJumbo, MigrateInfo::loadImbalance);
+    invariant(usedShards->insert(from).second);
+    invariant(usedShards->insert(to).second);
+    return true;
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
@@ -54,7 +54,7 @@ struct ZoneRange {
 };
 
 struct MigrateInfo {
-    enum MigrationReason { drain, zoneViolation, chunksImbalance };
+    enum MigrationReason { drain, zoneViolation, chunksImbalance, loadImbalance };
 
     MigrateInfo(const ShardId& a_to,
                 const ChunkType& a_chunk,
@@ -132,6 +132,29 @@ public:
      */
     const std::vector<ChunkType>& getChunks(const ShardId& shardId) const;
 
+    /**
+     * Records the load of the chunk, which starts at the specified key. Chunks without a recorded
+     * load are considered to have none.
+     */
+    void addChunkLoad(const BSONObj& chunkMin, uint64_t load);
+
+    /**
+     * Returns whether the load of any chunk has been recorded.
+     */
+    bool hasChunkLoads() const {
+        return !_chunkLoads.empty();
+    }
+
+    /**
+     * Returns the recorded load of the specified chunk.
+     */
+    uint64_t getChunkLoad(const ChunkType& chunk) const;
+
+    /**
+     * Returns the total load of the chunks in the specified shard, which have the given tag.
+     */
+    uint64_t loadOfShardWithTag(const ShardId& shardId, const std::string& tag) const;
+
     /**
      * Returns all tag ranges defined for the collection.
      */
@@ -170,6 +193,9 @@ private:
 
     // Set of all zones defined for this collection
     std::set<std::string> _allTags;
+
+    // Map of chunk min key to the load recorded for that chunk
+    BSONObjIndexedMap<uint64_t> _chunkLoads;
 };
 
 class BalancerPolicy {
@@ -191,7 +217,9 @@ public:
      *
      * The balancing logic calculates the optimum number of chunks per shard for each zone and if
      * any of the shards have chunks, which are sufficiently higher than this number, suggests
-     * moving chunks to shards, which are under this number.
+     * moving chunks to shards, which are under this number. When chunk loads are known, the
+     * coldest chunks are moved for this and then, on shards which are not used yet, chunks are
+     * moved from the shards with the most load to the ones with the least.
      *
      * The usedShards parameter is in/out and it contains the set of shards, which have already been
      * used for migrations. Used so we don't return multiple conflicting migrations for the same
@@ -248,6 +276,24 @@ private:
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards,
                                    MoveChunkRequest::ForceJumbo forceJumbo);
+
+    /**
+     * Selects one chunk for the specified zone (if appropriate) to be moved from the shard with the
+     * most load to the shard with the least, if the former's load is sufficiently above the
+     * average for the zone. The chunk is the one whose load brings the two shards closest to each
+     * other. Chunks with more load than the difference between the two shards are never moved,
+     * since that would only move the hot spot. Takes into account and updates the shards, which
+     * have already been used for migrations.
+     *
+     * Returns true if a migration was suggested, false otherwise. This method is intented to be
+     * called multiple times until all posible migrations for a zone have been selected.
+     */
+    static bool _singleZoneLoadBalance(const ShardStatisticsVector& shardStats,
+                                       const DistributionStatus& distribution,
+                                       const std::string& tag,
+                                       std::vector<MigrateInfo>* migrations,
+                                       std::set<ShardId>* usedShards,
+                                       MoveChunkRequest::ForceJumbo forceJumbo);
 };
 
 }  // namespace mongo
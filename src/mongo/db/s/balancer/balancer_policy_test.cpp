@@ -692,6 +692,145 @@ TEST(BalancerPolicy, BalancerHandlesNoShardsWithTag) {
     ASSERT(balanceChunks(cluster.first, distribution, false, false).empty());
 }
 
+/**
+ * Builds the distribution of the specified cluster, with the load of each chunk looked up by the
+ * value of its min key, as generated by generateCluster.
+ */
+DistributionStatus makeDistributionWithLoads(const ShardToChunksMap& chunkMap,
+                                             const vector<uint64_t>& chunkLoads) {
+    DistributionStatus distribution(kNamespace, chunkMap);
+    for (const auto& shardChunks : chunkMap) {
+        for (const auto& chunk : shardChunks.second) {
+            const auto x = chunk.getMin().firstElement();
+            distribution.addChunkLoad(chunk.getMin(),
+                                      chunkLoads[x.isNumber() ? x.numberLong() : 0]);
+        }
+    }
+    return distribution;
+}
+
+uint64_t loadOfShard(const DistributionStatus& distribution, const ShardId& shardId) {
+    return distribution.loadOfShardWithTag(shardId, "");
+}
+
+/**
+ * Applies the migrations to the chunk map, keeping the chunks of each shard sorted by min key.
+ */
+void applyMigrations(const vector<MigrateInfo>& migrations, ShardToChunksMap* chunkMap) {
+    for (const auto& migration : migrations) {
+        auto& fromChunks = (*chunkMap)[migration.from];
+        auto it = std::find_if(fromChunks.begin(), fromChunks.end(), [&](const ChunkType& chunk) {
+            return chunk.getMin().woCompare(migration.minKey) == 0;
+        });
+        ASSERT(it != fromChunks.end());
+
+        ChunkType chunk = *it;
+        fromChunks.erase(it);
+        chunk.setShard(migration.to);
+
+        auto& toChunks = (*chunkMap)[migration.to];
+        toChunks.insert(std::upper_bound(toChunks.begin(),
+                                         toChunks.end(),
+                                         chunk,
+                                         [](const ChunkType& a, const ChunkType& b) {
+                                             return a.getMin().woCompare(b.getMin()) < 0;
+                                         }),
+                        std::move(chunk));
+    }
+}
+
+TEST(BalancerPolicy, ChunksImbalanceMovesColdestChunk) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 4, false, emptyTagSet, emptyShardVersion), 4},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+
+    const auto distribution = makeDistributionWithLoads(cluster.second, {50, 40, 5, 30});
+
+    const auto migrations(balanceChunks(cluster.first, distribution, false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][2].getMin(), migrations[0].minKey);
+    ASSERT_EQ(MigrateInfo::chunksImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, LoadImbalanceMovesChunkClosestToHalfTheLoadDifference) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 3, false, emptyTagSet, emptyShardVersion), 3},
+         {ShardStatistics(kShardId1, kNoMaxSize, 3, false, emptyTagSet, emptyShardVersion), 3}});
+
+    // The shards' loads are 1000 and 30. Since a chunk with 10 is moved back to even out the number
+    // of chunks, moving the chunk with 600 comes closest to moving half of the difference.
+    const auto distribution =
+        makeDistributionWithLoads(cluster.second, {300, 600, 100, 10, 10, 10});
+
+    const auto migrations(balanceChunks(cluster.first, distribution, false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][1].getMin(), migrations[0].minKey);
+    ASSERT_EQ(MigrateInfo::loadImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, LoadImbalanceDoesNotMoveChunkHotterThanLoadDifference) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    // Moving the hot chunk would only move the hot spot to the other shard and moving the cold one
+    // would not change the load once the number of chunks is evened out again
+    const auto distribution = makeDistributionWithLoads(cluster.second, {5000, 10, 10, 10});
+
+    ASSERT(balanceChunks(cluster.first, distribution, false, false).empty());
+}
+
+TEST(BalancerPolicy, LoadImbalanceIgnoresLowLoads) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    const auto distribution = makeDistributionWithLoads(cluster.second, {300, 200, 1, 1});
+
+    ASSERT(balanceChunks(cluster.first, distribution, false, false).empty());
+}
+
+TEST(BalancerPolicy, LoadImbalanceOfHotTenantConverges) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 8, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId1, kNoMaxSize, 8, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId2, kNoMaxSize, 8, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId3, kNoMaxSize, 8, false, emptyTagSet, emptyShardVersion), 8}});
+
+    // All the load of one tenant, whose chunks are on the first shard, is far above the rest
+    vector<uint64_t> chunkLoads(32, 10);
+    const vector<uint64_t> hotTenantLoads{400, 300, 200, 100, 50, 50, 50, 50};
+    std::copy(hotTenantLoads.begin(), hotTenantLoads.end(), chunkLoads.begin());
+
+    const uint64_t totalLoad = 1440;
+    const uint64_t initialMaxLoad = 1200;
+
+    const int kMaxRounds = 10;
+    int round = 0;
+    for (; round < kMaxRounds; round++) {
+        const auto distribution = makeDistributionWithLoads(cluster.second, chunkLoads);
+        const auto migrations(balanceChunks(cluster.first, distribution, false, false));
+        if (migrations.empty())
+            break;
+
+        applyMigrations(migrations, &cluster.second);
+    }
+    ASSERT_LT(round, kMaxRounds);
+
+    const auto distribution = makeDistributionWithLoads(cluster.second, chunkLoads);
+    uint64_t maxLoad = 0;
+    for (const auto& stat : cluster.first) {
+        ASSERT_EQ(8U, distribution.numberOfChunksInShard(stat.shardId));
+        maxLoad = std::max(maxLoad, loadOfShard(distribution, stat.shardId));
+    }
+    ASSERT_LT(maxLoad, initialMaxLoad / 2);
+    ASSERT_LTE(maxLoad, totalLoad / 4 * 3 / 2);
+}
+
 TEST(DistributionStatus, AddTagRangeOverlap) {
     DistributionStatus d(kNamespace, ShardToChunksMap{});
 
@@ -34,11 +34,12 @@
 #include <string>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/s/client/shard.h"
 
 namespace mongo {
 
-class BSONObj;
 class OperationContext;
 template <typename T>
 class StatusWith;
@@ -95,6 +96,21 @@ public:
         std::string mongoVersion;
     };
 
+    /**
+     * Structure, which describes the operations a shard ran against one of its chunks since it was
+     * last asked for them.
+     */
+    struct ChunkLoad {
+        BSONObj min;
+        BSONObj max;
+
+        // The number of reads and writes against the chunk.
+        uint64_t numOperations{0};
+
+        // The number of bytes read from and written to the chunk.
+        uint64_t numBytes{0};
+    };
+
     virtual ~ClusterStatistics();
 
     /**
@@ -103,6 +119,13 @@ public:
      */
     virtual StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) = 0;
 
+    /**
+     * Retrieves the load of the chunks of the specified collection, which had any operations since
+     * the previous call. Fails if any of the shards cannot report its load.
+     */
+    virtual StatusWith<std::vector<ChunkLoad>> getChunkLoads(OperationContext* opCtx,
+                                                             const NamespaceString& nss) = 0;
+
 protected:
     ClusterStatistics();
 };
@@ -165,4 +165,51 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
     return stats;
 }
 
+StatusWith<std::vector<ClusterStatistics::ChunkLoad>> ClusterStatisticsImpl::getChunkLoads(
+    OperationContext* opCtx, const NamespaceString& nss) {
+    auto shardRegistry = Grid::get(opCtx)->shardRegistry();
+
+    std::vector<ShardId> shardIds;
+    shardRegistry->getAllShardIds(opCtx, &shardIds);
+
+    std::vector<ChunkLoad> chunkLoads;
+
+    for (const auto& shardId : shardIds) {
+        auto shardStatus = shardRegistry->getShard(opCtx, shardId);
+        if (!shardStatus.isOK()) {
+            return shardStatus.getStatus();
+        }
+
+        // The shard resets the statistics it returns, so this command must not be retried.
+        auto commandResponse = shardStatus.getValue()->runCommandWithFixedRetryAttempts(
+            opCtx,
+            ReadPreferenceSetting{ReadPreference::PrimaryOnly},
+            "admin",
+            BSON("_shardsvrGetChunkLoads" << nss.ns()),
+            Shard::RetryPolicy::kNoRetry);
+        if (!commandResponse.isOK()) {
+            return commandResponse.getStatus();
+        }
+        if (!commandResponse.getValue().commandStatus.isOK()) {
+            return commandResponse.getValue().commandStatus.withContext(
+                str::stream() << "Unable to obtain chunk load information from " << shardId);
+        }
+
+        for (const auto& chunkElem : commandResponse.getValue().response["chunks"].Array()) {
+            const auto chunk = chunkElem.Obj();
+
+            ChunkLoad chunkLoad;
+            chunkLoad.min = chunk["min"].Obj().getOwned();
+            chunkLoad.max = chunk["max"].Obj().getOwned();
+            chunkLoad.numOperations = chunk["numReads"].safeNumberLong() +
+                chunk["numWrites"].safeNumberLong();
+            chunkLoad.numBytes = chunk["bytesRead"].safeNumberLong() +
+                chunk["bytesWritten"].safeNumberLong();
+            chunkLoads.push_back(std::move(chunkLoad));
+        }
+    }
+
+    return chunkLoads;
+}
+
 }  // namespace mongo
@@ -46,6 +46,9 @@ public:
 
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
 
+    StatusWith<std::vector<ChunkLoad>> getChunkLoads(OperationContext* opCtx,
+                                                     const NamespaceString& nss) override;
+
 private:
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
@@ -40,6 +40,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/s/chunk_split_state_driver.h"
 #include "mongo/db/s/shard_filtering_metadata_refresh.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/split_chunk.h"
 #include "mongo/db/s/split_vector.h"
@@ -49,6 +50,7 @@
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/chunk_manager.h"
+#include "mongo/s/chunk_writes_tracker.h"
 #include "mongo/s/config_server_client.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/shard_key_pattern.h"
@@ -215,8 +217,36 @@ bool isAutoBalanceEnabled(OperationContext* opCtx,
     return collStatus.getValue().value.getAllowBalance();
 }
 
+/**
+ * Returns the split points computed from the shard keys sampled on insert into the chunk, without
+ * the chunk's min, at which it cannot be split, or boost::none if the sample cannot be used.
+ */
+boost::optional<std::vector<BSONObj>> getSampledSplitPoints(const Chunk& chunk,
+                                                            uint64_t maxChunkSizeBytes) {
+    auto splitPoints = chunk.getWritesTracker()->getSampledSplitPoints(maxChunkSizeBytes);
+    if (!splitPoints) {
+        return boost::none;
+    }
+
+    splitPoints->erase(std::remove_if(splitPoints->begin(),
+                                      splitPoints->end(),
+                                      [&](const BSONObj& splitPoint) {
+                                          return splitPoint.woCompare(chunk.getMin()) == 0;
+                                      }),
+                       splitPoints->end());
+    if (splitPoints->empty()) {
+        return boost::none;
+    }
+
+    return splitPoints;
+}
+
 const auto getChunkSplitter = ServiceContext::declareDecoration<ChunkSplitter>();
 
+// The number of auto-splits, which could use the sampled shard keys, used to scan the shard key
+// index instead every autoSplitSampledKeysVerificationInterval of them
+AtomicWord<long long> numSplitsWithSampledKeys{0};
+
 }  // namespace
 
 ChunkSplitter::ChunkSplitter() : _threadPool(makeDefaultThreadPoolOptions()) {
@@ -326,15 +356,65 @@ void ChunkSplitter::_runAutosplit(std::shared_ptr<ChunkSplitStateDriver> chunkSp
                     "maxChunkSizeBytes"_attr = maxChunkSizeBytes);
 
         chunkSplitStateDriver->prepareSplit();
-        auto splitPoints = uassertStatusOK(splitVector(opCtx.get(),
-                                                       nss,
-                                                       shardKeyPattern.toBSON(),
-                                                       chunk.getMin(),
-                                                       chunk.getMax(),
-                                                       false,
-                                                       boost::none,
-                                                       boost::none,
-                                                       maxChunkSizeBytes));
+
+        // Splitting at the sampled keys avoids scanning the chunk's index while it is being
+        // written to, but the sample only stands for the documents inserted since this shard
+        // started tracking the chunk, so now and then the split points are checked by a scan
+        auto sampledSplitPoints = autoSplitFromSampledKeys.load()
+            ? getSampledSplitPoints(chunk, maxChunkSizeBytes)
+            : boost::none;
+        const bool verifySampledSplitPoints = sampledSplitPoints &&
+            numSplitsWithSampledKeys.fetchAndAdd(1) %
+                    autoSplitSampledKeysVerificationInterval.load() ==
+                0;
+
+        std::vector<BSONObj> splitPoints;
+        if (sampledSplitPoints && !verifySampledSplitPoints) {
+            splitPoints = std::move(*sampledSplitPoints);
+        } else {
+            splitPoints = uassertStatusOK(splitVector(opCtx.get(),
+                                                      nss,
+                                                      shardKeyPattern.toBSON(),
+                                                      chunk.getMin(),
+                                                      chunk.getMax(),
+                                                      false,
+                                                      boost::none,
+                                                      boost::none,
+                                                      maxChunkSizeBytes));
+        }
+
+        // The scan's split points are used either way. If the sample estimated the chunk's size
+        // off by more than half a chunk, which shows as a different number of split points, it is
+        // discarded, so that this chunk is split by scanning until a new sample builds up.
+        if (verifySampledSplitPoints) {
+            const auto numSampledSplitPoints = sampledSplitPoints->size();
+            const auto numSplitPoints = splitPoints.size();
+            if (std::max(numSampledSplitPoints, numSplitPoints) -
+                    std::min(numSampledSplitPoints, numSplitPoints) >
+                1) {
+                LOGV2_WARNING(4948611,
+                              "Discarding the sampled shard keys of chunk {chunk}, since "
+                              "{numSampledSplitPoints} split points were computed from them but "
+                              "{numSplitPoints} were found by scanning the chunk",
+                              "Discarding the sampled shard keys of chunk, which disagree with a "
+                              "scan of the chunk",
+                              "chunk"_attr = redact(chunk.toString()),
+                              "numSampledSplitPoints"_attr = numSampledSplitPoints,
+                              "numSplitPoints"_attr = numSplitPoints);
+                chunk.getWritesTracker()->clearSampledKeys();
+            } else {
+                LOGV2_DEBUG(4948608,
+                            1,
+                            "Verified the split points computed from the sampled shard keys of "
+                            "chunk {chunk} by scanning it: {numSampledSplitPoints} were computed "
+                            "from the sample and {numSplitPoints} were found by the scan",
+                            "Verified the split points computed from the sampled shard keys by "
+                            "scanning",
+                            "chunk"_attr = redact(chunk.toString()),
+                            "numSampledSplitPoints"_attr = numSampledSplitPoints,
+                            "numSplitPoints"_attr = numSplitPoints);
+            }
+        }
 
         if (splitPoints.empty()) {
             LOGV2_DEBUG(21907,
@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/auth/privilege.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/s/collection_sharding_runtime.h"
+#include "mongo/db/s/sharding_state.h"
+#include "mongo/s/chunk_writes_tracker.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Internal command, which the balancer runs on each shard to get the load statistics of the chunks
+ * the shard owns for a collection. Taking the statistics resets them, so each call reports the
+ * operations since the previous one. Chunks which had no operations are omitted.
+ *
+ * Format:
+ * {
+ *   _shardsvrGetChunkLoads: <string namespace>,
+ * }
+ */
+class GetChunkLoadsCommand final : public BasicCommand {
+public:
+    GetChunkLoadsCommand() : BasicCommand("_shardsvrGetChunkLoads") {}
+
+    std::string help() const override {
+        return "Internal command, which is exported by the sharding server. Do not call "
+               "directly. Returns the load statistics of the chunks this shard owns.";
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+                ResourcePattern::forClusterResource(), ActionType::internal)) {
+            return Status(ErrorCodes::Unauthorized, "Unauthorized");
+        }
+        return Status::OK();
+    }
+
+    std::string parseNs(const std::string& dbname, const BSONObj& cmdObj) const override {
+        return CommandHelpers::parseNsFullyQualified(cmdObj);
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        uassertStatusOK(ShardingState::get(opCtx)->canAcceptShardedCommands());
+
+        const NamespaceString nss(parseNs(dbname, cmdObj));
+
+        AutoGetCollection autoColl(opCtx, nss, MODE_IS);
+        const auto metadata =
+            CollectionShardingRuntime::get(opCtx, nss)->getCurrentMetadataIfKnown();
+
+        BSONArrayBuilder chunksBuilder(result.subarrayStart("chunks"));
+        if (metadata && metadata->isSharded()) {
+            for (const auto& chunk : metadata->getChunkManager()->chunks()) {
+                if (chunk.getShardId() != metadata->shardId()) {
+                    continue;
+                }
+
+                const auto stats = chunk.getWritesTracker()->takeLoadStatistics();
+                if (stats.numReads == 0 && stats.numWrites == 0) {
+                    continue;
+                }
+
+                BSONObjBuilder chunkBuilder(chunksBuilder.subobjStart());
+                chunkBuilder.append("min", chunk.getMin());
+                chunkBuilder.append("max", chunk.getMax());
+                chunkBuilder.append("numReads", static_cast<long long>(stats.numReads));
+                chunkBuilder.append("numWrites", static_cast<long long>(stats.numWrites));
+                chunkBuilder.append("bytesRead", static_cast<long long>(stats.bytesRead));
+                chunkBuilder.append("bytesWritten", static_cast<long long>(stats.bytesWritten));
+            }
+        }
+        chunksBuilder.doneFast();
+
+        return true;
+    }
+
+} getChunkLoadsCmd;
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/migration_destination_manager.h"
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -75,6 +76,7 @@
 #include "mongo/util/producer_consumer_queue.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -408,19 +410,26 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
     std::function<BSONObj(OperationContext*)> fetchBatchFn) {
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    // The donor serves batches from a single cursor, so they are fetched one at a time, but up to
+    // 'migrateCloneMaxBatchesInFlight' of them are queued for a pool of inserter threads so that
+    // fetching the next batches overlaps with inserting the previous ones.
+    SingleProducerMultiConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = migrateCloneMaxBatchesInFlight.load();
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    SingleProducerMultiConsumerQueue<BSONObj> batches(options);
+
+    auto lastOpMutex = MONGO_MAKE_LATCH("MigrationDestinationManager::cloneDocumentsFromDonor");
     repl::OpTime lastOpApplied;
 
-    stdx::thread inserterThread{[&] {
+    auto insertBatches = [&] {
         Client::initKillableThread("chunkInserter", opCtx->getServiceContext());
 
         auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
-        auto consumerGuard = makeGuard([&] {
-            batches.closeConsumerEnd();
-            lastOpApplied = repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
+        auto lastOpGuard = makeGuard([&] {
+            const auto lastOp =
+                repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
+            stdx::lock_guard<Latch> lk(lastOpMutex);
+            lastOpApplied = std::max(lastOpApplied, lastOp);
         });
 
         try {
@@ -432,7 +441,12 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
                 }
                 insertBatchFn(inserterOpCtx.get(), arr);
             }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueConsumed>&) {
+            // Another inserter thread received the final, empty batch.
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // Another inserter thread failed and has already interrupted the fetching.
         } catch (...) {
+            batches.closeConsumerEnd();
             stdx::lock_guard<Client> lk(*opCtx->getClient());
             opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
             LOGV2(21999,
@@ -440,13 +454,20 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
                   "Batch insertion failed",
                   "error"_attr = redact(exceptionToStatus()));
         }
-    }};
+    };
 
+    std::vector<stdx::thread> inserterThreads;
+    const int numInserterThreads = migrateCloneInserterThreads.load();
+    for (int i = 0; i < numInserterThreads; ++i) {
+        inserterThreads.emplace_back(insertBatches);
+    }
 
     {
         auto inserterThreadJoinGuard = makeGuard([&] {
             batches.closeProducerEnd();
-            inserterThread.join();
+            for (auto& inserterThread : inserterThreads) {
+                inserterThread.join();
+            }
         });
 
         while (true) {
@@ -1001,6 +1022,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
                     ShardingStatistics::get(opCtx).countDocsClonedOnRecipient.addAndFetch(
                         batchNumCloned);
                     _clonedBytes += batchClonedBytes;
+                    ShardingStatistics::get(opCtx).countBytesClonedOnRecipient.addAndFetch(
+                        batchClonedBytes);
                 }
                 if (_writeConcern.needToWaitForOtherNodes()) {
                     repl::ReplicationCoordinator::StatusAndDuration replStatus =
@@ -1040,8 +1063,20 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
+        Timer cloneTimer;
         lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
 
+        const auto cloneMillis = cloneTimer.millis();
+        ShardingStatistics::get(opCtx).totalRecipientChunkCloneTimeMillis.addAndFetch(
+            cloneMillis);
+        {
+            stdx::lock_guard<Latch> statsLock(_mutex);
+            timing.appendDetail("clonedDocs", _numCloned);
+            timing.appendDetail("clonedBytes", _clonedBytes);
+            timing.appendDetail("clonedBytesPerSecond",
+                                _clonedBytes * 1000 / std::max<long long>(cloneMillis, 1));
+        }
+
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
 
@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/s/migration_destination_manager.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 
@@ -105,6 +106,50 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that when several inserter threads are used, every fetched batch is inserted exactly once.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsWithParallelInsertersInsertsEveryBatch) {
+    const int originalInserterThreads = migrateCloneInserterThreads.load();
+    const int originalBatchesInFlight = migrateCloneMaxBatchesInFlight.load();
+    migrateCloneInserterThreads.store(4);
+    migrateCloneMaxBatchesInFlight.store(3);
+    ON_BLOCK_EXIT([&] {
+        migrateCloneInserterThreads.store(originalInserterThreads);
+        migrateCloneMaxBatchesInFlight.store(originalBatchesInFlight);
+    });
+
+    const int numBatches = 100;
+    int nextBatch = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+        if (nextBatch == numBatches) {
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            fetchBatchResultBuilder.append("objects", BSON_ARRAY(createDocument(nextBatch++)));
+        }
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto insertedMutex = MONGO_MAKE_LATCH();
+    std::vector<int> insertedIds;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<Latch> lk(insertedMutex);
+        for (auto&& docToClone : docs) {
+            insertedIds.push_back(docToClone.Obj()["_id"].numberInt());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn);
+
+    std::sort(insertedIds.begin(), insertedIds.end());
+    ASSERT_EQ(static_cast<size_t>(numBatches), insertedIds.size());
+    for (int i = 0; i < numBatches; ++i) {
+        ASSERT_EQ(i, insertedIds[i]);
+    }
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
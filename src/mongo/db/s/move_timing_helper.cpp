@@ -114,4 +114,8 @@ void MoveTimingHelper::done(int step) {
     _t.reset();
 }
 
+void MoveTimingHelper::appendDetail(StringData name, long long value) {
+    _b.appendNumber(name, value);
+}
+
 }  // namespace mongo
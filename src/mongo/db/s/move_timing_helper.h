@@ -55,6 +55,11 @@ public:
 
     void done(int step);
 
+    /**
+     * Adds a numeric field to the changelog entry, which is written when this helper is destroyed.
+     */
+    void appendDetail(StringData name, long long value);
+
 private:
     // Measures how long the receiving of a chunk takes
     Timer _t;
@@ -34,10 +34,13 @@
 #include "mongo/db/s/range_deletion_util.h"
 
 #include <algorithm>
+#include <limits>
 #include <utility>
 
 #include <boost/optional.hpp>
 
+#include "mongo/db/background.h"
+#include "mongo/db/catalog/capped_utils.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
@@ -46,6 +49,7 @@
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/internal_plans.h"
@@ -56,6 +60,7 @@
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/persistent_task_store.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/wait_for_majority_service.h"
 #include "mongo/db/service_context.h"
@@ -192,11 +197,16 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
 
     PlanYieldPolicy planYieldPolicy(exec.get(), PlanExecutor::YIELD_MANUAL);
 
+    // Each document is deleted in its own top-level write unit of work. Sharing one storage
+    // transaction across the batch would stamp each delete with the timestamp of the previous
+    // delete's oplog entry, since the oplog slot is only reserved after the document is removed.
     int numDeleted = 0;
     do {
         BSONObj deletedObj;
 
-        if (throwWriteConflictExceptionInDeleteRange.shouldFail()) {
+        if (throwWriteConflictExceptionInDeleteRange.shouldFail([&](const BSONObj& data) {
+                return numDeleted >= data["afterDocsDeleted"].numberInt();
+            })) {
             throw WriteConflictException();
         }
 
@@ -232,6 +242,98 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
     return numDeleted;
 }
 
+/**
+ * Truncates the collection and its indexes if every document of the collection lies within the
+ * range, which is the case once the last chunk of the collection has been migrated off this shard.
+ * The truncation is replicated as a single 'emptycapped' oplog entry, instead of one delete entry
+ * per document.
+ *
+ * Returns the number of documents removed, or 0 if nothing was truncated, in which case the range
+ * must be deleted one document at a time.
+ */
+long long truncateCollectionIfWithinRange(OperationContext* opCtx,
+                                          const NamespaceString& nss,
+                                          const UUID& collectionUuid,
+                                          const BSONObj& keyPattern,
+                                          const ChunkRange& range) {
+    // Rollback via refetch cannot restore the truncated documents, since there is no oplog entry
+    // for each of them, so only truncate if a rollback would recover to a stable timestamp.
+    if (!opCtx->getServiceContext()->getStorageEngine()->supportsRecoverToStableTimestamp()) {
+        return 0;
+    }
+
+    // emptyCapped() takes the same database lock, so no document can be written between the checks
+    // below and the truncation.
+    AutoGetDb autoDb(opCtx, nss.db(), MODE_X);
+    auto* const collection = CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, nss);
+
+    // A dropped or recreated collection is reported by the regular deletion path. System
+    // collections, such as config.system.sessions, cannot be truncated.
+    if (!collection || collection->uuid() != collectionUuid || nss.isSystem()) {
+        return 0;
+    }
+
+    if (BackgroundOperation::inProgForNs(nss) ||
+        IndexBuildsCoordinator::get(opCtx)->inProgForCollection(collectionUuid)) {
+        return 0;
+    }
+
+    const long long numRecords = collection->numRecords(opCtx);
+    if (numRecords == 0) {
+        return 0;
+    }
+
+    const IndexDescriptor* idx =
+        collection->getIndexCatalog()->findShardKeyPrefixedIndex(opCtx, keyPattern, false);
+    if (!idx) {
+        return 0;
+    }
+
+    const KeyPattern indexKeyPattern(idx->keyPattern());
+    const auto extend = [&](const auto& key) {
+        return Helpers::toKeyFormat(indexKeyPattern.extendRangeBound(key, false));
+    };
+
+    // The shard key index has an entry for every document, so the range holds all of them if the
+    // index has no key before its min or from its max onwards. A failed scan counts as a key.
+    const auto hasKeysBetween = [&](const BSONObj& min,
+                                    const BSONObj& max,
+                                    BoundInclusion boundInclusion) {
+        auto exec = InternalPlanner::indexScan(opCtx,
+                                               collection,
+                                               idx,
+                                               min,
+                                               max,
+                                               boundInclusion,
+                                               PlanExecutor::NO_YIELD,
+                                               InternalPlanner::FORWARD);
+        BSONObj key;
+        return exec->getNext(&key, nullptr) != PlanExecutor::IS_EOF;
+    };
+
+    if (hasKeysBetween(Helpers::toKeyFormat(indexKeyPattern.globalMin()),
+                       extend(range.getMin()),
+                       BoundInclusion::kIncludeStartKeyOnly) ||
+        hasKeysBetween(extend(range.getMax()),
+                       Helpers::toKeyFormat(indexKeyPattern.globalMax()),
+                       BoundInclusion::kIncludeBothStartAndEndKeys)) {
+        return 0;
+    }
+
+    uassertStatusOK(emptyCapped(opCtx, nss));
+
+    LOGV2(4948614,
+          "Truncated collection {namespace} with UUID {collectionUuid} instead of deleting range "
+          "{range}, which held all of its {numRecords} documents",
+          "Truncated collection instead of deleting a range which held all of its documents",
+          "namespace"_attr = nss,
+          "collectionUuid"_attr = collectionUuid,
+          "range"_attr = range.toString(),
+          "numRecords"_attr = numRecords);
+
+    ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(numRecords);
+    return numRecords;
+}
 
 template <typename Callable>
 auto withTemporaryOperationContext(Callable&& callable) {
@@ -284,6 +386,9 @@ void ensureRangeDeletionTaskStillExists(OperationContext* opCtx, const UUID& mig
 /**
  * Delete the range in a sequence of batches until there are no more documents to
  * delete or deletion returns an error.
+ *
+ * If rangeDeleterTruncateCollection is enabled, the first pass truncates the whole collection
+ * instead when the range holds all of its documents.
  */
 ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskExecutor>& executor,
                                           const NamespaceString& nss,
@@ -293,12 +398,25 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const boost::optional<UUID>& migrationId,
                                           int numDocsToRemovePerBatch,
                                           Milliseconds delayBetweenBatches) {
+    // The remove saver of moveParanoia must write out every deleted document.
+    auto tryTruncate = std::make_shared<bool>(rangeDeleterTruncateCollection.load() &&
+                                              !serverGlobalParams.moveParanoia);
+
     return AsyncTry([=] {
                return withTemporaryOperationContext([=](OperationContext* opCtx) {
                    if (migrationId) {
                        ensureRangeDeletionTaskStillExists(opCtx, *migrationId);
                    }
 
+                   if (std::exchange(*tryTruncate, false)) {
+                       const auto numTruncated = truncateCollectionIfWithinRange(
+                           opCtx, nss, collectionUuid, keyPattern, range);
+                       if (numTruncated > 0) {
+                           return static_cast<int>(std::min<long long>(
+                               numTruncated, std::numeric_limits<int>::max()));
+                       }
+                   }
+
                    AutoGetCollection autoColl(opCtx, nss, MODE_IX);
                    auto* const collection = autoColl.getCollection();
 
@@ -38,11 +38,14 @@
 #include "mongo/db/s/range_deletion_task_gen.h"
 #include "mongo/db/s/range_deletion_util.h"
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
+#include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/wait_for_majority_service.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -613,6 +616,86 @@ TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRetriesOnWriteConflictException)
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest, RemoveDocumentsInRangeCountsEachDeletionOnceAcrossWriteConflicts) {
+    // Throw a WriteConflictException once, after the first document of a batch was deleted.
+    globalFailPointRegistry()
+        .find("throwWriteConflictExceptionInDeleteRange")
+        ->setMode(FailPoint::nTimes, 1, BSON("afterDocsDeleted" << 1));
+
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    const auto numDocsToInsert = 3;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    auto& shardingStatistics = ShardingStatistics::get(operationContext());
+    const auto numDocsDeletedBefore = shardingStatistics.countDocsDeletedOnDonor.load();
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               10 /*numDocsToRemovePerBatch*/,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
+    // The document deleted before the write conflict stays deleted and is only counted once.
+    ASSERT_EQ(numDocsToInsert,
+              shardingStatistics.countDocsDeletedOnDonor.load() - numDocsDeletedBefore);
+}
+
+TEST_F(RangeDeleterTest,
+       RemoveDocumentsInRangeWithTruncateCollectionDeletesDocumentsWithoutRecoverToStable) {
+    rangeDeleterTruncateCollection.store(true);
+    ON_BLOCK_EXIT([] { rangeDeleterTruncateCollection.store(false); });
+
+    // The range holds every document, but the storage engine of the test cannot recover to a
+    // stable timestamp, so the range is deleted one document at a time.
+    ASSERT_FALSE(getServiceContext()->getStorageEngine()->supportsRecoverToStableTimestamp());
+
+    const ChunkRange range(BSON(kShardKey << MINKEY), BSON(kShardKey << MAXKEY));
+    const auto numDocsToInsert = 5;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+
+    auto& shardingStatistics = ShardingStatistics::get(operationContext());
+    const auto numDocsDeletedBefore = shardingStatistics.countDocsDeletedOnDonor.load();
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               2 /*numDocsToRemovePerBatch*/,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete */,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
+    ASSERT_EQ(numDocsToInsert,
+              shardingStatistics.countDocsDeletedOnDonor.load() - numDocsDeletedBefore);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeRetriesOnUnexpectedError) {
     // Enable fail point to throw InternalError.
     globalFailPointRegistry()
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/s/collection_metadata.h"
+#include "mongo/s/chunk_writes_tracker.h"
 
 namespace mongo {
 
@@ -104,6 +105,18 @@ public:
     bool keyBelongsToMe(const BSONObj& key) const {
         return _impl->get().keyBelongsToMe(key);
     }
+
+    /**
+     * Counts reads of documents with the given shard key in the load statistics of the chunk which
+     * owns them. Must only be called for sharded collections.
+     */
+    void addReads(const BSONObj& key, uint64_t numReads, uint64_t bytesRead) const {
+        _impl->get()
+            .getChunkManager()
+            ->findIntersectingChunkWithSimpleCollation(key)
+            .getWritesTracker()
+            ->addReads(numReads, bytesRead);
+    }
 };
 
 }  // namespace mongo
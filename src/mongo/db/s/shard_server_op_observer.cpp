@@ -45,6 +45,7 @@
 #include "mongo/db/s/shard_filtering_metadata_refresh.h"
 #include "mongo/db/s/shard_identity_rollback_notifier.h"
 #include "mongo/db/s/sharding_initialization_mongod.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/type_shard_identity.h"
 #include "mongo/logv2/log.h"
@@ -172,13 +173,16 @@ void onConfigDeleteInvalidateCachedCollectionMetadataAndNotify(OperationContext*
 /**
  * If the collection is sharded, finds the chunk that contains the specified document and increments
  * the size tracked for that chunk by the specified amount of data written, in bytes. Returns the
- * number of total bytes on that chunk after the data is written.
+ * number of total bytes on that chunk after the data is written. Writes which are not part of a
+ * migration are also counted in the chunk's load statistics. The shard keys of inserted documents,
+ * including those of a migration, are sampled to compute the split points of the chunk from.
  */
 void incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
                                     const NamespaceString& nss,
                                     const ChunkManager& chunkManager,
                                     const BSONObj& document,
                                     long dataWritten,
+                                    bool isInsert,
                                     bool fromMigrate) {
     const auto& shardKeyPattern = chunkManager.getShardKeyPattern();
     BSONObj shardKey = shardKeyPattern.extractShardKeyFromDoc(document);
@@ -191,9 +195,16 @@ void incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
     auto chunk = chunkManager.findIntersectingChunkWithSimpleCollation(shardKey);
     auto chunkWritesTracker = chunk.getWritesTracker();
     chunkWritesTracker->addBytesWritten(dataWritten);
+    if (isInsert && autoSplitFromSampledKeys.load()) {
+        chunkWritesTracker->addInsertedKey(shardKey, dataWritten);
+    }
     // Don't trigger chunk splits from inserts happening due to migration since
     // we don't necessarily own that chunk yet
     if (!fromMigrate) {
+        if (loadAwareBalancing.load()) {
+            chunkWritesTracker->addWrite(dataWritten);
+        }
+
         const auto balancerConfig = Grid::get(opCtx)->getBalancerConfiguration();
 
         if (balancerConfig->getShouldAutoSplit() &&
@@ -276,6 +287,7 @@ void ShardServerOpObserver::onInserts(OperationContext* opCtx,
                                            *metadata->getChunkManager(),
                                            insertedDoc,
                                            insertedDoc.objsize(),
+                                           true,
                                            fromMigrate);
         }
     }
@@ -402,6 +414,7 @@ void ShardServerOpObserver::onUpdate(OperationContext* opCtx, const OplogUpdateE
                                        *metadata->getChunkManager(),
                                        args.updateArgs.updatedDoc,
                                        args.updateArgs.updatedDoc.objsize(),
+                                       false,
                                        args.updateArgs.fromMigrate);
     }
 }
@@ -410,6 +423,22 @@ void ShardServerOpObserver::aboutToDelete(OperationContext* opCtx,
                                           NamespaceString const& nss,
                                           BSONObj const& doc) {
     getDocumentKey(opCtx) = OpObserverImpl::getDocumentKey(opCtx, nss, doc);
+
+    // Uncount the document from the sampled keys of its chunk. This has to happen here, since only
+    // the deleted document's key is available in onDelete.
+    if (autoSplitFromSampledKeys.load()) {
+        const auto metadata =
+            CollectionShardingRuntime::get(opCtx, nss)->getCurrentMetadataIfKnown();
+        if (metadata && metadata->isSharded()) {
+            const auto& chunkManager = *metadata->getChunkManager();
+            const auto shardKey = chunkManager.getShardKeyPattern().extractShardKeyFromDoc(doc);
+            if (!shardKey.isEmpty()) {
+                chunkManager.findIntersectingChunkWithSimpleCollation(shardKey)
+                    .getWritesTracker()
+                    ->removeDeletedKey(shardKey, doc.objsize());
+            }
+        }
+    }
 }
 
 void ShardServerOpObserver::onDelete(OperationContext* opCtx,
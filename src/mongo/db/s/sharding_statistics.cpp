@@ -59,6 +59,9 @@ void ShardingStatistics::report(BSONObjBuilder* builder) const {
                     totalCriticalSectionCommitTimeMillis.load());
     builder->append("totalCriticalSectionTimeMillis", totalCriticalSectionTimeMillis.load());
     builder->append("countDocsClonedOnRecipient", countDocsClonedOnRecipient.load());
+    builder->append("countBytesClonedOnRecipient", countBytesClonedOnRecipient.load());
+    builder->append("totalRecipientChunkCloneTimeMillis",
+                    totalRecipientChunkCloneTimeMillis.load());
     builder->append("countDocsClonedOnDonor", countDocsClonedOnDonor.load());
     builder->append("countRecipientMoveChunkStarted", countRecipientMoveChunkStarted.load());
     builder->append("countDocsDeletedOnDonor", countDocsDeletedOnDonor.load());
@@ -61,6 +61,14 @@ struct ShardingStatistics {
     // recipient node.
     AtomicWord<long long> countDocsClonedOnRecipient{0};
 
+    // Cumulative, always-increasing counter of how many bytes of documents have been cloned on the
+    // recipient node.
+    AtomicWord<long long> countBytesClonedOnRecipient{0};
+
+    // Cumulative, always-increasing counter of how much time the clone phase took on the recipient
+    // node. Together with countBytesClonedOnRecipient, it gives the recipient's clone throughput.
+    AtomicWord<long long> totalRecipientChunkCloneTimeMillis{0};
+
     // Cumulative, always-increasing counter of how many documents have been cloned on the donor
     // node.
     AtomicWord<long long> countDocsClonedOnDonor{0};
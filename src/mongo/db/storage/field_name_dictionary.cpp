@@ -0,0 +1,192 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/field_name_dictionary.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+constexpr char kTokenMarker = '\x01';
+constexpr char kEscapeMarker = '\xFF';
+
+bool hasSubobject(const BSONElement& elem) {
+    return elem.type() == Object || elem.type() == Array;
+}
+
+}  // namespace
+
+StatusWith<FieldNameDictionary> FieldNameDictionary::parse(const BSONElement& elem) {
+    if (elem.type() != Array) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << '\'' << kOptionName << "' must be an array of strings"};
+    }
+
+    std::vector<std::string> names;
+    StringMap<bool> seen;
+    for (auto&& nameElem : elem.Obj()) {
+        if (nameElem.type() != String) {
+            return {ErrorCodes::TypeMismatch,
+                    str::stream() << '\'' << kOptionName << "' must only contain strings, found "
+                                  << typeName(nameElem.type())};
+        }
+        auto name = nameElem.valueStringData();
+        if (name.empty()) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << '\'' << kOptionName << "' must not contain empty names"};
+        }
+        if (!seen.emplace(name.toString(), true).second) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << '\'' << kOptionName << "' contains '" << name
+                                  << "' more than once"};
+        }
+        names.push_back(name.toString());
+    }
+
+    if (names.size() > kMaxEntries) {
+        return {ErrorCodes::BadValue,
+                str::stream() << '\'' << kOptionName << "' may contain at most " << kMaxEntries
+                              << " names, found " << names.size()};
+    }
+
+    return FieldNameDictionary(std::move(names));
+}
+
+FieldNameDictionary::FieldNameDictionary(std::vector<std::string> names)
+    : _names(std::move(names)) {
+    invariant(_names.size() <= kMaxEntries);
+    for (size_t i = 0; i < _names.size(); ++i) {
+        _tokens[_names[i]] = std::string{kTokenMarker, static_cast<char>(i + 1)};
+    }
+}
+
+std::string FieldNameDictionary::encodeFieldName(StringData name) const {
+    if (auto it = _tokens.find(name); it != _tokens.end()) {
+        return it->second;
+    }
+    if (!name.empty() && name[0] == kTokenMarker) {
+        return std::string{kTokenMarker, kEscapeMarker} + name.toString();
+    }
+    return name.toString();
+}
+
+StringData FieldNameDictionary::decodeFieldName(StringData encoded) const {
+    if (encoded.empty() || encoded[0] != kTokenMarker) {
+        return encoded;
+    }
+    uassert(ErrorCodes::InvalidBSON,
+            "Truncated dictionary token in encoded record",
+            encoded.size() == 2 || (encoded.size() > 2 && encoded[1] == kEscapeMarker));
+    if (encoded[1] == kEscapeMarker) {
+        return encoded.substr(2);
+    }
+
+    const size_t index = static_cast<unsigned char>(encoded[1]) - 1;
+    uassert(ErrorCodes::InvalidBSON,
+            str::stream() << "Dictionary token " << index << " is out of range for a dictionary of "
+                          << _names.size() << " names",
+            index < _names.size());
+    return _names[index];
+}
+
+BSONObj FieldNameDictionary::encode(const BSONObj& obj) const {
+    BSONObjBuilder builder(obj.objsize());
+    _encodeInto(obj, false, &builder);
+    return builder.obj();
+}
+
+BSONObj FieldNameDictionary::decode(const BSONObj& encoded) const {
+    BSONObjBuilder builder(encoded.objsize() + _decodedSizeDelta(encoded, false));
+    _decodeInto(encoded, false, &builder);
+    return builder.obj();
+}
+
+int FieldNameDictionary::decodedSize(const BSONObj& encoded) const {
+    return encoded.objsize() + _decodedSizeDelta(encoded, false);
+}
+
+void FieldNameDictionary::_encodeInto(const BSONObj& obj,
+                                      bool isArray,
+                                      BSONObjBuilder* builder) const {
+    for (auto&& elem : obj) {
+        // Array indexes are short and positional, so they are never tokenized.
+        const auto name = elem.fieldNameStringData();
+        const auto encodedName = isArray ? name.toString() : encodeFieldName(name);
+
+        if (elem.type() == Object) {
+            BSONObjBuilder sub(builder->subobjStart(encodedName));
+            _encodeInto(elem.Obj(), false, &sub);
+        } else if (elem.type() == Array) {
+            BSONObjBuilder sub(builder->subarrayStart(encodedName));
+            _encodeInto(elem.Obj(), true, &sub);
+        } else {
+            builder->appendAs(elem, encodedName);
+        }
+    }
+}
+
+void FieldNameDictionary::_decodeInto(const BSONObj& encoded,
+                                      bool isArray,
+                                      BSONObjBuilder* builder) const {
+    for (auto&& elem : encoded) {
+        const auto name = elem.fieldNameStringData();
+        const auto decodedName = isArray ? name : decodeFieldName(name);
+
+        if (elem.type() == Object) {
+            BSONObjBuilder sub(builder->subobjStart(decodedName));
+            _decodeInto(elem.Obj(), false, &sub);
+        } else if (elem.type() == Array) {
+            BSONObjBuilder sub(builder->subarrayStart(decodedName));
+            _decodeInto(elem.Obj(), true, &sub);
+        } else {
+            builder->appendAs(elem, decodedName);
+        }
+    }
+}
+
+int FieldNameDictionary::_decodedSizeDelta(const BSONObj& encoded, bool isArray) const {
+    int delta = 0;
+    for (auto&& elem : encoded) {
+        if (!isArray) {
+            const auto name = elem.fieldNameStringData();
+            delta += static_cast<int>(decodeFieldName(name).size()) - static_cast<int>(name.size());
+        }
+        if (hasSubobject(elem)) {
+            delta += _decodedSizeDelta(elem.Obj(), elem.type() == Array);
+        }
+    }
+    return delta;
+}
+
+}  // namespace mongo
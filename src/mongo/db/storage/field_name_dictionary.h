@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * An immutable, per-collection dictionary of field names used to shrink the BSON stored for each
+ * record. Field names found in the dictionary are replaced by a two byte token on write and
+ * restored on read.
+ *
+ * The encoded form of a document is still structurally valid BSON: only field names differ. A
+ * token is the byte 0x01 followed by the (1-based) dictionary index. Field names that already
+ * begin with 0x01 are escaped by prefixing them with "\x01\xFF", so every document round trips
+ * regardless of the dictionary contents. Field names of array elements are never tokenized.
+ *
+ * Because the encoded form is BSON, a single field can be resolved without reconstructing the
+ * document by looking up 'encodeFieldName(name)' in the encoded object.
+ */
+class FieldNameDictionary {
+public:
+    /**
+     * The name of the option, inside the 'storageEngine.<engineName>' collection options, that
+     * holds the dictionary as an array of strings.
+     */
+    static constexpr StringData kOptionName = "fieldNameDictionary"_sd;
+
+    static constexpr size_t kMaxEntries = 254;
+
+    /**
+     * Parses and validates the dictionary from its 'fieldNameDictionary' option element. The
+     * element must be an array of at most 'kMaxEntries' distinct, non-empty strings.
+     */
+    static StatusWith<FieldNameDictionary> parse(const BSONElement& elem);
+
+    explicit FieldNameDictionary(std::vector<std::string> names);
+
+    /**
+     * Returns an owned copy of 'obj' with dictionary field names replaced by their tokens.
+     */
+    BSONObj encode(const BSONObj& obj) const;
+
+    /**
+     * Returns an owned copy of the original document given its encoded form.
+     */
+    BSONObj decode(const BSONObj& encoded) const;
+
+    /**
+     * Returns the size in bytes of the document 'encoded' decodes to, without materializing it.
+     */
+    int decodedSize(const BSONObj& encoded) const;
+
+    /**
+     * Returns the name under which a top-level field called 'name' is stored in encoded documents.
+     */
+    std::string encodeFieldName(StringData name) const;
+
+    /**
+     * Returns the original field name for a name read from an encoded document. The result points
+     * either into the dictionary or into 'encoded'.
+     */
+    StringData decodeFieldName(StringData encoded) const;
+
+    const std::vector<std::string>& names() const {
+        return _names;
+    }
+
+private:
+    void _encodeInto(const BSONObj& obj, bool isArray, BSONObjBuilder* builder) const;
+    void _decodeInto(const BSONObj& encoded, bool isArray, BSONObjBuilder* builder) const;
+    int _decodedSizeDelta(const BSONObj& encoded, bool isArray) const;
+
+    std::vector<std::string> _names;
+
+    // Maps each dictionary name to its encoded field name.
+    StringMap<std::string> _tokens;
+};
+
+}  // namespace mongo
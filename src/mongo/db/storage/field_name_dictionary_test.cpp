@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/db/storage/field_name_dictionary.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+FieldNameDictionary makeDictionary() {
+    return FieldNameDictionary({"temperature", "humidity", "sensorMetadata", "location"});
+}
+
+void assertRoundTrips(const FieldNameDictionary& dict, const BSONObj& obj) {
+    const BSONObj encoded = dict.encode(obj);
+    ASSERT_TRUE(obj.binaryEqual(dict.decode(encoded)));
+    ASSERT_EQ(obj.objsize(), dict.decodedSize(encoded));
+}
+
+TEST(FieldNameDictionaryTest, RoundTripFlatDocument) {
+    auto dict = makeDictionary();
+    BSONObj obj = fromjson("{_id: 1, temperature: 21.5, humidity: 40, other: 'x'}");
+    assertRoundTrips(dict, obj);
+    ASSERT_LT(dict.encode(obj).objsize(), obj.objsize());
+}
+
+TEST(FieldNameDictionaryTest, RoundTripNestedDocumentsAndArrays) {
+    auto dict = makeDictionary();
+    BSONObj obj = fromjson(
+        "{_id: 1, sensorMetadata: {location: 'roof', temperature: [1, 2, {humidity: 3}]}, "
+        "readings: [{temperature: 1}, {temperature: 2}], empty: {}, emptyArray: []}");
+    assertRoundTrips(dict, obj);
+}
+
+TEST(FieldNameDictionaryTest, EncodedDocumentIsValidBson) {
+    auto dict = makeDictionary();
+    BSONObj encoded = dict.encode(fromjson("{temperature: 1, nested: {humidity: 2}}"));
+    ASSERT_OK(validateBSON(encoded.objdata(), encoded.objsize(), BSONVersion::kLatest));
+    ASSERT_EQ(2, encoded.nFields());
+}
+
+TEST(FieldNameDictionaryTest, ArrayIndexesAreNotTokenized) {
+    FieldNameDictionary dict({"0", "1"});
+    BSONObj obj = BSON("a" << BSON_ARRAY(1 << 2));
+    BSONObj encoded = dict.encode(obj);
+    ASSERT_TRUE(obj.binaryEqual(encoded));
+    assertRoundTrips(dict, obj);
+}
+
+TEST(FieldNameDictionaryTest, NamesStartingWithTokenMarkerAreEscaped) {
+    auto dict = makeDictionary();
+    BSONObjBuilder builder;
+    builder.append("\x01", 1);
+    builder.append("\x01\x01", 2);
+    builder.append("\x01\xFF", 3);
+    builder.append("temperature", 4);
+    BSONObj obj = builder.obj();
+    assertRoundTrips(dict, obj);
+}
+
+TEST(FieldNameDictionaryTest, ResolveFieldWithoutDecoding) {
+    auto dict = makeDictionary();
+    BSONObj encoded = dict.encode(fromjson("{temperature: 21, other: 'x'}"));
+    ASSERT_EQ(21, encoded[dict.encodeFieldName("temperature")].numberInt());
+    ASSERT_EQ("x", encoded[dict.encodeFieldName("other")].str());
+    ASSERT_EQ("temperature", dict.decodeFieldName(encoded.firstElementFieldNameStringData()));
+}
+
+TEST(FieldNameDictionaryTest, DecodeRejectsOutOfRangeToken) {
+    FieldNameDictionary bigger({"a", "b", "c"});
+    BSONObj encoded = bigger.encode(BSON("c" << 1));
+    FieldNameDictionary smaller({"a"});
+    ASSERT_THROWS_CODE(smaller.decode(encoded), DBException, ErrorCodes::InvalidBSON);
+}
+
+TEST(FieldNameDictionaryTest, ParseValid) {
+    BSONObj spec = fromjson("{fieldNameDictionary: ['a', 'b']}");
+    auto swDict = FieldNameDictionary::parse(spec.firstElement());
+    ASSERT_OK(swDict.getStatus());
+    ASSERT_EQ(2U, swDict.getValue().names().size());
+}
+
+TEST(FieldNameDictionaryTest, ParseRejectsInvalidSpecs) {
+    ASSERT_EQ(FieldNameDictionary::parse(fromjson("{d: 'a'}").firstElement()).getStatus(),
+              ErrorCodes::TypeMismatch);
+    ASSERT_EQ(FieldNameDictionary::parse(fromjson("{d: ['a', 1]}").firstElement()).getStatus(),
+              ErrorCodes::TypeMismatch);
+    ASSERT_EQ(FieldNameDictionary::parse(fromjson("{d: ['a', '']}").firstElement()).getStatus(),
+              ErrorCodes::BadValue);
+    ASSERT_EQ(FieldNameDictionary::parse(fromjson("{d: ['a', 'a']}").firstElement()).getStatus(),
+              ErrorCodes::BadValue);
+
+    BSONObjBuilder builder;
+    {
+        BSONArrayBuilder names(builder.subarrayStart("d"));
+        for (size_t i = 0; i <= FieldNameDictionary::kMaxEntries; ++i) {
+            names.append(std::to_string(i));
+        }
+    }
+    ASSERT_EQ(FieldNameDictionary::parse(builder.obj().firstElement()).getStatus(),
+              ErrorCodes::BadValue);
+}
+
+}  // namespace
+}  // namespace mongo
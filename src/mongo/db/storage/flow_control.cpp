@@ -125,8 +125,57 @@ bool sustainerAdvanced(const std::vector<repl::MemberData>& prevMemberData,
 
     return true;
 }
+
+// Bounds the accumulated error of the feedback controller so that a long stretch of lag does not
+// keep it throttling long after the lag is gone.
+constexpr double kMaxFeedbackControllerIntegral = 10.0;
+
+// The most the feedback controller admits relative to the sustainer rate.
+constexpr double kMaxFeedbackControllerSpeedup = 2.0;
 }  // namespace
 
+bool FlowControlFeedbackController::shouldThrottle(bool isLagged,
+                                                   std::uint64_t lagMillis,
+                                                   std::uint64_t thresholdLagMillis) {
+    if (isLagged) {
+        _engaged = true;
+    } else if (lagMillis < thresholdLagMillis / 2) {
+        reset();
+    }
+    return _engaged;
+}
+
+double FlowControlFeedbackController::opsPermitted(std::int64_t sustainerAppliedCount,
+                                                   std::int64_t sustainerOpsBehind,
+                                                   std::uint64_t thresholdLagMillis) {
+    if (sustainerAppliedCount <= 0) {
+        return 0.0;
+    }
+
+    // At the target lag, the sustainer is as many operations behind as it applies over the
+    // threshold lag. The error is positive when it is less behind than that.
+    const double targetOpsBehind =
+        sustainerAppliedCount * static_cast<double>(thresholdLagMillis) / 1000.0;
+    const double error = (targetOpsBehind - std::max<std::int64_t>(sustainerOpsBehind, 0)) /
+        std::max(targetOpsBehind, 1.0);
+
+    _integral = std::clamp(
+        _integral + error, -kMaxFeedbackControllerIntegral, kMaxFeedbackControllerIntegral);
+    const double derivative = _lastError ? error - *_lastError : 0.0;
+    _lastError = error;
+
+    const double adjustment = 1.0 + gFlowControlProportionalGain.load() * error +
+        gFlowControlIntegralGain.load() * _integral +
+        gFlowControlDerivativeGain.load() * derivative;
+    return sustainerAppliedCount * std::clamp(adjustment, 0.0, kMaxFeedbackControllerSpeedup);
+}
+
+void FlowControlFeedbackController::reset() {
+    _engaged = false;
+    _integral = 0.0;
+    _lastError = boost::none;
+}
+
 FlowControl::FlowControl(repl::ReplicationCoordinator* replCoord)
     : ServerStatusSection("flowControl"),
       _replCoord(replCoord),
@@ -234,8 +283,8 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
                                             std::int64_t locksUsedLastPeriod,
                                             double locksPerOp,
                                             std::uint64_t lagMillis,
-                                            std::uint64_t thresholdLagMillis) {
-    invariant(lagMillis >= thresholdLagMillis);
+                                            std::uint64_t thresholdLagMillis,
+                                            Timestamp myLastAppliedTs) {
     using namespace fmt::literals;
 
     const auto currSustainerAppliedTs = getMedianAppliedTimestamp(currMemberData);
@@ -276,6 +325,27 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
         return std::min(static_cast<int>(locksUsedLastPeriod / 2.0), _kMaxTickets);
     }
 
+    if (_feedbackController.isEngaged()) {
+        // The number of operations the sustainer has yet to apply is its queue depth. -1 means
+        // there are too few to tell apart.
+        const std::int64_t sustainerOpsBehind =
+            _approximateOpsBetween(currSustainerAppliedTs, myLastAppliedTs);
+        const double opsPermitted = _feedbackController.opsPermitted(
+            sustainerAppliedCount, sustainerOpsBehind, thresholdLagMillis);
+        LOGV2_DEBUG(4948605,
+                    logSeverityV1toV2(DEBUG_LOG_LEVEL).toInt(),
+                    "Flow control feedback controller",
+                    "sustainerAppliedCount"_attr = sustainerAppliedCount,
+                    "sustainerOpsBehind"_attr = sustainerOpsBehind,
+                    "lagMillis"_attr = lagMillis,
+                    "thresholdLagMillis"_attr = thresholdLagMillis,
+                    "opsPermitted"_attr = opsPermitted);
+
+        return multiplyWithOverflowCheck(locksPerOp, opsPermitted, _kMaxTickets);
+    }
+
+    invariant(lagMillis >= thresholdLagMillis);
+
     // Given a "sustainer rate", this function wants to calculate what fraction the primary should
     // accept writes at to allow secondaries to catch up.
     //
@@ -349,11 +419,22 @@ int FlowControl::getNumTickets() {
     //
     // Don't let the no-op writer on idle systems fool the sophisticated "is the replica set
     // lagged" classifier.
-    const bool isHealthy = !ignoreWallTimes &&
+    bool isHealthy = !ignoreWallTimes &&
         (getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime) < thresholdLagMillis ||
          _approximateOpsBetween(lastCommitted.opTime.getTimestamp(),
                                 myLastApplied.opTime.getTimestamp()) == -1);
 
+    // Once engaged, the feedback controller keeps computing the allocation until the lag is well
+    // below the threshold.
+    if (!gFlowControlUseFeedbackController.load()) {
+        _feedbackController.reset();
+    } else if (!ignoreWallTimes) {
+        isHealthy = !_feedbackController.shouldThrottle(
+            !isHealthy,
+            getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime),
+            thresholdLagMillis);
+    }
+
     if (isHealthy) {
         // The add/multiply technique is used to ensure ticket allocation can ramp up quickly,
         // particularly if there were very few tickets to begin with.
@@ -376,7 +457,8 @@ int FlowControl::getNumTickets() {
                                        locksUsedLastPeriod,
                                        locksPerOp,
                                        getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime),
-                                       thresholdLagMillis);
+                                       thresholdLagMillis,
+                                       myLastApplied.opTime.getTimestamp());
         if (!_isLagged.load()) {
             _isLagged.store(true);
             _isLaggedCount.fetchAndAddRelaxed(1);
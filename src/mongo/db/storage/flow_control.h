@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <deque>
 
 #include "mongo/db/commands/server_status.h"
@@ -41,6 +42,45 @@
 
 namespace mongo {
 
+/**
+ * A proportional-integral-derivative controller for the rate at which a lagged primary accepts
+ * writes. Each period it compares how many operations the sustainer (the median member by applied
+ * optime) is behind the primary with how many it would be behind at the target lag, applying at
+ * its measured rate, and admits the sustainer rate scaled up or down by the normalized error.
+ *
+ * Once engaged, the controller stays engaged until the lag falls below half of the threshold, so
+ * that a lag hovering around the threshold does not alternate between throttling and the
+ * unthrottled ramp up.
+ */
+class FlowControlFeedbackController {
+public:
+    /**
+     * Returns whether the controller should compute the next allocation, given whether the commit
+     * point is considered lagged and the current lag. Resets the controller when it disengages.
+     */
+    bool shouldThrottle(bool isLagged, std::uint64_t lagMillis, std::uint64_t thresholdLagMillis);
+
+    /**
+     * Returns the number of operations to admit over the next period given the number of
+     * operations the sustainer applied during the last period and the number it is behind the
+     * primary. Never admits more than twice the sustainer rate.
+     */
+    double opsPermitted(std::int64_t sustainerAppliedCount,
+                        std::int64_t sustainerOpsBehind,
+                        std::uint64_t thresholdLagMillis);
+
+    bool isEngaged() const {
+        return _engaged;
+    }
+
+    void reset();
+
+private:
+    bool _engaged = false;
+    double _integral = 0.0;
+    boost::optional<double> _lastError;
+};
+
 /**
  * This class encapsulates (most) logic relating to throttling incoming writes when a primary
  * discovers the commit point is lagging behind. The only method exposed to the system for
@@ -103,7 +143,8 @@ public:
                                    std::int64_t locksUsedLastPeriod,
                                    double locksPerOp,
                                    std::uint64_t lagMillis,
-                                   std::uint64_t thresholdLagMillis);
+                                   std::uint64_t thresholdLagMillis,
+                                   Timestamp myLastAppliedTs);
     void _trimSamples(const Timestamp trimSamplesTo);
 
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
@@ -141,6 +182,8 @@ private:
 
     Date_t _lastTimeSustainerAdvanced;
 
+    FlowControlFeedbackController _feedbackController;
+
     // This value is used for calculating server status metrics.
     std::uint64_t _startWaitTime = 0;
 
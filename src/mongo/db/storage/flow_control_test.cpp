@@ -31,6 +31,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
@@ -243,6 +247,141 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       locksUsedLastPeriod,
                                                       locksPerOp,
                                                       currLag,
-                                                      thresholdLag));
+                                                      thresholdLag,
+                                                      Timestamp(3000)));
+}
+
+TEST(FlowControlFeedbackControllerTest, EngagesAtThresholdAndDisengagesBelowHalfOfIt) {
+    FlowControlFeedbackController controller;
+    const std::uint64_t thresholdLagMillis = 5000;
+
+    ASSERT_FALSE(controller.shouldThrottle(false, 4000, thresholdLagMillis));
+    ASSERT_TRUE(controller.shouldThrottle(true, 5000, thresholdLagMillis));
+
+    // Dropping below the threshold does not disengage the controller until the lag is below half
+    // of it.
+    ASSERT_TRUE(controller.shouldThrottle(false, 4000, thresholdLagMillis));
+    ASSERT_TRUE(controller.shouldThrottle(false, 2500, thresholdLagMillis));
+    ASSERT_FALSE(controller.shouldThrottle(false, 2499, thresholdLagMillis));
+    ASSERT_FALSE(controller.isEngaged());
+}
+
+TEST(FlowControlFeedbackControllerTest, PermitsSustainerRateAtTargetLag) {
+    FlowControlFeedbackController controller;
+
+    // Applying 1,000 operations per second with a 5 second threshold, the sustainer is at the
+    // target when it is 5,000 operations behind.
+    ASSERT_EQ(1000.0, controller.opsPermitted(1000, 5000, 5000));
+
+    // Further behind, fewer operations are permitted than the sustainer applies.
+    controller.reset();
+    ASSERT_LT(controller.opsPermitted(1000, 10000, 5000), 1000.0);
+
+    // Further ahead, more are permitted, but never more than twice as many.
+    controller.reset();
+    const double opsPermitted = controller.opsPermitted(1000, 0, 5000);
+    ASSERT_GT(opsPermitted, 1000.0);
+    ASSERT_LTE(opsPermitted, 2000.0);
+
+    // Nothing is permitted while the sustainer is not applying operations.
+    ASSERT_EQ(0.0, controller.opsPermitted(0, 10000, 5000));
+}
+
+/**
+ * The outcome of one second of a simulated replica set.
+ */
+struct SimulatedPeriod {
+    double opsAccepted;
+    double lagMillis;
+};
+
+/**
+ * Replays a trace of the number of operations the sustainer can apply in each second against a
+ * primary whose clients always want to write `opsDemanded` operations per second, admitted at the
+ * rate flow control permits. Returns the operations accepted and the resulting lag for each second.
+ */
+std::vector<SimulatedPeriod> replayLagTrace(const std::vector<double>& sustainerCapacity,
+                                            double opsDemanded,
+                                            std::uint64_t thresholdLagMillis) {
+    FlowControlFeedbackController controller;
+    std::vector<SimulatedPeriod> periods;
+
+    // `accepted[i]` is the total number of operations accepted by the end of second i.
+    std::vector<double> accepted{0.0};
+    double applied = 0.0;
+    double opsPermitted = std::numeric_limits<int>::max();
+
+    for (std::size_t second = 1; second <= sustainerCapacity.size(); ++second) {
+        const double opsAccepted = std::min(opsDemanded, opsPermitted);
+        accepted.push_back(accepted.back() + opsAccepted);
+        const double opsApplied =
+            std::min(sustainerCapacity[second - 1], accepted.back() - applied);
+        applied += opsApplied;
+        const double opsBehind = accepted.back() - applied;
+
+        // The lag is the age of the next operation to apply, interpolated within the second in
+        // which it was accepted.
+        double lagMillis = 0.0;
+        if (opsBehind >= 1.0) {
+            auto next = std::upper_bound(accepted.begin() + 1, accepted.end(), applied);
+            const double fraction = (applied - *(next - 1)) / (*next - *(next - 1));
+            const double acceptedAt = (next - accepted.begin()) - 1 + fraction;
+            lagMillis = (second - acceptedAt) * 1000.0;
+        }
+        periods.push_back({opsAccepted, lagMillis});
+
+        const auto lag = static_cast<std::uint64_t>(lagMillis);
+        if (controller.shouldThrottle(lag >= thresholdLagMillis, lag, thresholdLagMillis)) {
+            opsPermitted = controller.opsPermitted(static_cast<std::int64_t>(opsApplied),
+                                                   static_cast<std::int64_t>(opsBehind),
+                                                   thresholdLagMillis);
+        } else {
+            // Mirror the ramp up flow control applies when the commit point is not lagged.
+            opsPermitted = std::min((opsPermitted + gFlowControlTicketAdderConstant.load()) *
+                                        gFlowControlTicketMultiplierConstant.load(),
+                                    static_cast<double>(std::numeric_limits<int>::max()));
+        }
+        opsPermitted =
+            std::max(opsPermitted, static_cast<double>(gFlowControlMinTicketsPerSecond.load()));
+    }
+
+    return periods;
+}
+
+TEST(FlowControlFeedbackControllerTest, HoldsLagAtThresholdWhenReplayingLagTrace) {
+    // The sustainer applies around 10,000 operations per second, with some jitter, for the first
+    // 150 seconds and around 6,000 for the next 150 seconds, while clients always want to write
+    // 20,000.
+    std::vector<double> sustainerCapacity;
+    for (int second = 1; second <= 300; ++second) {
+        const double capacity = second <= 150 ? 10000 : 6000;
+        sustainerCapacity.push_back(capacity * (1.0 + 0.05 * ((second * 7) % 5 - 2)));
+    }
+    const std::uint64_t thresholdLagMillis = 5000;
+    const auto periods = replayLagTrace(sustainerCapacity, 20000, thresholdLagMillis);
+
+    // The lag overshoots while the first backlog drains, but never runs away.
+    for (const auto& period : periods) {
+        ASSERT_LT(period.lagMillis, 2.5 * thresholdLagMillis);
+    }
+
+    // Once settled, and again after the sustainer slows down, the lag stays close to the threshold
+    // and the primary accepts writes at around the rate the sustainer applies them, without
+    // alternating between throttling and bursts.
+    auto assertSteady = [&](int firstSecond, int lastSecond, double capacity) {
+        double totalAccepted = 0;
+        for (int second = firstSecond; second <= lastSecond; ++second) {
+            const auto& period = periods[second - 1];
+            ASSERT_GTE(period.lagMillis, 0.9 * thresholdLagMillis) << "second " << second;
+            ASSERT_LTE(period.lagMillis, 1.1 * thresholdLagMillis) << "second " << second;
+            ASSERT_LT(period.opsAccepted, 1.25 * capacity) << "second " << second;
+            totalAccepted += period.opsAccepted;
+        }
+        const double meanAccepted = totalAccepted / (lastSecond - firstSecond + 1);
+        ASSERT_GT(meanAccepted, 0.95 * capacity);
+        ASSERT_LT(meanAccepted, 1.05 * capacity);
+    };
+    assertSteady(60, 150, 10000);
+    assertSteady(200, 300, 6000);
 }
 }  // namespace mongo
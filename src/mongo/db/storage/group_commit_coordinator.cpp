@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/group_commit_coordinator.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+void GroupCommitCoordinator::Histogram::record(uint64_t value) {
+    const size_t bucket = value == 0 ? 0 : 64 - countLeadingZeros64(value);
+    ++_buckets[bucket];
+    ++_count;
+    _sum += value;
+}
+
+void GroupCommitCoordinator::Histogram::append(StringData name, BSONObjBuilder* builder) const {
+    BSONObjBuilder histogram(builder->subobjStart(name));
+    histogram.append("count", static_cast<long long>(_count));
+    histogram.append("sum", static_cast<long long>(_sum));
+    BSONArrayBuilder buckets(histogram.subarrayStart("buckets"));
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        if (_buckets[i] == 0) {
+            continue;
+        }
+        BSONObjBuilder bucket(buckets.subobjStart());
+        bucket.append("lowerBound", static_cast<long long>(i == 0 ? 0 : 1ull << (i - 1)));
+        bucket.append("count", static_cast<long long>(_buckets[i]));
+    }
+}
+
+void GroupCommitCoordinator::waitForFlush(bool notify, const FlushFunction& flush) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    const uint64_t batch = _lastStartedBatch + 1;
+    ++_pendingWaiters;
+    _pendingNotify = _pendingNotify || notify;
+    _waiterJoined.notify_one();
+
+    while (_lastCompletedBatch < batch) {
+        if (!_leaderActive) {
+            _leadBatch(lk, flush);
+            continue;
+        }
+        _flushDone.wait(lk);
+    }
+}
+
+void GroupCommitCoordinator::_leadBatch(stdx::unique_lock<Latch>& lk,
+                                        const FlushFunction& flush) {
+    _leaderActive = true;
+
+    if (_lastBatchSize > 1) {
+        const auto delay = std::min(_getMaxDelay(), _lastFlushDuration / 2);
+        if (delay > Microseconds(0)) {
+            const size_t expectedWaiters = _lastBatchSize;
+            _waiterJoined.wait_for(lk, delay.toSystemDuration(), [&] {
+                return _pendingWaiters >= expectedWaiters;
+            });
+        }
+    }
+
+    const size_t batchSize = std::exchange(_pendingWaiters, 0);
+    const bool notify = std::exchange(_pendingNotify, false);
+    ++_lastStartedBatch;
+
+    lk.unlock();
+    Timer timer;
+    try {
+        flush(notify);
+    } catch (...) {
+        lk.lock();
+        // Hand the batch back so that one of its other waiters can retry the flush.
+        _pendingWaiters += batchSize - 1;
+        _pendingNotify = _pendingNotify || notify;
+        _leaderActive = false;
+        _flushDone.notify_all();
+        throw;
+    }
+    const Microseconds elapsed(timer.micros());
+    lk.lock();
+
+    _lastCompletedBatch = _lastStartedBatch;
+    _leaderActive = false;
+    _lastBatchSize = batchSize;
+    _lastFlushDuration = elapsed;
+    _batchSizes.record(batchSize);
+    _flushMicros.record(durationCount<Microseconds>(elapsed));
+    _flushDone.notify_all();
+}
+
+void GroupCommitCoordinator::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->append("batches", static_cast<long long>(_lastCompletedBatch));
+    _batchSizes.append("batchSize", builder);
+    _flushMicros.append("flushMicros", builder);
+}
+
+size_t GroupCommitCoordinator::getNumPendingWaitersForTest() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _pendingWaiters;
+}
+
+}  // namespace mongo
@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <functional>
+
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Coalesces concurrent requests to make writes durable into as few flushes as possible.
+ *
+ * Each caller of waitForFlush() needs a flush that starts after it arrived. The first caller
+ * without a flush to wait for becomes the leader of a batch: it performs one flush on behalf of
+ * every caller that arrived before the flush started, while those callers sleep until it
+ * completes. Callers arriving during a flush join the next batch.
+ *
+ * When the previous batch had more than one waiter, the leader first waits up to a delay window
+ * for as many waiters as the previous batch had, so that bursts of concurrent writers share a
+ * flush. The window is half of the last flush duration, capped by the configured maximum, and is
+ * skipped entirely for a single writer.
+ *
+ * This class is thread safe.
+ */
+class GroupCommitCoordinator {
+public:
+    /**
+     * Makes all writes that completed before it was called durable. 'notify' is true if any
+     * waiter in the batch asked for durability listeners to be notified.
+     */
+    using FlushFunction = std::function<void(bool notify)>;
+
+    /**
+     * 'getMaxDelay' returns the current cap on the delay window, and is called once per batch.
+     */
+    explicit GroupCommitCoordinator(std::function<Microseconds()> getMaxDelay)
+        : _getMaxDelay(std::move(getMaxDelay)) {}
+
+    /**
+     * Returns once a flush that started after this call has completed, calling 'flush' on this
+     * thread if it leads the batch. Exceptions thrown by 'flush' propagate to the leader only; the
+     * other waiters of the batch then elect a new leader and retry.
+     */
+    void waitForFlush(bool notify, const FlushFunction& flush);
+
+    /**
+     * Appends the number of batches and histograms of batch sizes and flush latencies.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+    /**
+     * Returns the number of callers waiting for a flush that has not started yet.
+     */
+    size_t getNumPendingWaitersForTest() const;
+
+private:
+    /**
+     * Counts of values by power-of-two buckets. Bucket 0 holds zero, and bucket i > 0 holds the
+     * values in [2^(i-1), 2^i).
+     */
+    class Histogram {
+    public:
+        void record(uint64_t value);
+        void append(StringData name, BSONObjBuilder* builder) const;
+
+    private:
+        static constexpr size_t kNumBuckets = 65;
+        std::array<uint64_t, kNumBuckets> _buckets{};
+        uint64_t _count = 0;
+        uint64_t _sum = 0;
+    };
+
+    void _leadBatch(stdx::unique_lock<Latch>& lk, const FlushFunction& flush);
+
+    const std::function<Microseconds()> _getMaxDelay;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("GroupCommitCoordinator::_mutex");
+    // Signaled when a flush completes or its leader gives up.
+    stdx::condition_variable _flushDone;
+    // Signaled when a waiter joins the next batch, to end the leader's delay window early.
+    stdx::condition_variable _waiterJoined;
+
+    // Batches are numbered from 1; a waiter needs the batch after the last one started.
+    uint64_t _lastStartedBatch = 0;
+    uint64_t _lastCompletedBatch = 0;
+    bool _leaderActive = false;
+
+    // The waiters of the next batch, and whether any of them asked for notification.
+    size_t _pendingWaiters = 0;
+    bool _pendingNotify = false;
+
+    size_t _lastBatchSize = 0;
+    Microseconds _lastFlushDuration{0};
+
+    Histogram _batchSizes;
+    Histogram _flushMicros;
+};
+
+}  // namespace mongo
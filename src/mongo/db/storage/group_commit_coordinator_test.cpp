@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/group_commit_coordinator.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace {
+
+GroupCommitCoordinator makeCoordinator() {
+    return GroupCommitCoordinator([] { return Microseconds(0); });
+}
+
+template <typename Predicate>
+void waitUntil(Predicate pred) {
+    while (!pred()) {
+        sleepmillis(1);
+    }
+}
+
+TEST(GroupCommitCoordinatorTest, SingleWaiterFlushesOnce) {
+    auto coordinator = makeCoordinator();
+    int calls = 0;
+    coordinator.waitForFlush(true, [&](bool notify) {
+        ++calls;
+        ASSERT_TRUE(notify);
+    });
+    ASSERT_EQ(calls, 1);
+
+    BSONObjBuilder builder;
+    coordinator.appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["batches"].numberLong(), 1);
+    ASSERT_EQ(stats["batchSize"]["count"].numberLong(), 1);
+    ASSERT_EQ(stats["batchSize"]["sum"].numberLong(), 1);
+    ASSERT_EQ(stats["flushMicros"]["count"].numberLong(), 1);
+}
+
+TEST(GroupCommitCoordinatorTest, WaitersArrivingDuringAFlushShareTheNextOne) {
+    auto coordinator = makeCoordinator();
+    AtomicWord<int> calls{0};
+    AtomicWord<bool> notified{false};
+    Notification<void> releaseFirstFlush;
+    auto flush = [&](bool notify) {
+        if (calls.addAndFetch(1) == 1) {
+            releaseFirstFlush.get();
+        } else {
+            notified.store(notify);
+        }
+    };
+
+    stdx::thread leader([&] { coordinator.waitForFlush(false, flush); });
+    waitUntil([&] { return calls.load() == 1; });
+
+    const size_t kNumFollowers = 8;
+    std::vector<stdx::thread> followers;
+    for (size_t i = 0; i < kNumFollowers; ++i) {
+        followers.emplace_back([&, i] { coordinator.waitForFlush(i == 3, flush); });
+    }
+    waitUntil([&] { return coordinator.getNumPendingWaitersForTest() == kNumFollowers; });
+
+    releaseFirstFlush.set();
+    leader.join();
+    for (auto&& follower : followers) {
+        follower.join();
+    }
+
+    ASSERT_EQ(calls.load(), 2);
+    ASSERT_TRUE(notified.load());
+
+    BSONObjBuilder builder;
+    coordinator.appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["batches"].numberLong(), 2);
+    ASSERT_EQ(stats["batchSize"]["sum"].numberLong(), 1 + static_cast<long long>(kNumFollowers));
+}
+
+TEST(GroupCommitCoordinatorTest, FailedFlushIsRetriedByAnotherWaiter) {
+    auto coordinator = makeCoordinator();
+    AtomicWord<int> calls{0};
+    AtomicWord<int> failures{0};
+    Notification<void> releaseFirstFlush;
+    auto flush = [&](bool notify) {
+        const int call = calls.addAndFetch(1);
+        if (call == 1) {
+            releaseFirstFlush.get();
+        } else if (call == 2) {
+            uasserted(ErrorCodes::InternalError, "failed flush");
+        }
+    };
+    auto waitForFlush = [&] {
+        try {
+            coordinator.waitForFlush(false, flush);
+        } catch (const DBException& ex) {
+            ASSERT_EQ(ex.code(), ErrorCodes::InternalError);
+            failures.fetchAndAdd(1);
+        }
+    };
+
+    stdx::thread leader(waitForFlush);
+    waitUntil([&] { return calls.load() == 1; });
+
+    std::vector<stdx::thread> followers;
+    for (int i = 0; i < 4; ++i) {
+        followers.emplace_back(waitForFlush);
+    }
+    waitUntil([&] { return coordinator.getNumPendingWaitersForTest() == 4; });
+
+    releaseFirstFlush.set();
+    leader.join();
+    for (auto&& follower : followers) {
+        follower.join();
+    }
+
+    // Only the leader of the failed flush sees the error; the rest of its batch is flushed by a
+    // new leader.
+    ASSERT_EQ(failures.load(), 1);
+    ASSERT_EQ(calls.load(), 3);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -1473,6 +1473,8 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.sizeStorer = _sizeStorer.get();
     params.isReadOnly = _readOnly;
     params.tracksSizeAdjustments = true;
+    params.fieldNameDictionary = WiredTigerRecordStore::parseFieldNameDictionary(
+        options.storageEngine.getObjectField(_canonicalName));
 
     params.cappedMaxSize = -1;
     if (options.capped) {
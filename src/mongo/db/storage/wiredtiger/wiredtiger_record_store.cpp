@@ -618,6 +618,13 @@ StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj o
                 return status;
             }
             ss << elem.valueStringData() << ',';
+        } else if (elem.fieldNameStringData() == FieldNameDictionary::kOptionName) {
+            // The dictionary is applied by the record store itself and does not contribute to the
+            // WiredTiger configuration string.
+            auto swDictionary = FieldNameDictionary::parse(elem);
+            if (!swDictionary.isOK()) {
+                return swDictionary.getStatus();
+            }
         } else {
             // Return error on first unrecognized field.
             return StatusWith<std::string>(ErrorCodes::InvalidOptions,
@@ -628,6 +635,17 @@ StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj o
     return StatusWith<std::string>(ss.str());
 }
 
+// static
+std::shared_ptr<const FieldNameDictionary> WiredTigerRecordStore::parseFieldNameDictionary(
+    const BSONObj options) {
+    BSONElement elem = options[FieldNameDictionary::kOptionName];
+    if (elem.eoo()) {
+        return nullptr;
+    }
+    return std::make_shared<const FieldNameDictionary>(
+        uassertStatusOK(FieldNameDictionary::parse(elem)));
+}
+
 class WiredTigerRecordStore::RandomCursor final : public RecordCursor {
 public:
     RandomCursor(OperationContext* opCtx, const WiredTigerRecordStore& rs, StringData config)
@@ -654,7 +672,7 @@ public:
         WT_ITEM value;
         invariantWTOK(_cursor->get_value(_cursor, &value));
 
-        return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+        return {{id, _rs->_decodeRecord(value)}};
     }
 
     void save() final {
@@ -738,6 +756,14 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
 
     ss << customOptions.getValue();
 
+    if (options.capped &&
+        options.storageEngine.getObjectField(engineName).hasField(
+            FieldNameDictionary::kOptionName)) {
+        return {ErrorCodes::InvalidOptions,
+                str::stream() << '\'' << FieldNameDictionary::kOptionName
+                              << "' is not supported for capped collections"};
+    }
+
     if (NamespaceString::oplog(ns)) {
         // force file for oplog
         ss << "type=file,";
@@ -801,7 +827,8 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
       _cappedDeleteCheckCount(0),
       _sizeStorer(params.sizeStorer),
       _tracksSizeAdjustments(params.tracksSizeAdjustments),
-      _kvEngine(kvEngine) {
+      _kvEngine(kvEngine),
+      _fieldNameDictionary(std::move(params.fieldNameDictionary)) {
     invariant(_ident.size() > 0);
 
     Status versionStatus = WiredTigerUtil::checkApplicationMetadataFormatVersion(
@@ -993,7 +1020,33 @@ RecordData WiredTigerRecordStore::_getData(const WiredTigerCursor& cursor) const
     WT_ITEM value;
     invariantWTOK(cursor->get_value(cursor.get(), &value));
 
-    return RecordData(static_cast<const char*>(value.data), value.size).getOwned();
+    return _decodeRecord(value).getOwned();
+}
+
+RecordData WiredTigerRecordStore::_encodeRecord(const RecordData& data) const {
+    if (!_fieldNameDictionary) {
+        return data;
+    }
+    BSONObj encoded = _fieldNameDictionary->encode(data.toBson());
+    const int size = encoded.objsize();
+    return RecordData(encoded.releaseSharedBuffer().constCast(), size);
+}
+
+RecordData WiredTigerRecordStore::_decodeRecord(const WT_ITEM& value) const {
+    RecordData stored(static_cast<const char*>(value.data), static_cast<int>(value.size));
+    if (!_fieldNameDictionary) {
+        return stored;
+    }
+    BSONObj decoded = _fieldNameDictionary->decode(stored.toBson());
+    const int size = decoded.objsize();
+    return RecordData(decoded.releaseSharedBuffer().constCast(), size);
+}
+
+int64_t WiredTigerRecordStore::_decodedSize(const WT_ITEM& value) const {
+    if (!_fieldNameDictionary) {
+        return value.size;
+    }
+    return _fieldNameDictionary->decodedSize(BSONObj(static_cast<const char*>(value.data)));
 }
 
 bool WiredTigerRecordStore::findRecord(OperationContext* opCtx,
@@ -1033,7 +1086,7 @@ void WiredTigerRecordStore::deleteRecord(OperationContext* opCtx, const RecordId
     ret = c->get_value(c, &old_value);
     invariantWTOK(ret);
 
-    int64_t old_length = old_value.size;
+    int64_t old_length = _decodedSize(old_value);
 
     ret = WT_OP_CHECK(c->remove(c));
     invariantWTOK(ret);
@@ -1479,7 +1532,8 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             fassert(39001, opCtx->recoveryUnit()->setTimestamp(ts));
         }
         setKey(c, record.id);
-        WiredTigerItem value(record.data.data(), record.data.size());
+        const RecordData stored = _encodeRecord(record.data);
+        WiredTigerItem value(stored.data(), stored.size());
         c->set_value(c, value.Get());
         int ret = WT_OP_CHECK(c->insert(c));
         if (ret)
@@ -1585,13 +1639,16 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     ret = c->get_value(c, &old_value);
     invariantWTOK(ret);
 
-    int64_t old_length = old_value.size;
+    int64_t old_length = _decodedSize(old_value);
 
     if (_oplogStones && len != old_length) {
         return {ErrorCodes::IllegalOperation, "Cannot change the size of a document in the oplog"};
     }
 
-    WiredTigerItem value(data, len);
+    // The diff below operates on the stored representation of the old and new documents.
+    const RecordData stored = _encodeRecord(RecordData(data, len));
+    const int storedLen = stored.size();
+    WiredTigerItem value(stored.data(), storedLen);
 
     // Check if we should modify rather than doing a full update.  Look for deltas for documents
     // larger than 1KB, up to 16 changes representing up to 10% of the data.
@@ -1600,10 +1657,11 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
     // idempotent.
     const int kMinLengthForDiff = 1024;
     const int kMaxEntries = 16;
-    const int kMaxDiffBytes = len / 10;
+    const int kMaxDiffBytes = storedLen / 10;
 
     bool skip_update = false;
-    if (!_isLogged && len > kMinLengthForDiff && len <= old_length + kMaxDiffBytes) {
+    if (!_isLogged && storedLen > kMinLengthForDiff &&
+        storedLen <= static_cast<int64_t>(old_value.size) + kMaxDiffBytes) {
         int nentries = kMaxEntries;
         std::vector<WT_MODIFY> entries(nentries);
 
@@ -1615,7 +1673,7 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
             WT_ITEM new_value;
             dassert(nentries == 0 ||
                     (c->get_value(c, &new_value) == 0 && new_value.size == value.size &&
-                     memcmp(data, new_value.data, len) == 0));
+                     memcmp(stored.data(), new_value.data, storedLen) == 0));
             skip_update = true;
         } else if (ret != WT_NOTFOUND) {
             invariantWTOK(ret);
@@ -1637,7 +1695,9 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
 }
 
 bool WiredTigerRecordStore::updateWithDamagesSupported() const {
-    return true;
+    // Damages are expressed as offsets into the original document, which do not apply to records
+    // stored with tokenized field names.
+    return !_fieldNameDictionary;
 }
 
 StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
@@ -1646,6 +1706,7 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const RecordData& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages) {
+    invariant(!_fieldNameDictionary);
 
     const int nentries = damages.size();
     mutablebson::DamageVector::const_iterator where = damages.begin();
@@ -2141,7 +2202,7 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     invariantWTOK(c->get_value(c, &value));
 
     _lastReturnedId = id;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    return {{id, _rs._decodeRecord(value)}};
 }
 
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
@@ -2173,7 +2234,7 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
 
     _lastReturnedId = id;
     _eof = false;
-    return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    return {{id, _rs._decodeRecord(value)}};
 }
 
 
@@ -36,6 +36,7 @@
 
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/storage/capped_callback.h"
+#include "mongo/db/storage/field_name_dictionary.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
@@ -84,6 +85,14 @@ public:
      */
     static StatusWith<std::string> parseOptionsField(const BSONObj options);
 
+    /**
+     * Returns the field name dictionary configured in the 'wiredTiger' field of
+     * CollectionOptions::storageEngine, or nullptr if there is none. The options must already have
+     * been validated by parseOptionsField().
+     */
+    static std::shared_ptr<const FieldNameDictionary> parseFieldNameDictionary(
+        const BSONObj options);
+
     /**
      * Creates a configuration string suitable for 'config' parameter in WT_SESSION::create().
      * It is possible for 'ns' to be an empty string, in the case of internal-only temporary tables.
@@ -114,6 +123,8 @@ public:
         WiredTigerSizeStorer* sizeStorer;
         bool isReadOnly;
         bool tracksSizeAdjustments;
+        // When set, records are stored with dictionary field names replaced by short tokens.
+        std::shared_ptr<const FieldNameDictionary> fieldNameDictionary;
     };
 
     WiredTigerRecordStore(WiredTigerKVEngine* kvEngine, OperationContext* opCtx, Params params);
@@ -295,6 +306,19 @@ private:
     bool cappedAndNeedDelete() const;
     RecordData _getData(const WiredTigerCursor& cursor) const;
 
+    /**
+     * Converts between the documents handed to this record store and the bytes stored in the
+     * table. Both are no-ops unless a field name dictionary is configured, in which case the
+     * returned RecordData owns its memory.
+     */
+    RecordData _encodeRecord(const RecordData& data) const;
+    RecordData _decodeRecord(const WT_ITEM& value) const;
+
+    /**
+     * Returns the size of the document stored as 'value', as accounted for in dataSize.
+     */
+    int64_t _decodedSize(const WT_ITEM& value) const;
+
 
     /**
      * Initialize the largest known RecordId if it is not already. This is designed to be called
@@ -382,6 +406,9 @@ private:
     bool _tracksSizeAdjustments;
     WiredTigerKVEngine* _kvEngine;  // not owned.
 
+    // Non-null if records are stored with tokenized field names. Immutable once created.
+    const std::shared_ptr<const FieldNameDictionary> _fieldNameDictionary;
+
     // Non-null if this record store is underlying the active oplog.
     std::shared_ptr<OplogStones> _oplogStones;
 
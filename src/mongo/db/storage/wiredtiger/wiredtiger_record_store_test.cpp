@@ -101,6 +101,21 @@ TEST(WiredTigerRecordStoreTest, GenerateCreateStringValidConfigStringOption) {
               std::string("prefix_compression=true,"));
 }
 
+TEST(WiredTigerRecordStoreTest, GenerateCreateStringFieldNameDictionary) {
+    BSONObj spec = fromjson("{fieldNameDictionary: ['temperature', 'humidity']}");
+    ASSERT_EQ(WiredTigerRecordStore::parseOptionsField(spec), std::string(""));
+
+    auto dictionary = WiredTigerRecordStore::parseFieldNameDictionary(spec);
+    ASSERT(dictionary);
+    ASSERT_EQ(2U, dictionary->names().size());
+    ASSERT_FALSE(WiredTigerRecordStore::parseFieldNameDictionary(fromjson("{}")));
+}
+
+TEST(WiredTigerRecordStoreTest, GenerateCreateStringInvalidFieldNameDictionary) {
+    BSONObj spec = fromjson("{fieldNameDictionary: ['temperature', 1]}");
+    ASSERT_EQ(WiredTigerRecordStore::parseOptionsField(spec), ErrorCodes::TypeMismatch);
+}
+
 TEST(WiredTigerRecordStoreTest, Isolation1) {
     const auto harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
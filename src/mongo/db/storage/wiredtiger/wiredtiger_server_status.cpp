@@ -88,6 +88,11 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
                           Timestamp(_engine->getOplogManager()->getOplogReadTimestamp()));
     }
 
+    {
+        BSONObjBuilder subsection(bob.subobjStart("groupCommit"));
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendGroupCommitStats(&subsection);
+    }
+
     return bob.obj();
 }
 
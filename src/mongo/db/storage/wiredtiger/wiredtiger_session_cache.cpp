@@ -33,6 +33,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/base/error_codes.h"
@@ -45,6 +46,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -202,11 +204,26 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+Microseconds getGroupCommitMaxDelay() {
+    return Microseconds(gWiredTigerGroupCommitMaxDelayMicros.load());
+}
+
+// One shard per core keeps contention low without spreading idle sessions too thinly.
+size_t getNumCacheShards() {
+    const size_t kMaxCacheShards = 64;
+    return std::clamp<size_t>(ProcessInfo::getNumAvailableCores(), 1, kMaxCacheShards);
+}
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _numCacheShards(getNumCacheShards()),
+      _cacheShards(new CacheAligned<CacheShard>[_numCacheShards]),
+      _groupCommit(getGroupCommitMaxDelay),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -214,6 +231,9 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _numCacheShards(getNumCacheShards()),
+      _cacheShards(new CacheAligned<CacheShard>[_numCacheShards]),
+      _groupCommit(getGroupCommitMaxDelay),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -313,53 +333,47 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         return;
     }
 
-    uint32_t start = _lastSyncTime.load();
-    // Do the remainder in a critical section that ensures only a single thread at a time
-    // will attempt to synchronize.
-    stdx::unique_lock<Latch> lk(_lastSyncMutex);
-    uint32_t current = _lastSyncTime.loadRelaxed();  // synchronized with writes through mutex
-    if (current != start) {
-        // Someone else synced already since we read lastSyncTime, so we're done!
-        return;
-    }
-    _lastSyncTime.store(current + 1);
-
-    // Nobody has synched yet, so we have to sync ourselves.
-
-    // Update a value that tracks the latest write that is safe across startup recovery (in the repl
-    // layer) and then report the time of that write as durable after we flush in-memory to disk.
-    auto journalListener = [&]() -> JournalListener* {
-        // The JournalListener may not be set immediately, so we must check under a mutex so as not
-        // to access the variable while setting a JournalListener. A JournalListener is only allowed
-        // to be set once, so using the pointer outside of a mutex is safe.
-        stdx::unique_lock<Latch> lk(_journalListenerMutex);
-        return _journalListener;
-    }();
-    boost::optional<JournalListener::Token> token;
-    if (journalListener && useListener == UseJournalListener::kUpdate) {
-        token = _journalListener->getToken(opCtx);
-    }
+    // Only one thread at a time flushes, on behalf of every thread that started waiting before
+    // its flush began. The leader's listener token is fetched after all of those threads' writes
+    // committed, so it covers them too.
+    _groupCommit.waitForFlush(useListener == UseJournalListener::kUpdate, [&](bool updateListener) {
+        // Update a value that tracks the latest write that is safe across startup recovery (in the
+        // repl layer) and then report the time of that write as durable after we flush in-memory
+        // to disk.
+        auto journalListener = [&]() -> JournalListener* {
+            // The JournalListener may not be set immediately, so we must check under a mutex so
+            // as not to access the variable while setting a JournalListener. A JournalListener is
+            // only allowed to be set once, so using the pointer outside of a mutex is safe.
+            stdx::unique_lock<Latch> lk(_journalListenerMutex);
+            return _journalListener;
+        }();
+        boost::optional<JournalListener::Token> token;
+        if (journalListener && updateListener) {
+            token = _journalListener->getToken(opCtx);
+        }
 
-    // Initialize on first use.
-    if (!_waitUntilDurableSession) {
-        invariantWTOK(
-            _conn->open_session(_conn, nullptr, "isolation=snapshot", &_waitUntilDurableSession));
-    }
+        // Initialize on first use.
+        if (!_waitUntilDurableSession) {
+            invariantWTOK(_conn->open_session(
+                _conn, nullptr, "isolation=snapshot", &_waitUntilDurableSession));
+        }
 
-    // Use the journal when available, or a checkpoint otherwise.
-    if (_engine && _engine->isDurable()) {
-        invariantWTOK(_waitUntilDurableSession->log_flush(_waitUntilDurableSession, "sync=on"));
-        LOGV2_DEBUG(22419, 4, "flushed journal");
-    } else {
-        auto checkpointLock = _engine->getCheckpointLock(opCtx);
-        _engine->clearIndividuallyCheckpointedIndexesList();
-        invariantWTOK(_waitUntilDurableSession->checkpoint(_waitUntilDurableSession, nullptr));
-        LOGV2_DEBUG(22420, 4, "created checkpoint");
-    }
+        // Use the journal when available, or a checkpoint otherwise.
+        if (_engine && _engine->isDurable()) {
+            invariantWTOK(
+                _waitUntilDurableSession->log_flush(_waitUntilDurableSession, "sync=on"));
+            LOGV2_DEBUG(22419, 4, "flushed journal");
+        } else {
+            auto checkpointLock = _engine->getCheckpointLock(opCtx);
+            _engine->clearIndividuallyCheckpointedIndexesList();
+            invariantWTOK(_waitUntilDurableSession->checkpoint(_waitUntilDurableSession, nullptr));
+            LOGV2_DEBUG(22420, 4, "created checkpoint");
+        }
 
-    if (token) {
-        _journalListener->onDurable(token.get());
-    }
+        if (token) {
+            _journalListener->onDurable(token.get());
+        }
+    });
 }
 
 void WiredTigerSessionCache::waitUntilPreparedUnitOfWorkCommitsOrAborts(OperationContext* opCtx,
@@ -380,10 +394,19 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 }
 
 
+size_t WiredTigerSessionCache::_homeShardIndex() const {
+    // Threads are assigned home shards round-robin the first time they use any session cache.
+    static AtomicWord<unsigned> nextThreadIndex{0};
+    thread_local const unsigned threadIndex = nextThreadIndex.fetchAndAdd(1);
+    return threadIndex % _numCacheShards;
+}
+
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (size_t shard = 0; shard < _numCacheShards; ++shard) {
+        stdx::lock_guard<Latch> lock(_cacheShards[shard].mutex);
+        for (auto&& session : _cacheShards[shard].sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -391,15 +414,21 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (size_t shard = 0; shard < _numCacheShards; ++shard) {
+        stdx::lock_guard<Latch> lock(_cacheShards[shard].mutex);
+        for (auto&& session : _cacheShards[shard].sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t shard = 0; shard < _numCacheShards; ++shard) {
+        stdx::lock_guard<Latch> lock(_cacheShards[shard].mutex);
+        count += _cacheShards[shard].sessions.size();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -409,14 +438,15 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (size_t shard = 0; shard < _numCacheShards; ++shard) {
+        stdx::lock_guard<Latch> lock(_cacheShards[shard].mutex);
+        auto& sessions = _cacheShards[shard].sessions;
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = sessions.begin(); it != sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = sessions.erase(it);
                 delete (session);
             } else {
                 ++it;
@@ -426,13 +456,19 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This happens before
+    // emptying any shard, so a session released into a shard after it was emptied sees the new
+    // epoch under the shard's mutex and is not cached.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (size_t shard = 0; shard < _numCacheShards; ++shard) {
+        SessionCache shardSessions;
+        {
+            stdx::lock_guard<Latch> lock(_cacheShards[shard].mutex);
+            _cacheShards[shard].sessions.swap(shardSessions);
+        }
+        swap.insert(swap.end(), shardSessions.begin(), shardSessions.end());
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -449,15 +485,37 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
+    auto takeSession = [](CacheShard& shard) -> WiredTigerSession* {
+        if (shard.sessions.empty()) {
+            return nullptr;
+        }
+        // Get the most recently used session so that if we discard sessions, we're
+        // discarding older ones
+        WiredTigerSession* cachedSession = shard.sessions.back();
+        shard.sessions.pop_back();
+        // Reset the idle time
+        cachedSession->setIdleExpireTime(Date_t::min());
+        return cachedSession;
+    };
+
+    const size_t homeIndex = _homeShardIndex();
     {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
-            // Get the most recently used session so that if we discard sessions, we're
-            // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
-            // Reset the idle time
-            cachedSession->setIdleExpireTime(Date_t::min());
+        CacheShard& home = _cacheShards[homeIndex];
+        stdx::lock_guard<Latch> lock(home.mutex);
+        if (auto cachedSession = takeSession(home)) {
+            return UniqueWiredTigerSession(cachedSession);
+        }
+    }
+
+    // Steal from the other shards, skipping any that are busy: opening a new session is cheaper
+    // than queueing behind other threads.
+    for (size_t i = 1; i < _numCacheShards; ++i) {
+        CacheShard& shard = _cacheShards[(homeIndex + i) % _numCacheShards];
+        stdx::unique_lock<Latch> lock(shard.mutex, stdx::try_to_lock);
+        if (!lock.owns_lock()) {
+            continue;
+        }
+        if (auto cachedSession = takeSession(shard)) {
             return UniqueWiredTigerSession(cachedSession);
         }
     }
@@ -517,10 +575,11 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        CacheShard& home = _cacheShards[_homeShardIndex()];
+        stdx::lock_guard<Latch> lock(home.mutex);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            home.sessions.push_back(session);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -34,11 +34,13 @@
 
 #include <wiredtiger.h>
 
+#include "mongo/db/storage/group_commit_coordinator.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -296,9 +298,9 @@ public:
     /**
      * Waits until all commits that happened before this call are made durable.
      *
-     * Specifying Fsync::kJournal will flush only the (oplog) journal to disk. Callers are
-     * serialized by a mutex and will return early if it is discovered that another thread started
-     * and completed a flush while they slept.
+     * Specifying Fsync::kJournal will flush only the (oplog) journal to disk. Concurrent callers
+     * are grouped so that a single flush, performed by one of them, makes all of their writes
+     * durable. See GroupCommitCoordinator.
      *
      * Specifying Fsync::kCheckpointStableTimestamp will take a checkpoint up to and including the
      * stable timestamp.
@@ -361,6 +363,13 @@ public:
         return _prepareCommitOrAbortCounter.loadRelaxed();
     }
 
+    /**
+     * Appends statistics on the batching of journal flushes by waitUntilDurable().
+     */
+    void appendGroupCommitStats(BSONObjBuilder* builder) const {
+        _groupCommit.appendStats(builder);
+    }
+
 private:
     WiredTigerKVEngine* _engine;      // not owned, might be NULL
     WT_CONNECTION* _conn;             // not owned
@@ -373,9 +382,24 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // Idle sessions are spread over shards so that threads returning and taking sessions do not
+    // all contend on one mutex. Each thread has a home shard, and takes sessions from the other
+    // shards only when its own is empty.
+    struct CacheShard {
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::CacheShard::mutex");
+        SessionCache sessions;
+    };
+
+    /**
+     * Returns the index of the shard that the calling thread releases sessions to and takes them
+     * from first.
+     */
+    size_t _homeShardIndex() const;
+
+    const size_t _numCacheShards;
+    std::unique_ptr<CacheAligned<CacheShard>[]> _cacheShards;
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -383,9 +407,8 @@ private:
     // Bumped when all open cursors need to be closed
     AtomicWord<unsigned long long> _cursorEpoch;  // atomic so we can check it outside of the lock
 
-    // Counter and critical section mutex for waitUntilDurable
-    AtomicWord<unsigned> _lastSyncTime;
-    Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
+    // Batches concurrent journal flushes in waitUntilDurable.
+    GroupCommitCoordinator _groupCommit;
 
     // Mutex and cond var for waiting on prepare commit or abort.
     Mutex _prepareCommittedOrAbortedMutex =
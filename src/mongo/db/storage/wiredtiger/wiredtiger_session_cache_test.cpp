@@ -29,12 +29,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/system_clock_source.h"
@@ -113,4 +116,46 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, SessionReleasedOnAnotherThreadIsReused) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Each thread releases its session to its own shard, so the sessions can only be reused here
+    // by taking them from other threads' shards.
+    std::set<WiredTigerSession*> released;
+    for (int i = 0; i < 4; ++i) {
+        stdx::thread([&] {
+            UniqueWiredTigerSession session = sessionCache->getSession();
+            released.insert(session.get());
+        })
+            .join();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), released.size());
+
+    std::vector<UniqueWiredTigerSession> sessions;
+    for (size_t i = 0; i < released.size(); ++i) {
+        sessions.push_back(sessionCache->getSession());
+        ASSERT_EQUALS(released.count(sessions.back().get()), 1U);
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, CloseAllEmptiesEveryShard) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    UniqueWiredTigerSession outstanding = sessionCache->getSession();
+    for (int i = 0; i < 4; ++i) {
+        stdx::thread([&] { sessionCache->getSession(); }).join();
+    }
+    ASSERT_GTE(sessionCache->getIdleSessionsCount(), 1U);
+
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    // A session from before closeAll() is not returned to the cache.
+    outstanding.reset();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
 }  // namespace mongo
@@ -126,8 +126,12 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
                 "WiredTigerSizeStorer::load {uri} -> {data}",
                 "uri"_attr = uri,
                 "data"_attr = redact(data));
-    return std::make_shared<SizeInfo>(data["numRecords"].safeNumberLong(),
-                                      data["dataSize"].safeNumberLong());
+    auto sizeInfo = std::make_shared<SizeInfo>(data["numRecords"].safeNumberLong(),
+                                               data["dataSize"].safeNumberLong());
+    sizeInfo->_persisted = true;
+    sizeInfo->_persistedNumRecords = sizeInfo->numRecords.load();
+    sizeInfo->_persistedDataSize = sizeInfo->dataSize.load();
+    return sizeInfo;
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
@@ -141,30 +145,53 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
         return;  // Nothing to do.
 
     Timer t;
-    stdx::lock_guard<Latch> cursorLock(_cursorMutex);
-    {
-        // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
-            this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
-            }
-        });
+    const size_t numEntries = buffer.size();
+    size_t numWritten = 0;
+
+    // On failure, place the entries not yet written back into the map, unless a newer value
+    // already exists.
+    ON_BLOCK_EXIT([this, &buffer]() {
+        if (!buffer.empty()) {
+            stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
+            for (auto& it : buffer)
+                this->_buffer.try_emplace(it.first, it.second);
+        }
+    });
+
+    // Write the entries in bounded transactions, releasing the cursor in between so that loads
+    // of collections being opened are not blocked for the whole flush.
+    while (!buffer.empty()) {
+        stdx::lock_guard<Latch> cursorLock(_cursorMutex);
+        ON_BLOCK_EXIT([this]() { this->_cursor->reset(this->_cursor); });
 
         WT_SESSION* session = _session.getSession();
         WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
 
-        for (auto it = buffer.begin(); it != buffer.end(); ++it) {
+        struct WrittenEntry {
+            SizeInfo* sizeInfo;
+            long long numRecords;
+            long long dataSize;
+        };
+        std::vector<WrittenEntry> written;
+        auto it = buffer.begin();
+        for (size_t n = 0; n < kMaxEntriesPerFlushTransaction && it != buffer.end(); ++it, ++n) {
 
             // Ordering is important here: when the store method checks if the SizeInfo
             // is dirty and it returns true, the current values of numRecords and dataSize must
             // still be written back. So, the required order is to clear the dirty flag first.
             SizeInfo& sizeInfo = *it->second;
             sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
+            const long long numRecords = sizeInfo.numRecords.load();
+            const long long dataSize = sizeInfo.dataSize.load();
+
+            // Changes that cancel out since the last flush, such as an insert and a delete of the
+            // same document, leave nothing to write.
+            if (sizeInfo._persisted && sizeInfo._persistedNumRecords == numRecords &&
+                sizeInfo._persistedDataSize == dataSize) {
+                continue;
+            }
+
+            BSONObj data = BSON("numRecords" << numRecords << "dataSize" << dataSize);
 
             auto& uri = it->first;
             LOGV2_DEBUG(22425,
@@ -177,13 +204,27 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
             _cursor->set_key(_cursor, key.Get());
             _cursor->set_value(_cursor, value.Get());
             invariantWTOK(_cursor->insert(_cursor));
+            written.push_back({&sizeInfo, numRecords, dataSize});
         }
         txnOpen.done();
         invariantWTOK(session->commit_transaction(session, nullptr));
-        buffer.clear();
+
+        for (auto&& entry : written) {
+            entry.sizeInfo->_persisted = true;
+            entry.sizeInfo->_persistedNumRecords = entry.numRecords;
+            entry.sizeInfo->_persistedDataSize = entry.dataSize;
+        }
+        numWritten += written.size();
+        buffer.erase(buffer.begin(), it);
     }
 
     auto micros = t.micros();
-    LOGV2_DEBUG(22426, 2, "WiredTigerSizeStorer flush took {micros} µs", "micros"_attr = micros);
+    LOGV2_DEBUG(22426,
+                2,
+                "WiredTigerSizeStorer flush wrote {numWritten} of {numEntries} entries in "
+                "{micros} µs",
+                "numWritten"_attr = numWritten,
+                "numEntries"_attr = numEntries,
+                "micros"_attr = micros);
 }
 }  // namespace mongo
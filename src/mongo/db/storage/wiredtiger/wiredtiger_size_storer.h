@@ -47,10 +47,12 @@ namespace mongo {
  * the URI serves as key and the value is a BSON document with `numRecords` and `dataSize` fields.
  * This buffering is neccessary to allow concurrent updates of size information without causing
  * write conflicts. The dirty size information is periodically stored written back to the table,
- * including on clean shutdown and/or catalog reload. Crashes or replica-set fail-overs may result
- * in size updates to be lost, so size information is only approximate. Reads use the buffer for
- * pending stores, or otherwise read directly from the WiredTiger table using a dedicated session
- * and cursor.
+ * including on clean shutdown and/or catalog reload. Only entries whose values changed since they
+ * were last read or written are rewritten, in transactions of bounded size so that a flush of
+ * many collections neither holds the cursor for long nor pins a large transaction in cache.
+ * Crashes or replica-set fail-overs may result in size updates to be lost, so size information is
+ * only approximate. Reads use the buffer for pending stores, or otherwise read directly from the
+ * WiredTiger table using a dedicated session and cursor.
  */
 class WiredTigerSizeStorer {
 public:
@@ -74,8 +76,17 @@ public:
     private:
         friend WiredTigerSizeStorer;
         AtomicWord<bool> _dirty;
+
+        // The values in the table as of the last load or flush, if any. Guarded by the size
+        // storer's _cursorMutex.
+        bool _persisted = false;
+        long long _persistedNumRecords = 0;
+        long long _persistedDataSize = 0;
     };
 
+    // The maximum number of entries written by one WiredTiger transaction during a flush.
+    static constexpr size_t kMaxEntriesPerFlushTransaction = 1000;
+
     WiredTigerSizeStorer(WT_CONNECTION* conn,
                          const std::string& storageUri,
                          const bool readOnly = false);
@@ -90,7 +101,8 @@ public:
     std::shared_ptr<SizeInfo> load(StringData uri) const;
 
     /**
-     * Writes all changes to the underlying table.
+     * Writes all changes to the underlying table. If 'syncToDisk' is true, the changes are durable
+     * once this returns.
      */
     void flush(bool syncToDisk);
 
@@ -347,5 +347,60 @@ TEST_F(SizeStorerUpdateTest, Basic) {
     ASSERT_EQUALS(getDataSize(), val);
 }
 
+TEST(WiredTigerSizeStorerTest, FlushWritesEntriesAcrossTransactions) {
+    WiredTigerHarnessHelper harnessHelper;
+    const std::string storerUri = WiredTigerKVEngine::kTableUriPrefix + "sizeStorer";
+    const size_t numEntries = WiredTigerSizeStorer::kMaxEntriesPerFlushTransaction * 2 + 1;
+
+    std::vector<std::shared_ptr<WiredTigerSizeStorer::SizeInfo>> infos;
+    {
+        WiredTigerSizeStorer ss(harnessHelper.conn(), storerUri);
+        for (size_t i = 0; i < numEntries; ++i) {
+            infos.push_back(std::make_shared<WiredTigerSizeStorer::SizeInfo>(i, i * 10));
+            ss.store("table:" + std::to_string(i), infos.back());
+        }
+        ss.flush(true);
+    }
+
+    WiredTigerSizeStorer ss(harnessHelper.conn(), storerUri);
+    for (size_t i = 0; i < numEntries; ++i) {
+        auto info = ss.load("table:" + std::to_string(i));
+        ASSERT_EQUALS(info->numRecords.load(), static_cast<long long>(i));
+        ASSERT_EQUALS(info->dataSize.load(), static_cast<long long>(i * 10));
+    }
+}
+
+TEST(WiredTigerSizeStorerTest, FlushSkipsUnchangedEntries) {
+    WiredTigerHarnessHelper harnessHelper;
+    const std::string storerUri = WiredTigerKVEngine::kTableUriPrefix + "sizeStorer";
+    WiredTigerSizeStorer ss(harnessHelper.conn(), storerUri);
+    WiredTigerSizeStorer other(harnessHelper.conn(), storerUri);
+
+    auto info = std::make_shared<WiredTigerSizeStorer::SizeInfo>(5, 50);
+    ss.store("table:a", info);
+    ss.flush(false);
+
+    // Overwrite the entry behind the first storer's back.
+    other.store("table:a", std::make_shared<WiredTigerSizeStorer::SizeInfo>(7, 70));
+    other.flush(false);
+
+    // The first storer's values have not changed since its last flush, so it writes nothing.
+    ss.store("table:a", info);
+    ss.flush(false);
+    ASSERT_EQUALS(WiredTigerSizeStorer(harnessHelper.conn(), storerUri)
+                      .load("table:a")
+                      ->numRecords.load(),
+                  7);
+
+    // Once they change, they are written again.
+    info->numRecords.fetchAndAdd(1);
+    ss.store("table:a", info);
+    ss.flush(false);
+    ASSERT_EQUALS(WiredTigerSizeStorer(harnessHelper.conn(), storerUri)
+                      .load("table:a")
+                      ->numRecords.load(),
+                  6);
+}
+
 }  // namespace
 }  // namespace mongo
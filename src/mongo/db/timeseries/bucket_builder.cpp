@@ -0,0 +1,244 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_builder.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+// Compares element values, ignoring field names.
+constexpr BSONElement::ComparisonRulesSet kValueOnly = 0;
+
+struct Column {
+    std::string name;
+    // The index of each measurement that has the field, in ascending order, and its value.
+    std::vector<std::pair<size_t, BSONElement>> values;
+    BSONElement min;
+    BSONElement max;
+    bool allDoubles = true;
+};
+
+void appendCompressedColumn(BSONObjBuilder* builder,
+                            StringData name,
+                            char tag,
+                            const std::string& compressed) {
+    std::string column;
+    column.reserve(compressed.size() + 1);
+    column.push_back(tag);
+    column.append(compressed);
+    builder->appendBinData(name, column.size(), BinDataType::bdtCustom, column.data());
+}
+
+// Throws unless 'measurement' has a Date in its time field and no field name appears twice, since a
+// bucket holds at most one value per field for each measurement.
+void validateMeasurement(const BucketSpec& spec, const BSONObj& measurement) {
+    const auto time = measurement[spec.timeField];
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Time-series measurements must have a Date in their '"
+                          << spec.timeField << "' field: " << measurement,
+            time.type() == BSONType::Date);
+
+    StringDataSet names;
+    for (auto&& elem : measurement) {
+        uassert(ErrorCodes::BadValue,
+                str::stream() << "Time-series measurements must not have duplicate field names, '"
+                              << elem.fieldNameStringData() << "' appears more than once in "
+                              << measurement,
+                names.insert(elem.fieldNameStringData()).second);
+    }
+}
+
+}  // namespace
+
+void BucketBuilder::add(const BSONObj& measurement) {
+    validateMeasurement(_spec, measurement);
+    _measurements.push_back(measurement.getOwned());
+}
+
+BSONObj BucketBuilder::finish(const OID& id) const {
+    std::vector<long long> times;
+    times.reserve(_measurements.size());
+    Date_t minTime = Date_t::max();
+    Date_t maxTime = Date_t::min();
+
+    std::vector<Column> columns;
+    StringMap<size_t> columnIndexes;
+    BSONElement meta;
+
+    for (size_t row = 0; row < _measurements.size(); ++row) {
+        for (auto&& elem : _measurements[row]) {
+            const auto name = elem.fieldNameStringData();
+            if (name == _spec.timeField) {
+                const Date_t time = elem.Date();
+                times.push_back(time.toMillisSinceEpoch());
+                minTime = std::min(minTime, time);
+                maxTime = std::max(maxTime, time);
+                continue;
+            }
+            if (_spec.metaField && name == *_spec.metaField) {
+                // Every measurement of a bucket has the same meta value.
+                meta = elem;
+                continue;
+            }
+
+            auto [it, inserted] = columnIndexes.emplace(name.toString(), columns.size());
+            if (inserted) {
+                columns.push_back({name.toString()});
+            }
+            auto& column = columns[it->second];
+            column.values.emplace_back(row, elem);
+            column.allDoubles = column.allDoubles && elem.type() == BSONType::NumberDouble;
+            if (column.min.eoo() || elem.woCompare(column.min, kValueOnly) < 0) {
+                column.min = elem;
+            }
+            if (column.max.eoo() || elem.woCompare(column.max, kValueOnly) > 0) {
+                column.max = elem;
+            }
+        }
+    }
+
+    BSONObjBuilder bucket;
+    bucket.append(kBucketIdFieldName, id);
+    {
+        BSONObjBuilder control(bucket.subobjStart(kBucketControlFieldName));
+        control.append(kControlVersionFieldName, kBucketVersion);
+        control.append(kControlCountFieldName, static_cast<int>(_measurements.size()));
+        {
+            BSONObjBuilder min(control.subobjStart(kControlMinFieldName));
+            if (!times.empty()) {
+                min.appendDate(_spec.timeField, minTime);
+            }
+            for (auto&& column : columns) {
+                min.appendAs(column.min, column.name);
+            }
+        }
+        {
+            BSONObjBuilder max(control.subobjStart(kControlMaxFieldName));
+            if (!times.empty()) {
+                max.appendDate(_spec.timeField, maxTime);
+            }
+            for (auto&& column : columns) {
+                max.appendAs(column.max, column.name);
+            }
+        }
+    }
+    if (!meta.eoo()) {
+        bucket.appendAs(meta, kBucketMetaFieldName);
+    }
+    {
+        BSONObjBuilder data(bucket.subobjStart(kBucketDataFieldName));
+        appendCompressedColumn(
+            &data, _spec.timeField, kTimestampColumnTag, compressTimestamps(times));
+        for (auto&& column : columns) {
+            if (column.allDoubles && column.values.size() == _measurements.size()) {
+                std::vector<double> doubles;
+                doubles.reserve(column.values.size());
+                for (auto&& [row, elem] : column.values) {
+                    doubles.push_back(elem.Double());
+                }
+                appendCompressedColumn(
+                    &data, column.name, kDoubleColumnTag, compressDoubles(doubles));
+            } else {
+                BSONObjBuilder sparse(data.subobjStart(column.name));
+                for (auto&& [row, elem] : column.values) {
+                    sparse.appendAs(elem, std::to_string(row));
+                }
+            }
+        }
+    }
+    return bucket.obj();
+}
+
+BucketGrouper::BucketGrouper(Options options) : _options(std::move(options)) {
+    invariant(_options.maxSpan > Seconds(0));
+    invariant(_options.maxCount > 0);
+}
+
+std::vector<BSONObj> BucketGrouper::insert(const BSONObj& measurement) {
+    // Validate before closing any bucket, so that the closed buckets are not lost when the
+    // measurement is rejected.
+    validateMeasurement(_options.spec, measurement);
+    const auto time = measurement[_options.spec.timeField];
+
+    BSONObj key;
+    if (_options.spec.metaField) {
+        if (auto meta = measurement[*_options.spec.metaField]; !meta.eoo()) {
+            BSONObjBuilder keyBuilder;
+            keyBuilder.appendAs(meta, "");
+            key = keyBuilder.obj();
+        }
+    }
+
+    const long long spanMillis = durationCount<Milliseconds>(_options.maxSpan);
+    const long long millis = time.Date().toMillisSinceEpoch();
+    // Round towards negative infinity so that windows before the epoch line up too.
+    const long long windowStart = (millis / spanMillis - (millis % spanMillis < 0 ? 1 : 0)) *
+        spanMillis;
+
+    std::vector<BSONObj> closed;
+    auto it = _openBuckets.find(key);
+    if (it != _openBuckets.end() &&
+        (it->second.windowStart.toMillisSinceEpoch() != windowStart ||
+         it->second.builder.count() >= _options.maxCount)) {
+        closed.push_back(it->second.builder.finish(OID::gen()));
+        _openBuckets.erase(it);
+        it = _openBuckets.end();
+    }
+    if (it == _openBuckets.end()) {
+        it = _openBuckets
+                 .emplace(key,
+                          OpenBucket{Date_t::fromMillisSinceEpoch(windowStart),
+                                     BucketBuilder(_options.spec)})
+                 .first;
+    }
+    it->second.builder.add(measurement);
+    return closed;
+}
+
+std::vector<BSONObj> BucketGrouper::closeAll() {
+    std::vector<BSONObj> closed;
+    closed.reserve(_openBuckets.size());
+    for (auto&& [key, openBucket] : _openBuckets) {
+        closed.push_back(openBucket.builder.finish(OID::gen()));
+    }
+    _openBuckets.clear();
+    return closed;
+}
+
+}  // namespace timeseries
+}  // namespace mongo
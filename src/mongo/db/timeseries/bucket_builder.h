@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/oid.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * Bucket documents group the measurements of one series (meta value) over a time window:
+ *
+ * {
+ *     _id: <ObjectId>,
+ *     control: {version: 1, count: <n>, min: {<field>: <min>, ...}, max: {<field>: <max>, ...}},
+ *     meta: <meta value, omitted when the measurements have none>,
+ *     data: {<timeField>: <compressed column>, <field>: <column>, ...}
+ * }
+ *
+ * A column holding a double for every measurement is stored as compressed BinData, as is the time
+ * column. Any other column is stored as an object mapping measurement indexes, as strings, to the
+ * values of the measurements that have the field.
+ */
+constexpr StringData kBucketIdFieldName = "_id"_sd;
+constexpr StringData kBucketControlFieldName = "control"_sd;
+constexpr StringData kBucketMetaFieldName = "meta"_sd;
+constexpr StringData kBucketDataFieldName = "data"_sd;
+constexpr StringData kControlVersionFieldName = "version"_sd;
+constexpr StringData kControlCountFieldName = "count"_sd;
+constexpr StringData kControlMinFieldName = "min"_sd;
+constexpr StringData kControlMaxFieldName = "max"_sd;
+
+constexpr int kBucketVersion = 1;
+
+// Compressed columns are BinData of subtype bdtCustom whose first byte identifies the encoding.
+constexpr char kTimestampColumnTag = 'T';
+constexpr char kDoubleColumnTag = 'D';
+
+/**
+ * Names the fields of a measurement that define its time and its series.
+ */
+struct BucketSpec {
+    std::string timeField;
+    boost::optional<std::string> metaField;
+};
+
+/**
+ * Accumulates the measurements of one bucket and produces the bucket document.
+ */
+class BucketBuilder {
+public:
+    explicit BucketBuilder(BucketSpec spec) : _spec(std::move(spec)) {}
+
+    /**
+     * Adds an owned copy of 'measurement' to the bucket. Throws if the measurement does not have
+     * a Date in its time field or has a field name more than once.
+     */
+    void add(const BSONObj& measurement);
+
+    size_t count() const {
+        return _measurements.size();
+    }
+
+    /**
+     * Returns the bucket document holding every measurement added so far.
+     */
+    BSONObj finish(const OID& id) const;
+
+private:
+    BucketSpec _spec;
+    std::vector<BSONObj> _measurements;
+};
+
+/**
+ * Groups a stream of measurements into buckets by meta value and time window. Each series has at
+ * most one open bucket; it is closed when a measurement for a different window arrives or when it
+ * reaches 'maxCount' measurements.
+ */
+class BucketGrouper {
+public:
+    struct Options {
+        BucketSpec spec;
+        Seconds maxSpan{3600};
+        size_t maxCount = 1000;
+    };
+
+    /**
+     * The options must have a positive 'maxSpan' and 'maxCount'.
+     */
+    explicit BucketGrouper(Options options);
+
+    /**
+     * Adds 'measurement' to the open bucket of its series and returns the buckets closed to make
+     * room for it, if any.
+     */
+    std::vector<BSONObj> insert(const BSONObj& measurement);
+
+    /**
+     * Closes every open bucket and returns the bucket documents.
+     */
+    std::vector<BSONObj> closeAll();
+
+    size_t numOpenBuckets() const {
+        return _openBuckets.size();
+    }
+
+    const Options& options() const {
+        return _options;
+    }
+
+private:
+    struct OpenBucket {
+        Date_t windowStart;
+        BucketBuilder builder;
+    };
+
+    Options _options;
+
+    // Keyed on {"": <meta value>}, or on the empty object for measurements without a meta value.
+    SimpleBSONObjUnorderedMap<OpenBucket> _openBuckets;
+};
+
+}  // namespace timeseries
+}  // namespace mongo
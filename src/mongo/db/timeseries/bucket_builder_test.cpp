@@ -0,0 +1,186 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/db/timeseries/bucket_builder.h"
+#include "mongo/db/timeseries/bucket_unpacker.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+const BucketSpec kSpec{"time", std::string("tags")};
+
+BSONObj makeMeasurement(long long millis, BSONObj fields, BSONObj tags = BSON("sensor" << 1)) {
+    BSONObjBuilder builder;
+    builder.appendDate("time", Date_t::fromMillisSinceEpoch(millis));
+    builder.append("tags", tags);
+    builder.appendElements(fields);
+    return builder.obj();
+}
+
+std::vector<BSONObj> unpackAll(const BSONObj& bucket) {
+    BucketUnpacker unpacker(kSpec);
+    unpacker.reset(bucket);
+    std::vector<BSONObj> measurements;
+    while (unpacker.hasNext()) {
+        measurements.push_back(unpacker.getNext());
+    }
+    return measurements;
+}
+
+TEST(BucketBuilderTest, RoundTripsMeasurements) {
+    std::vector<BSONObj> measurements{
+        makeMeasurement(1000, fromjson("{temp: 20.5, status: 'ok', nested: {a: 1}}")),
+        makeMeasurement(2000, fromjson("{temp: 21.0}")),
+        makeMeasurement(3000, fromjson("{temp: 21.5, status: 'warn', extra: [1, 2]}")),
+    };
+
+    BucketBuilder builder(kSpec);
+    for (auto&& measurement : measurements) {
+        builder.add(measurement);
+    }
+    ASSERT_EQ(3U, builder.count());
+
+    auto unpacked = unpackAll(builder.finish(OID::gen()));
+    ASSERT_EQ(measurements.size(), unpacked.size());
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(measurements[i], unpacked[i]);
+    }
+}
+
+TEST(BucketBuilderTest, ControlFieldsHoldCountAndRanges) {
+    BucketBuilder builder(kSpec);
+    builder.add(makeMeasurement(5000, fromjson("{temp: 3.0, status: 'b'}")));
+    builder.add(makeMeasurement(1000, fromjson("{temp: 7.0, status: 'a'}")));
+    auto bucket = builder.finish(OID::gen());
+
+    auto control = bucket[kBucketControlFieldName].Obj();
+    ASSERT_EQ(kBucketVersion, control[kControlVersionFieldName].numberInt());
+    ASSERT_EQ(2, control[kControlCountFieldName].numberInt());
+    ASSERT_BSONOBJ_EQ(BSON("time" << Date_t::fromMillisSinceEpoch(1000) << "temp" << 3.0
+                                  << "status"
+                                  << "a"),
+                      control[kControlMinFieldName].Obj());
+    ASSERT_BSONOBJ_EQ(BSON("time" << Date_t::fromMillisSinceEpoch(5000) << "temp" << 7.0
+                                  << "status"
+                                  << "b"),
+                      control[kControlMaxFieldName].Obj());
+    ASSERT_BSONOBJ_EQ(BSON("sensor" << 1), bucket[kBucketMetaFieldName].Obj());
+}
+
+TEST(BucketBuilderTest, DenseDoubleColumnsAreCompressed) {
+    BucketBuilder builder(kSpec);
+    for (int i = 0; i < 100; ++i) {
+        builder.add(makeMeasurement(i * 1000, BSON("temp" << 20.0 << "count" << i)));
+    }
+    auto data = builder.finish(OID::gen())[kBucketDataFieldName].Obj();
+    ASSERT_EQ(BSONType::BinData, data["time"].type());
+    ASSERT_EQ(BSONType::BinData, data["temp"].type());
+    // Integers are kept as they are so that their type round trips.
+    ASSERT_EQ(BSONType::Object, data["count"].type());
+}
+
+TEST(BucketBuilderTest, RejectsMeasurementWithoutTime) {
+    BucketBuilder builder(kSpec);
+    ASSERT_THROWS_CODE(builder.add(BSON("temp" << 1.0)), DBException, ErrorCodes::BadValue);
+    ASSERT_THROWS_CODE(
+        builder.add(BSON("time" << 1 << "temp" << 1.0)), DBException, ErrorCodes::BadValue);
+}
+
+TEST(BucketBuilderTest, RejectsDuplicateFieldNames) {
+    BucketBuilder builder(kSpec);
+    ASSERT_THROWS_CODE(builder.add(makeMeasurement(0, BSON("temp" << 1.0 << "temp" << 2.0))),
+                       DBException,
+                       ErrorCodes::BadValue);
+    ASSERT_THROWS_CODE(builder.add(makeMeasurement(0, BSON("time" << Date_t()))),
+                       DBException,
+                       ErrorCodes::BadValue);
+    ASSERT_THROWS_CODE(builder.add(makeMeasurement(0, BSON("tags" << 1))),
+                       DBException,
+                       ErrorCodes::BadValue);
+    ASSERT_EQ(0U, builder.count());
+}
+
+TEST(BucketUnpackerTest, RejectsMalformedBuckets) {
+    BucketUnpacker unpacker(kSpec);
+    ASSERT_THROWS_CODE(unpacker.reset(fromjson("{control: {version: 2}, data: {}}")),
+                       DBException,
+                       ErrorCodes::BadValue);
+    ASSERT_THROWS_CODE(unpacker.reset(fromjson("{control: {version: 1}, data: {}}")),
+                       DBException,
+                       ErrorCodes::BadValue);
+}
+
+TEST(BucketGrouperTest, GroupsBySeriesAndTimeWindow) {
+    BucketGrouper grouper({kSpec, Seconds(60), 1000});
+
+    ASSERT(grouper.insert(makeMeasurement(0, BSON("v" << 1.0), BSON("s" << 1))).empty());
+    ASSERT(grouper.insert(makeMeasurement(1000, BSON("v" << 2.0), BSON("s" << 2))).empty());
+    ASSERT(grouper.insert(makeMeasurement(59000, BSON("v" << 3.0), BSON("s" << 1))).empty());
+    ASSERT_EQ(2U, grouper.numOpenBuckets());
+
+    // A measurement in the next window closes the bucket of its own series only.
+    auto closed = grouper.insert(makeMeasurement(60000, BSON("v" << 4.0), BSON("s" << 1)));
+    ASSERT_EQ(1U, closed.size());
+    ASSERT_EQ(2, closed[0][kBucketControlFieldName].Obj()[kControlCountFieldName].numberInt());
+    ASSERT_BSONOBJ_EQ(BSON("s" << 1), closed[0][kBucketMetaFieldName].Obj());
+
+    auto remaining = grouper.closeAll();
+    ASSERT_EQ(2U, remaining.size());
+    ASSERT_EQ(0U, grouper.numOpenBuckets());
+}
+
+TEST(BucketGrouperTest, ClosesFullBuckets) {
+    BucketGrouper grouper({kSpec, Seconds(3600), 2});
+    ASSERT(grouper.insert(makeMeasurement(0, BSON("v" << 1.0))).empty());
+    ASSERT(grouper.insert(makeMeasurement(1, BSON("v" << 1.0))).empty());
+    auto closed = grouper.insert(makeMeasurement(2, BSON("v" << 1.0)));
+    ASSERT_EQ(1U, closed.size());
+    ASSERT_EQ(2U, unpackAll(closed[0]).size());
+}
+
+TEST(BucketGrouperTest, RejectedMeasurementDoesNotCloseBuckets) {
+    BucketGrouper grouper({kSpec, Seconds(3600), 1});
+    ASSERT(grouper.insert(makeMeasurement(0, BSON("v" << 1.0))).empty());
+    ASSERT_THROWS_CODE(grouper.insert(makeMeasurement(1, BSON("v" << 1.0 << "v" << 2.0))),
+                       DBException,
+                       ErrorCodes::BadValue);
+    auto closed = grouper.closeAll();
+    ASSERT_EQ(1U, closed.size());
+    ASSERT_EQ(1U, unpackAll(closed[0]).size());
+}
+
+}  // namespace
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,294 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+/**
+ * Appends values of up to 64 bits to a byte buffer, most significant bit first.
+ */
+class BitWriter {
+public:
+    void write(uint64_t value, int nBits) {
+        dassert(nBits >= 0 && nBits <= 64);
+        while (nBits > 0) {
+            if (_usedBits == 8) {
+                _buf.push_back(0);
+                _usedBits = 0;
+            }
+            const int room = 8 - _usedBits;
+            const int n = std::min(room, nBits);
+            const uint8_t chunk = (value >> (nBits - n)) & ((1u << n) - 1);
+            _buf.back() =
+                static_cast<char>(static_cast<uint8_t>(_buf.back()) | chunk << (room - n));
+            _usedBits += n;
+            nBits -= n;
+        }
+    }
+
+    std::string release() {
+        return std::move(_buf);
+    }
+
+private:
+    std::string _buf;
+    // Number of bits used in the last byte of '_buf'. Starts full so the first write allocates.
+    int _usedBits = 8;
+};
+
+class BitReader {
+public:
+    explicit BitReader(StringData data) : _data(data) {}
+
+    uint64_t read(int nBits) {
+        dassert(nBits >= 0 && nBits <= 64);
+        uint64_t result = 0;
+        while (nBits > 0) {
+            uassert(ErrorCodes::InvalidBSON, "Truncated time-series column", _pos < _data.size());
+            const int available = 8 - _bitInByte;
+            const int n = std::min(available, nBits);
+            const uint8_t byte = static_cast<uint8_t>(_data[_pos]);
+            const uint64_t chunk = (byte >> (available - n)) & ((1u << n) - 1);
+            result = (result << n) | chunk;
+            _bitInByte += n;
+            nBits -= n;
+            if (_bitInByte == 8) {
+                _bitInByte = 0;
+                ++_pos;
+            }
+        }
+        return result;
+    }
+
+private:
+    StringData _data;
+    size_t _pos = 0;
+    int _bitInByte = 0;
+};
+
+uint64_t zigZagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigZagDecode(uint64_t value) {
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsToDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Leading zero counts are stored in 5 bits.
+constexpr int kMaxLeadingZeros = 31;
+
+size_t readCount(BitReader* reader) {
+    return reader->read(32);
+}
+
+}  // namespace
+
+std::string compressTimestamps(const std::vector<long long>& millis) {
+    BitWriter writer;
+    writer.write(millis.size(), 32);
+    if (millis.empty()) {
+        return writer.release();
+    }
+
+    writer.write(static_cast<uint64_t>(millis[0]), 64);
+    int64_t prevDelta = 0;
+    for (size_t i = 1; i < millis.size(); ++i) {
+        // Use unsigned arithmetic so that extreme dates wrap instead of overflowing.
+        const auto delta = static_cast<int64_t>(static_cast<uint64_t>(millis[i]) -
+                                                static_cast<uint64_t>(millis[i - 1]));
+        const auto deltaOfDelta =
+            zigZagEncode(static_cast<int64_t>(static_cast<uint64_t>(delta) -
+                                              static_cast<uint64_t>(prevDelta)));
+        prevDelta = delta;
+
+        if (deltaOfDelta == 0) {
+            writer.write(0b0, 1);
+        } else if (deltaOfDelta < (1ull << 7)) {
+            writer.write(0b10, 2);
+            writer.write(deltaOfDelta, 7);
+        } else if (deltaOfDelta < (1ull << 9)) {
+            writer.write(0b110, 3);
+            writer.write(deltaOfDelta, 9);
+        } else if (deltaOfDelta < (1ull << 12)) {
+            writer.write(0b1110, 4);
+            writer.write(deltaOfDelta, 12);
+        } else {
+            writer.write(0b1111, 4);
+            writer.write(deltaOfDelta, 64);
+        }
+    }
+    return writer.release();
+}
+
+std::vector<long long> decompressTimestamps(StringData compressed) {
+    BitReader reader(compressed);
+    const size_t count = readCount(&reader);
+    std::vector<long long> millis;
+    if (count == 0) {
+        return millis;
+    }
+    // Every value takes at least one bit, which bounds the allocation for corrupt input.
+    uassert(ErrorCodes::InvalidBSON,
+            "Time-series timestamp column is shorter than its count",
+            count - 1 <= compressed.size() * 8);
+    millis.reserve(count);
+
+    uint64_t prev = reader.read(64);
+    millis.push_back(static_cast<long long>(prev));
+    uint64_t prevDelta = 0;
+    for (size_t i = 1; i < count; ++i) {
+        int width;
+        if (reader.read(1) == 0) {
+            width = 0;
+        } else if (reader.read(1) == 0) {
+            width = 7;
+        } else if (reader.read(1) == 0) {
+            width = 9;
+        } else if (reader.read(1) == 0) {
+            width = 12;
+        } else {
+            width = 64;
+        }
+        const uint64_t deltaOfDelta =
+            width == 0 ? 0 : static_cast<uint64_t>(zigZagDecode(reader.read(width)));
+        prevDelta += deltaOfDelta;
+        prev += prevDelta;
+        millis.push_back(static_cast<long long>(prev));
+    }
+    return millis;
+}
+
+std::string compressDoubles(const std::vector<double>& values) {
+    BitWriter writer;
+    writer.write(values.size(), 32);
+    if (values.empty()) {
+        return writer.release();
+    }
+
+    uint64_t prev = doubleBits(values[0]);
+    writer.write(prev, 64);
+    // The window of meaningful bits used by the previous value, or -1 if there is none yet.
+    int prevLeading = -1;
+    int prevTrailing = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+        const uint64_t bits = doubleBits(values[i]);
+        const uint64_t xored = bits ^ prev;
+        prev = bits;
+
+        if (xored == 0) {
+            writer.write(0b0, 1);
+            continue;
+        }
+        writer.write(0b1, 1);
+
+        const int leading = std::min(countLeadingZeros64(xored), kMaxLeadingZeros);
+        const int trailing = countTrailingZeros64(xored);
+        if (prevLeading >= 0 && leading >= prevLeading && trailing >= prevTrailing) {
+            // The meaningful bits fit in the previous window, so reuse it.
+            writer.write(0b0, 1);
+            writer.write(xored >> prevTrailing, 64 - prevLeading - prevTrailing);
+        } else {
+            const int meaningful = 64 - leading - trailing;
+            writer.write(0b1, 1);
+            writer.write(leading, 5);
+            writer.write(meaningful - 1, 6);
+            writer.write(xored >> trailing, meaningful);
+            prevLeading = leading;
+            prevTrailing = trailing;
+        }
+    }
+    return writer.release();
+}
+
+std::vector<double> decompressDoubles(StringData compressed) {
+    BitReader reader(compressed);
+    const size_t count = readCount(&reader);
+    std::vector<double> values;
+    if (count == 0) {
+        return values;
+    }
+    uassert(ErrorCodes::InvalidBSON,
+            "Time-series double column is shorter than its count",
+            count - 1 <= compressed.size() * 8);
+    values.reserve(count);
+
+    uint64_t prev = reader.read(64);
+    values.push_back(bitsToDouble(prev));
+    int prevLeading = -1;
+    int prevTrailing = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (reader.read(1) == 0) {
+            values.push_back(bitsToDouble(prev));
+            continue;
+        }
+
+        if (reader.read(1) == 0) {
+            uassert(ErrorCodes::InvalidBSON,
+                    "Time-series double column reuses a window before defining one",
+                    prevLeading >= 0);
+        } else {
+            prevLeading = reader.read(5);
+            const int meaningful = reader.read(6) + 1;
+            uassert(ErrorCodes::InvalidBSON,
+                    "Time-series double column has an invalid bit window",
+                    prevLeading + meaningful <= 64);
+            prevTrailing = 64 - prevLeading - meaningful;
+        }
+        const uint64_t xored = reader.read(64 - prevLeading - prevTrailing) << prevTrailing;
+        prev ^= xored;
+        values.push_back(bitsToDouble(prev));
+    }
+    return values;
+}
+
+}  // namespace timeseries
+}  // namespace mongo
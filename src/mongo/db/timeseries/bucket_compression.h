@@ -0,0 +1,57 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * Columnar encodings used for the 'data' fields of time-series buckets. Both encodings write a
+ * 32-bit value count followed by a bit stream, and decode back to the exact input.
+ *
+ * Timestamps are stored as delta-of-deltas: measurements taken at a regular interval cost a single
+ * bit each. Doubles are XOR-ed with their predecessor and only the meaningful bits of the result
+ * are stored, so slowly changing series compress to a few bits per value.
+ *
+ * The decoders throw a DBException with code InvalidBSON if the input is truncated or malformed.
+ */
+std::string compressTimestamps(const std::vector<long long>& millis);
+std::vector<long long> decompressTimestamps(StringData compressed);
+
+std::string compressDoubles(const std::vector<double>& values);
+std::vector<double> decompressDoubles(StringData compressed);
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+void assertTimestampsRoundTrip(const std::vector<long long>& millis) {
+    ASSERT(decompressTimestamps(compressTimestamps(millis)) == millis);
+}
+
+void assertDoublesRoundTrip(const std::vector<double>& values) {
+    auto decompressed = decompressDoubles(compressDoubles(values));
+    ASSERT_EQ(values.size(), decompressed.size());
+    // Compare bit patterns so that NaNs and signed zeros are checked too.
+    ASSERT_EQ(0, std::memcmp(values.data(), decompressed.data(), values.size() * sizeof(double)));
+}
+
+TEST(BucketCompressionTest, EmptyColumns) {
+    assertTimestampsRoundTrip({});
+    assertDoublesRoundTrip({});
+}
+
+TEST(BucketCompressionTest, RegularTimestampsTakeOneBitEach) {
+    std::vector<long long> millis;
+    for (int i = 0; i < 1000; ++i) {
+        millis.push_back(1577836800000LL + i * 1000);
+    }
+    auto compressed = compressTimestamps(millis);
+    // Count, first value, first delta, then one bit per remaining value.
+    ASSERT_LTE(compressed.size(), 4U + 8U + 3U + 1000U / 8 + 1);
+    assertTimestampsRoundTrip(millis);
+}
+
+TEST(BucketCompressionTest, IrregularAndExtremeTimestamps) {
+    assertTimestampsRoundTrip({0, 1, 3, 2, 1000, 999, 1000000000, -5});
+    assertTimestampsRoundTrip({std::numeric_limits<long long>::min(),
+                               std::numeric_limits<long long>::max(),
+                               0,
+                               std::numeric_limits<long long>::min()});
+}
+
+TEST(BucketCompressionTest, SlowlyChangingDoublesCompress) {
+    std::vector<double> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(20.0 + (i % 8) * 0.25);
+    }
+    ASSERT_LT(compressDoubles(values).size(), values.size() * sizeof(double) / 4);
+    assertDoublesRoundTrip(values);
+}
+
+TEST(BucketCompressionTest, SpecialDoubles) {
+    assertDoublesRoundTrip({0.0,
+                            -0.0,
+                            std::numeric_limits<double>::quiet_NaN(),
+                            std::numeric_limits<double>::infinity(),
+                            -std::numeric_limits<double>::infinity(),
+                            std::numeric_limits<double>::denorm_min(),
+                            std::numeric_limits<double>::max(),
+                            1.0,
+                            1.0});
+}
+
+TEST(BucketCompressionTest, TruncatedInputThrows) {
+    std::vector<double> values{1.5, 2.5, 3.5, 4.5};
+    auto compressed = compressDoubles(values);
+    ASSERT_THROWS_CODE(decompressDoubles(StringData(compressed).substr(0, compressed.size() - 2)),
+                       DBException,
+                       ErrorCodes::InvalidBSON);
+
+    auto timestamps = compressTimestamps({1, 100, 100000, 1});
+    ASSERT_THROWS_CODE(
+        decompressTimestamps(StringData(timestamps).substr(0, timestamps.size() - 3)),
+        DBException,
+        ErrorCodes::InvalidBSON);
+}
+
+}  // namespace
+}  // namespace timeseries
+}  // namespace mongo
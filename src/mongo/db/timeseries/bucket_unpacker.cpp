@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_unpacker.h"
+
+#include "mongo/base/parse_number.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+/**
+ * Returns the payload of a compressed column after checking its tag.
+ */
+StringData compressedColumnData(const BSONElement& elem, char tag) {
+    int len;
+    const char* data = elem.binData(len);
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Time-series bucket column '" << elem.fieldNameStringData()
+                          << "' has an unknown encoding",
+            elem.binDataType() == BinDataType::bdtCustom && len > 0 && data[0] == tag);
+    return StringData(data + 1, len - 1);
+}
+
+}  // namespace
+
+void BucketUnpacker::reset(BSONObj bucket) {
+    _bucket = bucket.getOwned();
+    _meta = _bucket[kBucketMetaFieldName];
+    _columns.clear();
+    _row = 0;
+
+    const auto control = _bucket[kBucketControlFieldName];
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Unsupported time-series bucket version: " << _bucket,
+            control.type() == BSONType::Object &&
+                control.Obj()[kControlVersionFieldName].numberInt() == kBucketVersion);
+
+    const auto data = _bucket[kBucketDataFieldName];
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Time-series bucket has no data: " << _bucket,
+            data.type() == BSONType::Object);
+
+    const auto timeColumn = data.Obj()[_spec.timeField];
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Time-series bucket has no '" << _spec.timeField
+                          << "' column: " << _bucket,
+            timeColumn.type() == BSONType::BinData);
+    _times = decompressTimestamps(compressedColumnData(timeColumn, kTimestampColumnTag));
+
+    for (auto&& elem : data.Obj()) {
+        if (elem.fieldNameStringData() == _spec.timeField) {
+            continue;
+        }
+
+        Column column;
+        column.name = elem.fieldName();
+        if (elem.type() == BSONType::BinData) {
+            column.isCompressed = true;
+            column.doubles = decompressDoubles(compressedColumnData(elem, kDoubleColumnTag));
+            uassert(ErrorCodes::BadValue,
+                    str::stream() << "Time-series bucket column '" << column.name
+                                  << "' does not have one value per measurement",
+                    column.doubles.size() == _times.size());
+        } else {
+            uassert(ErrorCodes::BadValue,
+                    str::stream() << "Time-series bucket column '" << column.name
+                                  << "' must be an object or BinData",
+                    elem.type() == BSONType::Object);
+            column.it = BSONObjIterator(elem.Obj());
+            _advance(&column, 0);
+        }
+        _columns.push_back(std::move(column));
+    }
+}
+
+void BucketUnpacker::_advance(Column* column, size_t minRow) {
+    if (!column->it.more()) {
+        column->next = BSONElement();
+        return;
+    }
+    column->next = column->it.next();
+
+    size_t row;
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "Time-series bucket column '" << column->name
+                          << "' has an invalid measurement index '"
+                          << column->next.fieldNameStringData() << "'",
+            NumberParser().base(10)(column->next.fieldNameStringData(), &row).isOK() &&
+                row >= minRow && row < _times.size());
+    column->nextRow = row;
+}
+
+BSONObj BucketUnpacker::getNext() {
+    invariant(hasNext());
+
+    BSONObjBuilder measurement;
+    measurement.appendDate(_spec.timeField, Date_t::fromMillisSinceEpoch(_times[_row]));
+    if (_spec.metaField && !_meta.eoo()) {
+        measurement.appendAs(_meta, *_spec.metaField);
+    }
+    for (auto&& column : _columns) {
+        if (column.isCompressed) {
+            measurement.append(column.name, column.doubles[_row]);
+        } else if (!column.next.eoo() && column.nextRow == _row) {
+            measurement.appendAs(column.next, column.name);
+            _advance(&column, _row + 1);
+        }
+    }
+
+    ++_row;
+    return measurement.obj();
+}
+
+}  // namespace timeseries
+}  // namespace mongo
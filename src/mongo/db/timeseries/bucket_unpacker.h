@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/timeseries/bucket_builder.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * Reconstructs the measurements of a bucket document produced by BucketBuilder, in the order in
+ * which they were added. Each measurement has its time field first, then its meta field, then the
+ * remaining fields in the order the bucket first saw them.
+ */
+class BucketUnpacker {
+public:
+    explicit BucketUnpacker(BucketSpec spec) : _spec(std::move(spec)) {}
+
+    /**
+     * Starts unpacking 'bucket'. Throws if the bucket is malformed.
+     */
+    void reset(BSONObj bucket);
+
+    bool hasNext() const {
+        return _row < _times.size();
+    }
+
+    BSONObj getNext();
+
+    const BucketSpec& spec() const {
+        return _spec;
+    }
+
+private:
+    struct Column {
+        std::string name;
+        // Set for compressed columns, which have a value for every measurement.
+        std::vector<double> doubles;
+        bool isCompressed = false;
+        // For uncompressed columns, the position of the next value not yet returned.
+        BSONObjIterator it{BSONObj()};
+        BSONElement next;
+        size_t nextRow = 0;
+    };
+
+    /**
+     * Moves an uncompressed column to its next value, which must belong to a measurement at or
+     * after 'minRow'.
+     */
+    void _advance(Column* column, size_t minRow);
+
+    BucketSpec _spec;
+    BSONObj _bucket;
+    BSONElement _meta;
+    std::vector<long long> _times;
+    std::vector<Column> _columns;
+    size_t _row = 0;
+};
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -70,8 +70,268 @@ std::string extractKeyStringInternal(const BSONObj& shardKeyValue, Ordering orde
     return {ks.getBuffer(), ks.getSize()};
 }
 
+/**
+ * Returns the first eight bytes of "keyString" as a big-endian integer, padded with zeros, so that
+ * comparing the prefixes of two key strings orders them like comparing the strings, except for
+ * ties.
+ */
+uint64_t keyStringPrefix(StringData keyString) {
+    uint64_t prefix = 0;
+    for (size_t i = 0; i < sizeof(prefix); ++i) {
+        prefix <<= 8;
+        if (i < keyString.size()) {
+            prefix |= static_cast<unsigned char>(keyString[i]);
+        }
+    }
+    return prefix;
+}
+
+/**
+ * Checks that the chunk with max key string "maxKeyString" in "chunkMap" starts where the chunk
+ * before it ends and ends where the chunk after it starts, or at MinKey and MaxKey if it is the
+ * first or the last chunk.
+ */
+void checkChunkIsContiguous(const ChunkMap& chunkMap, StringData maxKeyString) {
+    const auto it = chunkMap.lowerBound(maxKeyString);
+    invariant(it != chunkMap.end());
+
+    const auto checkAdjacent = [](const ChunkInfo& left, const ChunkInfo& right) {
+        if (SimpleBSONObjComparator::kInstance.evaluate(left.getMax() == right.getMin())) {
+            return;
+        }
+        const bool isGap =
+            SimpleBSONObjComparator::kInstance.evaluate(left.getMax() < right.getMin());
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << (isGap ? "Gap" : "Overlap")
+                                << " exists in the routing table between chunks "
+                                << left.getRange().toString() << " and "
+                                << right.getRange().toString());
+    };
+
+    if (it == chunkMap.begin()) {
+        checkAllElementsAreOfType(MinKey, (*it)->getMin());
+    } else {
+        checkAdjacent(**std::prev(it), **it);
+    }
+
+    const auto next = std::next(it);
+    if (next == chunkMap.end()) {
+        checkAllElementsAreOfType(MaxKey, (*it)->getMax());
+    } else {
+        checkAdjacent(**it, **next);
+    }
+}
+
+/**
+ * Returns the first of the positions [0, count) for which "isPast" is true, or count if there is
+ * none. "isPast" must be false for a prefix of the positions and true for the rest.
+ */
+template <typename IsPastFn>
+size_t findFirstPast(size_t count, IsPastFn isPast) {
+    size_t first = 0;
+    while (count > 0) {
+        const size_t step = count / 2;
+        if (isPast(first + step)) {
+            count = step;
+        } else {
+            first += step + 1;
+            count -= step + 1;
+        }
+    }
+    return first;
+}
+
 }  // namespace
 
+StringData ChunkMap::Segment::maxKeyStringAt(size_t index) const {
+    const size_t begin = index == 0 ? 0 : maxKeyStringEnds[index - 1];
+    return {maxKeyStrings.data() + begin, maxKeyStringEnds[index] - begin};
+}
+
+bool ChunkMap::Segment::isPast(size_t index,
+                               uint64_t prefix,
+                               StringData keyString,
+                               bool inclusive) const {
+    // The full key string is only read if the prefixes do not already decide it
+    if (maxKeyPrefixes[index] != prefix) {
+        return maxKeyPrefixes[index] > prefix;
+    }
+    const int cmp = maxKeyStringAt(index).compare(keyString);
+    return cmp > 0 || (inclusive && cmp == 0);
+}
+
+size_t ChunkMap::Segment::search(uint64_t prefix, StringData keyString, bool inclusive) const {
+    return findFirstPast(chunks.size(),
+                         [&](size_t index) { return isPast(index, prefix, keyString, inclusive); });
+}
+
+void ChunkMap::Segment::append(StringData maxKeyString,
+                               std::shared_ptr<ChunkInfo> chunk,
+                               uint32_t shardIndex) {
+    chunks.push_back(std::move(chunk));
+    maxKeyPrefixes.push_back(keyStringPrefix(maxKeyString));
+    maxKeyStrings.append(maxKeyString.rawData(), maxKeyString.size());
+    maxKeyStringEnds.push_back(maxKeyStrings.size());
+    shardIndexes.push_back(shardIndex);
+}
+
+ChunkMap::const_iterator ChunkMap::upperBound(StringData keyString) const {
+    return _find(keyString, false);
+}
+
+ChunkMap::const_iterator ChunkMap::lowerBound(StringData keyString) const {
+    return _find(keyString, true);
+}
+
+boost::optional<size_t> ChunkMap::findShardIndex(const ShardId& shardId) const {
+    const auto it = _shardIndexByShardId.find(shardId);
+    if (it == _shardIndexByShardId.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+size_t ChunkMap::numChunksOnShard(const ShardId& shardId) const {
+    const auto shardIndex = findShardIndex(shardId);
+    return shardIndex ? _numChunksByShard[*shardIndex] : 0;
+}
+
+ChunkMap ChunkMap::makeUpdated(const ChunkInfoMap& replaced, const ChunkInfoMap& updated) const {
+    ChunkMap result;
+    result._segments.reserve(_segments.size() + updated.size() / kMaxChunksPerSegment + 1);
+    result._segmentMaxKeyPrefixes.reserve(result._segments.capacity());
+    result._shards = _shards;
+    result._shardIndexByShardId = _shardIndexByShardId;
+    result._numChunksByShard = _numChunksByShard;
+
+    for (const auto& [maxKeyString, chunk] : replaced) {
+        --result._numChunksByShard[*findShardIndex(chunk->getShardIdAt(boost::none))];
+    }
+
+    auto replacedIt = replaced.begin();
+    auto updatedIt = updated.begin();
+    const auto appendUpdatedChunk = [&] {
+        const auto shardIndex = result._internShard(updatedIt->second->getShardIdAt(boost::none));
+        ++result._numChunksByShard[shardIndex];
+        result._appendChunk(updatedIt->first, updatedIt->second, shardIndex);
+        ++updatedIt;
+    };
+
+    for (size_t segmentIndex = 0; segmentIndex < _segments.size(); ++segmentIndex) {
+        const auto& segment = *_segments[segmentIndex];
+        const auto lastMaxKeyString = segment.maxKeyStringAt(segment.chunks.size() - 1);
+        const bool isLastSegment = segmentIndex + 1 == _segments.size();
+        const auto fallsInSegment = [&](StringData maxKeyString) {
+            return isLastSegment || maxKeyString <= lastMaxKeyString;
+        };
+
+        // Small segments which follow a rebuilt one are merged into it, so that repeated updates
+        // to the same range do not fragment the table.
+        const bool isChanged =
+            (replacedIt != replaced.end() && fallsInSegment(replacedIt->first)) ||
+            (updatedIt != updated.end() && fallsInSegment(updatedIt->first));
+        const bool isMergeable =
+            result._openSegment && segment.chunks.size() < kMaxChunksPerSegment / 4;
+        if (!isChanged && !isMergeable) {
+            result._appendSegment(_segments[segmentIndex]);
+            continue;
+        }
+
+        for (size_t i = 0; i < segment.chunks.size(); ++i) {
+            const auto maxKeyString = segment.maxKeyStringAt(i);
+            while (updatedIt != updated.end() && StringData(updatedIt->first) < maxKeyString) {
+                appendUpdatedChunk();
+            }
+            if (replacedIt != replaced.end() && StringData(replacedIt->first) == maxKeyString) {
+                ++replacedIt;
+                continue;
+            }
+            result._appendChunk(maxKeyString, segment.chunks[i], segment.shardIndexes[i]);
+        }
+        while (updatedIt != updated.end() && fallsInSegment(updatedIt->first)) {
+            appendUpdatedChunk();
+        }
+    }
+
+    // Only reached by the chunks of a table which had none before
+    while (updatedIt != updated.end()) {
+        appendUpdatedChunk();
+    }
+    invariant(replacedIt == replaced.end());
+
+    result._closeSegment();
+    return result;
+}
+
+ChunkMap::const_iterator ChunkMap::_find(StringData keyString, bool inclusive) const {
+    const auto prefix = keyStringPrefix(keyString);
+
+    // The position is in the first segment whose last max key string is past it
+    const size_t segmentIndex = findFirstPast(_segments.size(), [&](size_t index) {
+        if (_segmentMaxKeyPrefixes[index] != prefix) {
+            return _segmentMaxKeyPrefixes[index] > prefix;
+        }
+        const auto& segment = *_segments[index];
+        return segment.isPast(segment.chunks.size() - 1, prefix, keyString, inclusive);
+    });
+    if (segmentIndex == _segments.size()) {
+        return end();
+    }
+
+    const auto indexInSegment = _segments[segmentIndex]->search(prefix, keyString, inclusive);
+    return {&_segments, segmentIndex, indexInSegment};
+}
+
+void ChunkMap::_appendSegment(std::shared_ptr<const Segment> segment) {
+    _closeSegment();
+    invariant(empty() || segment->maxKeyStringAt(0).compare(_lastMaxKeyString()) > 0);
+
+    _size += segment->chunks.size();
+    _segmentMaxKeyPrefixes.push_back(segment->maxKeyPrefixes.back());
+    _segments.push_back(std::move(segment));
+}
+
+void ChunkMap::_appendChunk(StringData maxKeyString,
+                            std::shared_ptr<ChunkInfo> chunk,
+                            uint32_t shardIndex) {
+    invariant(empty() || maxKeyString.compare(_lastMaxKeyString()) > 0);
+
+    if (!_openSegment) {
+        _openSegment = std::make_shared<Segment>();
+    }
+    _openSegment->append(maxKeyString, std::move(chunk), shardIndex);
+    ++_size;
+
+    if (_openSegment->chunks.size() == kMaxChunksPerSegment) {
+        _closeSegment();
+    }
+}
+
+void ChunkMap::_closeSegment() {
+    if (!_openSegment) {
+        return;
+    }
+
+    _segmentMaxKeyPrefixes.push_back(_openSegment->maxKeyPrefixes.back());
+    _segments.push_back(std::move(_openSegment));
+    _openSegment.reset();
+}
+
+StringData ChunkMap::_lastMaxKeyString() const {
+    const auto& segment = _openSegment ? *_openSegment : *_segments.back();
+    return segment.maxKeyStringAt(segment.chunks.size() - 1);
+}
+
+uint32_t ChunkMap::_internShard(const ShardId& shardId) {
+    auto it = _shardIndexByShardId.find(shardId);
+    if (it == _shardIndexByShardId.end()) {
+        it = _shardIndexByShardId.emplace(shardId, _shards.size()).first;
+        _shards.push_back(shardId);
+        _numChunksByShard.push_back(0);
+    }
+    return it->second;
+}
+
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch)
     : shardVersion(0, 0, epoch) {}
 
@@ -80,8 +340,9 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
                                          KeyPattern shardKeyPattern,
                                          std::unique_ptr<CollatorInterface> defaultCollator,
                                          bool unique,
-                                         ChunkInfoMap chunkMap,
-                                         ChunkVersion collectionVersion)
+                                         ChunkMap chunkMap,
+                                         ChunkVersion collectionVersion,
+                                         boost::optional<ShardVersionMap> shardVersions)
     : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
       _nss(std::move(nss)),
       _uuid(uuid),
@@ -91,7 +352,7 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
       _collectionVersion(collectionVersion),
-      _shardVersions(_constructShardVersionMap()) {}
+      _shardVersions(shardVersions ? std::move(*shardVersions) : _constructShardVersionMap()) {}
 
 void RoutingTableHistory::setShardStale(const ShardId& shardId) {
     if (gEnableFinerGrainedCatalogCacheRefresh) {
@@ -122,26 +383,26 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
         }
     }
 
-    const auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
+    const auto it = _rt->_findChunkAfter(shardKey);
     uassert(ErrorCodes::ShardKeyNotFound,
             str::stream() << "Cannot target single shard using key " << shardKey
                           << " for namespace " << getns(),
-            it != _rt->getChunkMap().end() && it->second->containsKey(shardKey));
+            it != _rt->getChunkMap().end() && (*it)->containsKey(shardKey));
 
-    return Chunk(*(it->second), _clusterTime);
+    return Chunk(**it, _clusterTime);
 }
 
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
 
-    const auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
+    const auto it = _rt->_findChunkAfter(shardKey);
     if (it == _rt->getChunkMap().end())
         return false;
 
-    invariant(it->second->containsKey(shardKey));
+    invariant((*it)->containsKey(shardKey));
 
-    return it->second->getShardIdAt(_clusterTime) == shardId;
+    return (*it)->getShardIdAt(_clusterTime) == shardId;
 }
 
 void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
@@ -209,43 +470,71 @@ void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
     // For now, we satisfy that assumption by adding a shard with no matches rather than returning
     // an empty set of shards.
     if (shardIds->empty()) {
-        shardIds->insert(_rt->getChunkMap().begin()->second->getShardIdAt(_clusterTime));
+        shardIds->insert((*_rt->getChunkMap().begin())->getShardIdAt(_clusterTime));
     }
 }
 
 void ChunkManager::getShardIdsForRange(const BSONObj& min,
                                        const BSONObj& max,
                                        std::set<ShardId>* shardIds) const {
+    const auto& chunkMap = _rt->getChunkMap();
     const auto bounds = _rt->overlappingRanges(min, max, true);
+
+    if (_clusterTime) {
+        for (auto it = bounds.first; it != bounds.second; ++it) {
+            shardIds->insert((*it)->getShardIdAt(_clusterTime));
+        }
+        return;
+    }
+
+    // The current owners of the chunks are interned, so a shard is only added the first time one
+    // of its chunks is found, without comparing shard ids.
+    std::vector<bool> shardsSeen(chunkMap.numShards(), false);
     for (auto it = bounds.first; it != bounds.second; ++it) {
-        shardIds->insert(it->second->getShardIdAt(_clusterTime));
+        const auto shardIndex = chunkMap.shardIndexAt(it);
+        if (shardsSeen[shardIndex]) {
+            continue;
+        }
+        shardsSeen[shardIndex] = true;
+        shardIds->insert(chunkMap.shardIdForIndex(shardIndex));
 
         // No need to iterate through the rest of the ranges, because we already know we need to use
         // all shards. However, this optimization does not apply when we are reading from a snapshot
         // because _shardVersions contains shards with chunks and is built based on the last
         // refresh. Therefore, it is possible for _shardVersions to have fewer entries if a shard
         // no longer owns chunks when it used to at _clusterTime.
-        if (!_clusterTime && shardIds->size() == _rt->_shardVersions.size()) {
+        if (shardIds->size() == _rt->_shardVersions.size()) {
             break;
         }
     }
 }
 
 bool ChunkManager::rangeOverlapsShard(const ChunkRange& range, const ShardId& shardId) const {
+    const auto& chunkMap = _rt->getChunkMap();
     const auto bounds = _rt->overlappingRanges(range.getMin(), range.getMax(), false);
-    const auto it = std::find_if(bounds.first, bounds.second, [this, &shardId](const auto& scr) {
-        return scr.second->getShardIdAt(_clusterTime) == shardId;
-    });
 
-    return it != bounds.second;
+    if (_clusterTime) {
+        return std::any_of(bounds.first, bounds.second, [this, &shardId](const auto& chunk) {
+            return chunk->getShardIdAt(_clusterTime) == shardId;
+        });
+    }
+
+    const auto shardIndex = chunkMap.findShardIndex(shardId);
+    if (!shardIndex) {
+        return false;
+    }
+    for (auto it = bounds.first; it != bounds.second; ++it) {
+        if (chunkMap.shardIndexAt(it) == *shardIndex) {
+            return true;
+        }
+    }
+    return false;
 }
 
 ChunkManager::ConstRangeOfChunks ChunkManager::getNextChunkOnShard(const BSONObj& shardKey,
                                                                    const ShardId& shardId) const {
-    for (auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
-         it != _rt->getChunkMap().end();
-         ++it) {
-        const auto& chunk = it->second;
+    for (auto it = _rt->_findChunkAfter(shardKey); it != _rt->getChunkMap().end(); ++it) {
+        const auto& chunk = *it;
         if (chunk->getShardIdAt(_clusterTime) == shardId) {
             const auto begin = it;
             const auto end = ++it;
@@ -272,7 +561,7 @@ int RoutingTableHistory::getNShardsOwningChunks() const {
     return _shardVersions.size();
 }
 
-std::pair<ChunkInfoMap::const_iterator, ChunkInfoMap::const_iterator>
+std::pair<ChunkMap::const_iterator, ChunkMap::const_iterator>
 RoutingTableHistory::overlappingRanges(const BSONObj& min,
                                        const BSONObj& max,
                                        bool isMaxInclusive) const {
@@ -288,10 +577,10 @@ RoutingTableHistory::overlappingRanges(const BSONObj& min,
         invariant(maxHasFullShardKey);
     }
 
-    const auto itMin = _chunkMap.upper_bound(_extractKeyString(min));
+    const auto itMin = _findChunkAfter(min);
     const auto itMax = [&]() {
-        auto it = isMaxInclusive ? _chunkMap.upper_bound(_extractKeyString(max))
-                                 : _chunkMap.lower_bound(_extractKeyString(max));
+        auto it = isMaxInclusive ? _findChunkAfter(max)
+                                 : _chunkMap.lowerBound(_extractKeyString(max));
         return it == _chunkMap.end() ? it : ++it;
     }();
 
@@ -463,7 +752,7 @@ std::string RoutingTableHistory::toString() const {
 
     sb << "Chunks:\n";
     for (const auto& chunk : _chunkMap) {
-        sb << "\t" << chunk.second->toString() << '\n';
+        sb << "\t" << chunk->toString() << '\n';
     }
 
     sb << "Shard versions:\n";
@@ -474,17 +763,54 @@ std::string RoutingTableHistory::toString() const {
     return sb.str();
 }
 
+boost::optional<ShardVersionMap> RoutingTableHistory::_makeUpdatedShardVersionMap(
+    const ChunkMap& chunkMap,
+    const std::vector<std::shared_ptr<ChunkInfo>>& removedChunks,
+    const std::vector<std::shared_ptr<ChunkInfo>>& addedChunks) const {
+    const OID& epoch = _collectionVersion.epoch();
+
+    ShardVersionMap shardVersions;
+    for (const auto& [shardId, targetingInfo] : _shardVersions) {
+        if (chunkMap.numChunksOnShard(shardId) > 0) {
+            shardVersions.emplace(shardId, epoch).first->second.shardVersion =
+                targetingInfo.shardVersion;
+        }
+    }
+
+    for (const auto& chunk : addedChunks) {
+        const auto& shardId = chunk->getShardIdAt(boost::none);
+        auto it = shardVersions.find(shardId);
+        if (it == shardVersions.end()) {
+            it = shardVersions.emplace(shardId, epoch).first;
+        }
+        if (chunk->getLastmod() > it->second.shardVersion) {
+            it->second.shardVersion = chunk->getLastmod();
+        }
+    }
+
+    // A shard which lost the chunk with its max version without getting a newer one has its
+    // version recomputed from all of its chunks
+    for (const auto& chunk : removedChunks) {
+        const auto it = shardVersions.find(chunk->getShardIdAt(boost::none));
+        if (it != shardVersions.end() && it->second.shardVersion == chunk->getLastmod()) {
+            return boost::none;
+        }
+    }
+
+    return shardVersions;
+}
+
 ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
     const OID& epoch = _collectionVersion.epoch();
 
     ShardVersionMap shardVersions;
-    ChunkInfoMap::const_iterator current = _chunkMap.cbegin();
+    ChunkMap::const_iterator current = _chunkMap.begin();
 
     boost::optional<BSONObj> firstMin = boost::none;
     boost::optional<BSONObj> lastMax = boost::none;
 
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = current->second;
+    while (current != _chunkMap.end()) {
+        const auto& firstChunkInRange = *current;
         const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
 
         // Tracks the max shard version for the shard on which the current range will reside
@@ -497,11 +823,9 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
 
         current =
             std::find_if(current,
-                         _chunkMap.cend(),
+                         _chunkMap.end(),
                          [&currentRangeShardId,
-                          &maxShardVersion](const ChunkInfoMap::value_type& chunkMapEntry) {
-                             const auto& currentChunk = chunkMapEntry.second;
-
+                          &maxShardVersion](const std::shared_ptr<ChunkInfo>& currentChunk) {
                              if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
                                  return true;
 
@@ -514,22 +838,21 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap() const {
         const auto rangeLast = std::prev(current);
 
         const auto& rangeMin = firstChunkInRange->getMin();
-        const auto& rangeMax = rangeLast->second->getMax();
+        const auto& rangeMax = (*rangeLast)->getMax();
 
         // Check the continuity of the chunks map
         if (lastMax && !SimpleBSONObjComparator::kInstance.evaluate(*lastMax == rangeMin)) {
+            const auto& lastChunk = *_chunkMap.lowerBound(_extractKeyString(*lastMax));
             if (SimpleBSONObjComparator::kInstance.evaluate(*lastMax < rangeMin))
                 uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream()
-                              << "Gap exists in the routing table between chunks "
-                              << _chunkMap.at(_extractKeyString(*lastMax))->getRange().toString()
-                              << " and " << rangeLast->second->getRange().toString());
+                          str::stream() << "Gap exists in the routing table between chunks "
+                                        << lastChunk->getRange().toString() << " and "
+                                        << (*rangeLast)->getRange().toString());
             else
                 uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream()
-                              << "Overlap exists in the routing table between chunks "
-                              << _chunkMap.at(_extractKeyString(*lastMax))->getRange().toString()
-                              << " and " << rangeLast->second->getRange().toString());
+                          str::stream() << "Overlap exists in the routing table between chunks "
+                                        << lastChunk->getRange().toString() << " and "
+                                        << (*rangeLast)->getRange().toString());
         }
 
         if (!firstMin)
@@ -558,6 +881,17 @@ std::string RoutingTableHistory::_extractKeyString(const BSONObj& shardKeyValue)
     return extractKeyStringInternal(shardKeyValue, _shardKeyOrdering);
 }
 
+ChunkMap::const_iterator RoutingTableHistory::_findChunkAfter(const BSONObj& shardKeyValue) const {
+    // Appending the elements one by one ignores their field names, which produces the same key
+    // string as extractKeyStringInternal() without building a copy of the key.
+    KeyString::Builder ks(KeyString::Version::V1, _shardKeyOrdering);
+    for (const auto& elem : shardKeyValue) {
+        ks.appendBSONElement(elem);
+    }
+    ks.appendDiscriminator(KeyString::Discriminator::kInclusive);
+    return _chunkMap.upperBound({ks.getBuffer(), ks.getSize()});
+}
+
 std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
     NamespaceString nss,
     boost::optional<UUID> uuid,
@@ -572,7 +906,8 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
                                std::move(defaultCollator),
                                std::move(unique),
                                {},
-                               {0, 0, epoch})
+                               {0, 0, epoch},
+                               boost::none)
         .makeUpdated(chunks);
 }
 
@@ -580,7 +915,13 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const std::vector<ChunkType>& changedChunks) {
 
     const auto startingCollectionVersion = getVersion();
-    auto chunkMap = _chunkMap;
+
+    // The changes are applied to a map which only holds the existing chunks they touch, that is,
+    // for each change, the chunks whose max falls in (min, max] and the first one whose max is past
+    // max, which are all the update algorithm below looks at. The touched chunks are then replaced
+    // by the contents of that map in a new table, which shares everything else with this one.
+    ChunkInfoMap touchedChunks;
+    ChunkInfoMap chunkMap;
 
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
@@ -600,6 +941,17 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         const auto chunkMinKeyString = _extractKeyString(chunk.getMin());
         const auto chunkMaxKeyString = _extractKeyString(chunk.getMax());
 
+        const auto lastTouched = _chunkMap.upperBound(chunkMaxKeyString);
+        for (auto it = _chunkMap.upperBound(chunkMinKeyString); it != _chunkMap.end(); ++it) {
+            auto maxKeyString = _chunkMap.maxKeyStringAt(it).toString();
+            if (touchedChunks.emplace(maxKeyString, *it).second) {
+                chunkMap.emplace(std::move(maxKeyString), *it);
+            }
+            if (it == lastTouched) {
+                break;
+            }
+        }
+
         // Returns the first chunk with a max key that is > min - implies that the chunk overlaps
         // min
         const auto low = chunkMap.upper_bound(chunkMinKeyString);
@@ -628,6 +980,8 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
             auto bytesInReplacedChunk =
                 chunkBeingReplacedBySplit->getWritesTracker()->getBytesWritten();
             newChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
+            newChunk->getWritesTracker()->addSampledKeysFrom(
+                *chunkBeingReplacedBySplit->getWritesTracker(), chunk.getMin(), chunk.getMax());
         }
 
         // Erase all chunks from the map, which overlap the chunk we got from the persistent store
@@ -648,14 +1002,41 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         return shared_from_this();
     }
 
+    auto newChunkMap = _chunkMap.makeUpdated(touchedChunks, chunkMap);
+
+    // Unless the table is being built from scratch, only the chunks which changed need to be
+    // checked for continuity, and only the versions of the shards which owned them can change.
+    boost::optional<ShardVersionMap> shardVersions;
+    if (!_chunkMap.empty()) {
+        std::vector<std::shared_ptr<ChunkInfo>> removedChunks;
+        for (const auto& [maxKeyString, chunk] : touchedChunks) {
+            const auto it = chunkMap.find(maxKeyString);
+            if (it == chunkMap.end() || it->second != chunk) {
+                removedChunks.push_back(chunk);
+            }
+        }
+
+        std::vector<std::shared_ptr<ChunkInfo>> addedChunks;
+        for (const auto& [maxKeyString, chunk] : chunkMap) {
+            const auto it = touchedChunks.find(maxKeyString);
+            if (it == touchedChunks.end() || it->second != chunk) {
+                checkChunkIsContiguous(newChunkMap, maxKeyString);
+                addedChunks.push_back(chunk);
+            }
+        }
+
+        shardVersions = _makeUpdatedShardVersionMap(newChunkMap, removedChunks, addedChunks);
+    }
+
     return std::shared_ptr<RoutingTableHistory>(
         new RoutingTableHistory(_nss,
                                 _uuid,
                                 KeyPattern(getShardKeyPattern().getKeyPattern()),
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
-                                std::move(chunkMap),
-                                collectionVersion));
+                                std::move(newChunkMap),
+                                collectionVersion,
+                                std::move(shardVersions)));
 }
 
 }  // namespace mongo
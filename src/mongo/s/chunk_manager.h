@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <map>
 #include <set>
 #include <string>
@@ -52,6 +53,229 @@ class ChunkManager;
 // Ordered map from the max for each chunk to an entry describing the chunk
 using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
 
+/**
+ * Immutable routing table for a single collection, ordered by the KeyString of each chunk's max
+ * key.
+ *
+ * The chunks are stored in segments of consecutive chunks. Within a segment, the max keys are
+ * stored back to back in a single buffer, alongside an array with the first eight bytes of each of
+ * them, so that a lookup is a binary search over contiguous arrays which only reads a full key when
+ * two prefixes are equal. The current owner of each chunk is interned into a small integer, which
+ * lets callers compare and collect shards without touching strings.
+ *
+ * Segments are immutable and shared between the versions of a routing table, so an update only
+ * copies the list of segments and rebuilds the segments holding the chunks it changes.
+ */
+class ChunkMap {
+    struct Segment {
+        StringData maxKeyStringAt(size_t index) const;
+
+        /**
+         * Returns whether the max key string at "index" is greater than "keyString", or also equal
+         * to it if "inclusive" is true. "prefix" is the prefix of "keyString".
+         */
+        bool isPast(size_t index, uint64_t prefix, StringData keyString, bool inclusive) const;
+
+        /**
+         * Returns the index of the first chunk whose max key string is past "keyString", as
+         * defined by isPast(), or the number of chunks if there is none.
+         */
+        size_t search(uint64_t prefix, StringData keyString, bool inclusive) const;
+
+        void append(StringData maxKeyString, std::shared_ptr<ChunkInfo> chunk, uint32_t shardIndex);
+
+        std::vector<std::shared_ptr<ChunkInfo>> chunks;
+
+        // Big-endian, zero padded first eight bytes of each max key string
+        std::vector<uint64_t> maxKeyPrefixes;
+
+        // The max key strings, back to back, and the offset at which each of them ends
+        std::string maxKeyStrings;
+        std::vector<size_t> maxKeyStringEnds;
+
+        // Index in the table's shards of the current owner of each chunk
+        std::vector<uint32_t> shardIndexes;
+    };
+
+    using SegmentVector = std::vector<std::shared_ptr<const Segment>>;
+
+public:
+    // Number of chunks at which a segment being built is closed and a new one is started
+    static constexpr size_t kMaxChunksPerSegment = 1024;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::shared_ptr<ChunkInfo>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return _segment()->chunks[_indexInSegment];
+        }
+        pointer operator->() const {
+            return &**this;
+        }
+
+        const_iterator& operator++() {
+            if (++_indexInSegment == _segment()->chunks.size()) {
+                ++_segmentIndex;
+                _indexInSegment = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+        const_iterator& operator--() {
+            if (_indexInSegment == 0) {
+                --_segmentIndex;
+                _indexInSegment = _segment()->chunks.size();
+            }
+            --_indexInSegment;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            auto result = *this;
+            --*this;
+            return result;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _segmentIndex == other._segmentIndex && _indexInSegment == other._indexInSegment;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkMap;
+
+        const_iterator(const SegmentVector* segments, size_t segmentIndex, size_t indexInSegment)
+            : _segments(segments), _segmentIndex(segmentIndex), _indexInSegment(indexInSegment) {}
+
+        const Segment* _segment() const {
+            return (*_segments)[_segmentIndex].get();
+        }
+
+        const SegmentVector* _segments = nullptr;
+        size_t _segmentIndex = 0;
+        size_t _indexInSegment = 0;
+    };
+
+    const_iterator begin() const {
+        return {&_segments, 0, 0};
+    }
+
+    const_iterator end() const {
+        return {&_segments, _segments.size(), 0};
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns the first chunk whose max key string sorts after (upperBound) or not before
+     * (lowerBound) "keyString", or end() if there is none.
+     */
+    const_iterator upperBound(StringData keyString) const;
+    const_iterator lowerBound(StringData keyString) const;
+
+    StringData maxKeyStringAt(const_iterator it) const {
+        return it._segment()->maxKeyStringAt(it._indexInSegment);
+    }
+
+    /**
+     * Returns the interned index of the current owner of the chunk at "it", which is less than
+     * numShards().
+     */
+    size_t shardIndexAt(const_iterator it) const {
+        return it._segment()->shardIndexes[it._indexInSegment];
+    }
+
+    /**
+     * Returns the interned index of "shardId", or boost::none if it has never owned any chunks in
+     * this table or the ones it was updated from.
+     */
+    boost::optional<size_t> findShardIndex(const ShardId& shardId) const;
+
+    const ShardId& shardIdForIndex(size_t shardIndex) const {
+        return _shards[shardIndex];
+    }
+
+    /**
+     * Returns the number of interned shards, including the ones which no longer own any chunks.
+     */
+    size_t numShards() const {
+        return _shards.size();
+    }
+
+    size_t numChunksOnShard(const ShardId& shardId) const;
+
+    /**
+     * Returns a table in which the chunks of "replaced", which must all be in this table, are
+     * replaced by the chunks of "updated". Both maps are keyed by max key string. The segments
+     * which hold none of the replaced chunks and into which none of the updated ones fall are
+     * shared with this table.
+     */
+    ChunkMap makeUpdated(const ChunkInfoMap& replaced, const ChunkInfoMap& updated) const;
+
+private:
+    /**
+     * Returns the position of the first chunk whose max key string is greater than "keyString",
+     * or also equal to it if "inclusive" is true.
+     */
+    const_iterator _find(StringData keyString, bool inclusive) const;
+
+    /**
+     * Adds a shared segment, or a single chunk owned by the shard at "shardIndex", at the end of
+     * the table while it is being built. The max key strings must be appended in strictly
+     * ascending order. Neither updates the number of chunks on each shard.
+     */
+    void _appendSegment(std::shared_ptr<const Segment> segment);
+    void _appendChunk(StringData maxKeyString,
+                      std::shared_ptr<ChunkInfo> chunk,
+                      uint32_t shardIndex);
+
+    /**
+     * Closes the segment being built by _appendChunk, if any.
+     */
+    void _closeSegment();
+
+    StringData _lastMaxKeyString() const;
+
+    /**
+     * Returns the index of "shardId", interning it if it is not yet in the table.
+     */
+    uint32_t _internShard(const ShardId& shardId);
+
+    SegmentVector _segments;
+
+    // Prefix of the last max key string of each segment
+    std::vector<uint64_t> _segmentMaxKeyPrefixes;
+
+    size_t _size = 0;
+
+    // Segment being built by _appendChunk, which is not yet in '_segments'
+    std::shared_ptr<Segment> _openSegment;
+
+    std::vector<ShardId> _shards;
+    std::map<ShardId, uint32_t> _shardIndexByShardId;
+
+    // Number of chunks owned by each of '_shards'
+    std::vector<size_t> _numChunksByShard;
+};
+
 struct ShardVersionTargetingInfo {
     // Indicates whether the shard is stale and thus needs a catalog cache refresh. Is false by
     // default.
@@ -101,7 +325,8 @@ public:
      * in "changedChunks".
      *
      * The changes in "changedChunks" must be sorted in ascending order by chunk version, and adhere
-     * to the requirements of the routing table update algorithm.
+     * to the requirements of the routing table update algorithm. The new instance shares the
+     * segments of the routing table which the changes do not touch with this one.
      */
     std::shared_ptr<RoutingTableHistory> makeUpdated(const std::vector<ChunkType>& changedChunks);
 
@@ -157,7 +382,7 @@ public:
      */
     ChunkVersion getVersionForLogging(const ShardId& shardId) const;
 
-    const ChunkInfoMap& getChunkMap() const {
+    const ChunkMap& getChunkMap() const {
         return _chunkMap;
     }
 
@@ -186,7 +411,7 @@ public:
         return _uuid;
     }
 
-    std::pair<ChunkInfoMap::const_iterator, ChunkInfoMap::const_iterator> overlappingRanges(
+    std::pair<ChunkMap::const_iterator, ChunkMap::const_iterator> overlappingRanges(
         const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
 
 
@@ -196,18 +421,35 @@ private:
                         KeyPattern shardKeyPattern,
                         std::unique_ptr<CollatorInterface> defaultCollator,
                         bool unique,
-                        ChunkInfoMap chunkMap,
-                        ChunkVersion collectionVersion);
+                        ChunkMap chunkMap,
+                        ChunkVersion collectionVersion,
+                        boost::optional<ShardVersionMap> shardVersions);
 
     /**
      * Does a single pass over the chunkMap and constructs the ShardVersionMap object.
      */
     ShardVersionMap _constructShardVersionMap() const;
 
+    /**
+     * Derives the ShardVersionMap of "chunkMap", which was updated from this routing table by
+     * replacing "removedChunks" with "addedChunks", from the one of this routing table. Returns
+     * boost::none if it has to be constructed from all the chunks instead.
+     */
+    boost::optional<ShardVersionMap> _makeUpdatedShardVersionMap(
+        const ChunkMap& chunkMap,
+        const std::vector<std::shared_ptr<ChunkInfo>>& removedChunks,
+        const std::vector<std::shared_ptr<ChunkInfo>>& addedChunks) const;
+
     ChunkVersion _getVersion(const ShardId& shardName, bool throwOnStaleShard) const;
 
     std::string _extractKeyString(const BSONObj& shardKeyValue) const;
 
+    /**
+     * Returns the first chunk whose max is greater than "shardKeyValue". Unlike looking up the
+     * result of _extractKeyString(), encodes the key on the stack.
+     */
+    ChunkMap::const_iterator _findChunkAfter(const BSONObj& shardKeyValue) const;
+
     // The shard versioning mechanism hinges on keeping track of the number of times we reload
     // ChunkManagers.
     const unsigned long long _sequenceNumber;
@@ -229,9 +471,9 @@ private:
     // Whether the sharding key is unique
     const bool _unique;
 
-    // Map from the max for each chunk to an entry describing the chunk. The union of all chunks'
-    // ranges must cover the complete space from [MinKey, MaxKey).
-    const ChunkInfoMap _chunkMap;
+    // Table ordered by the max for each chunk of entries describing the chunks. The union of all
+    // chunks' ranges must cover the complete space from [MinKey, MaxKey).
+    const ChunkMap _chunkMap;
 
     // Max version across all chunks
     const ChunkVersion _collectionVersion;
@@ -253,7 +495,7 @@ public:
     class ConstChunkIterator {
     public:
         ConstChunkIterator() = default;
-        explicit ConstChunkIterator(ChunkInfoMap::const_iterator iter,
+        explicit ConstChunkIterator(ChunkMap::const_iterator iter,
                                     boost::optional<Timestamp> clusterTime)
             : _iter{std::move(iter)}, _clusterTime{std::move(clusterTime)} {}
 
@@ -271,11 +513,11 @@ public:
             return !(*this == other);
         }
         const Chunk operator*() const {
-            return Chunk{*_iter->second, _clusterTime};
+            return Chunk{**_iter, _clusterTime};
         }
 
     private:
-        ChunkInfoMap::const_iterator _iter;
+        ChunkMap::const_iterator _iter;
         boost::optional<Timestamp> _clusterTime;
     };
 
@@ -335,8 +577,8 @@ public:
     }
 
     ConstRangeOfChunks chunks() const {
-        return {ConstChunkIterator{_rt->getChunkMap().cbegin(), _clusterTime},
-                ConstChunkIterator{_rt->getChunkMap().cend(), _clusterTime}};
+        return {ConstChunkIterator{_rt->getChunkMap().begin(), _clusterTime},
+                ConstChunkIterator{_rt->getChunkMap().end(), _clusterTime}};
     }
 
     int numChunks() const {
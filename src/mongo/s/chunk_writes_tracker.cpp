@@ -31,17 +31,162 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include "mongo/s/chunk_writes_tracker.h"
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/platform/random.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
+namespace {
+
+thread_local PseudoRandom threadPrng{SecureRandom().nextInt64()};
+
+/**
+ * Subtracts 'decrement' from 'word', stopping at zero rather than wrapping around, since the
+ * documents deleted from a chunk may have been inserted before they could be counted.
+ */
+void saturatingSubtract(AtomicWord<unsigned long long>* word, unsigned long long decrement) {
+    auto current = word->load();
+    while (!word->compareAndSwap(&current, current - std::min(current, decrement))) {
+    }
+}
+
+}  // namespace
 
 uint64_t ChunkWritesTracker::clearBytesWritten() {
     return _bytesWritten.swap(0);
 }
 
+ChunkWritesTracker::LoadStatistics ChunkWritesTracker::takeLoadStatistics() {
+    LoadStatistics stats;
+    stats.numReads = _numReads.swap(0);
+    stats.numWrites = _numWrites.swap(0);
+    stats.bytesRead = _bytesReadForLoad.swap(0);
+    stats.bytesWritten = _bytesWrittenForLoad.swap(0);
+    return stats;
+}
+
+void ChunkWritesTracker::addInsertedKey(const BSONObj& shardKey, uint64_t size) {
+    _bytesInserted.fetchAndAdd(size);
+    const uint64_t numKeysBefore = _numKeysInserted.fetchAndAdd(1);
+
+    // Reservoir sampling: once the sample is full, the n-th key replaces a random sampled key with
+    // probability kMaxSampledKeys / n, which is decided before taking the mutex so that most
+    // inserts into a busy chunk do not take it
+    size_t replaceIndex = numKeysBefore;
+    if (numKeysBefore >= kMaxSampledKeys) {
+        replaceIndex = threadPrng.nextInt64(numKeysBefore + 1);
+        if (replaceIndex >= kMaxSampledKeys) {
+            return;
+        }
+    }
+
+    auto ownedKey = shardKey.getOwned();
+    stdx::lock_guard<Latch> lk(_sampleMutex);
+    if (_sampledKeys.size() < kMaxSampledKeys) {
+        _sampledKeys.push_back(std::move(ownedKey));
+    } else {
+        _sampledKeys[replaceIndex] = std::move(ownedKey);
+    }
+}
+
+void ChunkWritesTracker::removeDeletedKey(const BSONObj& shardKey, uint64_t size) {
+    saturatingSubtract(&_bytesInserted, size);
+    saturatingSubtract(&_numKeysInserted, 1);
+
+    stdx::lock_guard<Latch> lk(_sampleMutex);
+    auto it = std::find_if(_sampledKeys.begin(), _sampledKeys.end(), [&](const BSONObj& key) {
+        return key.woCompare(shardKey) == 0;
+    });
+    if (it != _sampledKeys.end()) {
+        // The sample is in no particular order, so the last key can take the deleted one's place
+        *it = std::move(_sampledKeys.back());
+        _sampledKeys.pop_back();
+    }
+}
+
+void ChunkWritesTracker::clearSampledKeys() {
+    stdx::lock_guard<Latch> lk(_sampleMutex);
+    _sampledKeys.clear();
+    _numKeysInserted.store(0);
+    _bytesInserted.store(0);
+}
+
+void ChunkWritesTracker::addSampledKeysFrom(const ChunkWritesTracker& other,
+                                            const BSONObj& min,
+                                            const BSONObj& max) {
+    std::vector<BSONObj> keysInRange;
+    size_t numOtherKeys;
+    {
+        stdx::lock_guard<Latch> lk(other._sampleMutex);
+        numOtherKeys = other._sampledKeys.size();
+        for (const auto& key : other._sampledKeys) {
+            if (key.woCompare(min) >= 0 && key.woCompare(max) < 0) {
+                keysInRange.push_back(key);
+            }
+        }
+    }
+
+    if (keysInRange.empty()) {
+        return;
+    }
+
+    // The sampled keys in the range stand for the same share of the other chunk's inserts
+    const double share = static_cast<double>(keysInRange.size()) / numOtherKeys;
+    _numKeysInserted.fetchAndAdd(
+        std::max<uint64_t>(other._numKeysInserted.load() * share, keysInRange.size()));
+    _bytesInserted.fetchAndAdd(other._bytesInserted.load() * share);
+
+    stdx::lock_guard<Latch> lk(_sampleMutex);
+    for (auto& key : keysInRange) {
+        if (_sampledKeys.size() == kMaxSampledKeys) {
+            break;
+        }
+        _sampledKeys.push_back(std::move(key));
+    }
+}
+
+std::vector<BSONObj> ChunkWritesTracker::getSampledKeys() const {
+    std::vector<BSONObj> keys;
+    {
+        stdx::lock_guard<Latch> lk(_sampleMutex);
+        keys = _sampledKeys;
+    }
+
+    std::sort(keys.begin(), keys.end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+    return keys;
+}
+
+boost::optional<std::vector<BSONObj>> ChunkWritesTracker::getSampledSplitPoints(
+    uint64_t maxChunkSizeBytes) const {
+    const uint64_t bytesInserted = _bytesInserted.load();
+    const auto keys = getSampledKeys();
+    if (bytesInserted < maxChunkSizeBytes || keys.size() < kMinSampledKeysForSplit) {
+        return boost::none;
+    }
+
+    // Like splitVector, aim for chunks of half the maximum size
+    const uint64_t numParts = std::min<uint64_t>(
+        bytesInserted / std::max<uint64_t>(maxChunkSizeBytes / 2, 1), keys.size());
+
+    std::vector<BSONObj> splitPoints;
+    for (uint64_t i = 1; i < numParts; i++) {
+        const auto& key = keys[i * keys.size() / numParts];
+
+        // All the documents with the same key must stay in the same chunk
+        if (!splitPoints.empty() && key.woCompare(splitPoints.back()) == 0) {
+            continue;
+        }
+        splitPoints.push_back(key);
+    }
+
+    return splitPoints;
+}
+
 bool ChunkWritesTracker::shouldSplit(uint64_t maxChunkSize) {
     if (_isLockedForSplitting) {
         return false;
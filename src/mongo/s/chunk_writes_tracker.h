@@ -29,6 +29,10 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 
@@ -36,12 +40,30 @@ namespace mongo {
 
 class ChunkWritesTracker {
 public:
+    /**
+     * The operations run against the chunk since its load statistics were last taken. The
+     * balancer uses them to even out the load across shards.
+     */
+    struct LoadStatistics {
+        uint64_t numReads{0};
+        uint64_t numWrites{0};
+        uint64_t bytesRead{0};
+        uint64_t bytesWritten{0};
+    };
+
     /**
      * A factor that determines when a chunk should be split. We should split once data *
      * kSplitTestFactor > chunkSize (approximately).
      */
     static constexpr uint64_t kSplitTestFactor = 5;
 
+    /**
+     * The number of shard keys of inserted documents kept in the sample, and the least number of
+     * them needed to compute split points from it.
+     */
+    static constexpr size_t kMaxSampledKeys = 128;
+    static constexpr size_t kMinSampledKeysForSplit = 16;
+
     /**
      * Add more bytes written to the chunk.
      */
@@ -62,6 +84,66 @@ public:
      */
     uint64_t clearBytesWritten();
 
+    /**
+     * Counts reads and writes against the chunk for its load statistics. Unlike the bytes
+     * written tracked for splitting, these are not carried over to the chunks a split produces.
+     */
+    void addReads(uint64_t numReads, uint64_t bytesRead) {
+        _numReads.fetchAndAdd(numReads);
+        _bytesReadForLoad.fetchAndAdd(bytesRead);
+    }
+
+    void addWrite(uint64_t bytesWritten) {
+        _numWrites.fetchAndAdd(1);
+        _bytesWrittenForLoad.fetchAndAdd(bytesWritten);
+    }
+
+    /**
+     * Returns the load statistics accumulated since the previous call and resets them to zero.
+     */
+    LoadStatistics takeLoadStatistics();
+
+    /**
+     * Counts a document of 'size' bytes inserted into the chunk and keeps its shard key in a
+     * uniform sample of the keys of the inserted documents.
+     */
+    void addInsertedKey(const BSONObj& shardKey, uint64_t size);
+
+    /**
+     * Uncounts a document of 'size' bytes deleted from the chunk, including by the range deleter
+     * after the chunk moved away, and drops one occurrence of its shard key from the sample.
+     */
+    void removeDeletedKey(const BSONObj& shardKey, uint64_t size);
+
+    /**
+     * Forgets the sampled keys and the documents they stand for, for instance when the sample no
+     * longer agrees with the chunk's data.
+     */
+    void clearSampledKeys();
+
+    /**
+     * Adds the sampled keys of 'other', which fall in [min, max), to this tracker together with
+     * their share of the documents and bytes inserted into 'other'. Used to carry the sample over
+     * to the chunk, which replaces the one tracked by 'other'.
+     */
+    void addSampledKeysFrom(const ChunkWritesTracker& other,
+                            const BSONObj& min,
+                            const BSONObj& max);
+
+    /**
+     * Returns the sampled keys in ascending order.
+     */
+    std::vector<BSONObj> getSampledKeys() const;
+
+    /**
+     * Returns split points, which divide the documents inserted into the chunk into parts of about
+     * half of 'maxChunkSizeBytes' as estimated from the sample, or boost::none if the inserted
+     * documents are less than 'maxChunkSizeBytes' or too few keys are sampled. Documents which
+     * were not counted, such as those inserted before the tracker was created, are not taken into
+     * account.
+     */
+    boost::optional<std::vector<BSONObj>> getSampledSplitPoints(uint64_t maxChunkSizeBytes) const;
+
     /**
      * Returns whether or not this chunk is ready to be split based on the
      * maximum allowable size of a chunk.
@@ -86,6 +168,31 @@ private:
      */
     AtomicWord<unsigned long long> _bytesWritten{0};
 
+    /**
+     * The load statistics accumulated since they were last taken.
+     */
+    AtomicWord<unsigned long long> _numReads{0};
+    AtomicWord<unsigned long long> _numWrites{0};
+    AtomicWord<unsigned long long> _bytesReadForLoad{0};
+    AtomicWord<unsigned long long> _bytesWrittenForLoad{0};
+
+    /**
+     * The number and total size of the documents inserted into the chunk, which _sampledKeys is a
+     * uniform sample of.
+     */
+    AtomicWord<unsigned long long> _numKeysInserted{0};
+    AtomicWord<unsigned long long> _bytesInserted{0};
+
+    /**
+     * Protects _sampledKeys.
+     */
+    mutable Mutex _sampleMutex = MONGO_MAKE_LATCH("ChunkWritesTracker::_sampleMutex");
+
+    /**
+     * At most kMaxSampledKeys shard keys of inserted documents, in no particular order.
+     */
+    std::vector<BSONObj> _sampledKeys;
+
     /**
      * Protects _splitState when starting a split.
      */
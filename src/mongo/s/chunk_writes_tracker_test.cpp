@@ -64,6 +64,160 @@ TEST(ChunkWritesTrackerTest, ClearBytesWrittenReturnsBytesWrittenBeforeClearing)
     ASSERT_EQ(previousBytesWritten, bytesToAdd);
 }
 
+TEST(ChunkWritesTrackerTest, TakeLoadStatisticsReturnsOperationsSinceThePreviousCall) {
+    ChunkWritesTracker wt;
+    wt.addReads(3, 300);
+    wt.addWrite(40);
+    wt.addWrite(60);
+
+    auto stats = wt.takeLoadStatistics();
+    ASSERT_EQ(stats.numReads, 3ull);
+    ASSERT_EQ(stats.bytesRead, 300ull);
+    ASSERT_EQ(stats.numWrites, 2ull);
+    ASSERT_EQ(stats.bytesWritten, 100ull);
+
+    wt.addReads(1, 10);
+    stats = wt.takeLoadStatistics();
+    ASSERT_EQ(stats.numReads, 1ull);
+    ASSERT_EQ(stats.bytesRead, 10ull);
+    ASSERT_EQ(stats.numWrites, 0ull);
+    ASSERT_EQ(stats.bytesWritten, 0ull);
+}
+
+TEST(ChunkWritesTrackerTest, LoadStatisticsAreIndependentOfBytesWrittenForSplitting) {
+    ChunkWritesTracker wt;
+    wt.addBytesWritten(50);
+    wt.addWrite(20);
+    ASSERT_EQ(wt.getBytesWritten(), 50ull);
+    ASSERT_EQ(wt.takeLoadStatistics().bytesWritten, 20ull);
+    ASSERT_EQ(wt.getBytesWritten(), 50ull);
+}
+
+TEST(ChunkWritesTrackerTest, SampledKeysAreBoundedAndSorted) {
+    ChunkWritesTracker wt;
+    for (int i = 0; i < 1000; i++) {
+        wt.addInsertedKey(BSON("x" << (i * 7) % 1000), 10);
+    }
+
+    const auto keys = wt.getSampledKeys();
+    ASSERT_EQ(keys.size(), ChunkWritesTracker::kMaxSampledKeys);
+    for (size_t i = 1; i < keys.size(); i++) {
+        ASSERT_LTE(keys[i - 1]["x"].numberInt(), keys[i]["x"].numberInt());
+    }
+}
+
+TEST(ChunkWritesTrackerTest, SampledSplitPointsRequireMaxChunkSizeOfInsertedDocuments) {
+    ChunkWritesTracker wt;
+    for (int i = 0; i < 100; i++) {
+        wt.addInsertedKey(BSON("x" << i), 100);
+    }
+    ASSERT_FALSE(wt.getSampledSplitPoints(10001));
+    ASSERT_TRUE(wt.getSampledSplitPoints(10000));
+}
+
+TEST(ChunkWritesTrackerTest, SampledSplitPointsRequireEnoughSampledKeys) {
+    ChunkWritesTracker wt;
+    for (size_t i = 0; i < ChunkWritesTracker::kMinSampledKeysForSplit - 1; i++) {
+        wt.addInsertedKey(BSON("x" << static_cast<int>(i)), 1000);
+    }
+    ASSERT_FALSE(wt.getSampledSplitPoints(100));
+}
+
+TEST(ChunkWritesTrackerTest, SampledSplitPointsDivideInsertedDocumentsIntoHalfMaxChunkSize) {
+    ChunkWritesTracker wt;
+    for (int i = 0; i < 10000; i++) {
+        wt.addInsertedKey(BSON("x" << i), 1000);
+    }
+
+    // 10MB were inserted, so splitting into parts of 1MB needs 9 split points, which are close to
+    // every 1000th key, give or take the error of the sample
+    auto splitPoints = wt.getSampledSplitPoints(2 * 1000 * 1000);
+    ASSERT_TRUE(splitPoints);
+    ASSERT_EQ(splitPoints->size(), 9U);
+    for (size_t i = 0; i < splitPoints->size(); i++) {
+        const int x = (*splitPoints)[i]["x"].numberInt();
+        ASSERT_GT(x, static_cast<int>(i + 1) * 1000 - 2500);
+        ASSERT_LT(x, static_cast<int>(i + 1) * 1000 + 2500);
+        if (i > 0) {
+            ASSERT_GT(x, (*splitPoints)[i - 1]["x"].numberInt());
+        }
+    }
+}
+
+TEST(ChunkWritesTrackerTest, SampledSplitPointsDoNotRepeatKeys) {
+    ChunkWritesTracker wt;
+    for (int i = 0; i < 1000; i++) {
+        wt.addInsertedKey(BSON("x" << 1), 1000);
+    }
+
+    auto splitPoints = wt.getSampledSplitPoints(10000);
+    ASSERT_TRUE(splitPoints);
+    ASSERT_EQ(splitPoints->size(), 1U);
+    ASSERT_BSONOBJ_EQ((*splitPoints)[0], BSON("x" << 1));
+}
+
+TEST(ChunkWritesTrackerTest, RemoveDeletedKeyUncountsTheDocumentAndDropsItsKey) {
+    ChunkWritesTracker wt;
+    for (int i = 0; i < 100; i++) {
+        wt.addInsertedKey(BSON("x" << i), 100);
+    }
+    ASSERT_TRUE(wt.getSampledSplitPoints(10000));
+
+    wt.removeDeletedKey(BSON("x" << 0), 100);
+    ASSERT_FALSE(wt.getSampledSplitPoints(10000));
+    ASSERT_TRUE(wt.getSampledSplitPoints(9900));
+
+    const auto keys = wt.getSampledKeys();
+    ASSERT_EQ(keys.size(), 99U);
+    ASSERT_BSONOBJ_EQ(keys.front(), BSON("x" << 1));
+}
+
+TEST(ChunkWritesTrackerTest, RemoveDeletedKeyDoesNotUncountMoreThanWasInserted) {
+    ChunkWritesTracker wt;
+    wt.removeDeletedKey(BSON("x" << 0), 100);
+    for (int i = 0; i < 100; i++) {
+        wt.addInsertedKey(BSON("x" << i), 100);
+    }
+    ASSERT_FALSE(wt.getSampledSplitPoints(10001));
+    ASSERT_TRUE(wt.getSampledSplitPoints(10000));
+}
+
+TEST(ChunkWritesTrackerTest, ClearSampledKeysForgetsTheSample) {
+    ChunkWritesTracker wt;
+    for (int i = 0; i < 100; i++) {
+        wt.addInsertedKey(BSON("x" << i), 100);
+    }
+
+    wt.clearSampledKeys();
+    ASSERT_TRUE(wt.getSampledKeys().empty());
+    for (int i = 0; i < 50; i++) {
+        wt.addInsertedKey(BSON("x" << i), 100);
+    }
+    ASSERT_FALSE(wt.getSampledSplitPoints(10000));
+}
+
+TEST(ChunkWritesTrackerTest, AddSampledKeysFromTakesTheKeysInRangeAndTheirShare) {
+    ChunkWritesTracker parent;
+    for (int i = 0; i < 100; i++) {
+        parent.addInsertedKey(BSON("x" << i), 100);
+    }
+
+    ChunkWritesTracker child;
+    child.addSampledKeysFrom(parent, BSON("x" << 0), BSON("x" << 50));
+
+    const auto keys = child.getSampledKeys();
+    ASSERT_EQ(keys.size(), 50U);
+    ASSERT_BSONOBJ_EQ(keys.front(), BSON("x" << 0));
+    ASSERT_BSONOBJ_EQ(keys.back(), BSON("x" << 49));
+
+    // Half of the 10000 bytes inserted into the parent are accounted to the child
+    ASSERT_FALSE(child.getSampledSplitPoints(5001));
+    auto splitPoints = child.getSampledSplitPoints(5000);
+    ASSERT_TRUE(splitPoints);
+    ASSERT_EQ(splitPoints->size(), 1U);
+    ASSERT_BSONOBJ_EQ((*splitPoints)[0], BSON("x" << 25));
+}
+
 TEST(ChunkWritesTrackerTest, ShouldSplitReturnsTrueWithBytesWrittenAndMaxChunkSizeZero) {
     ChunkWritesTracker wt;
     wt.addBytesWritten(4ull);
@@ -540,9 +540,11 @@ private:
         // Save the last opTimes written on each shard for this client, to allow GLE to work
         ClusterLastErrorInfo::get(opCtx->getClient())->addHostOpTimes(stats.getWriteOpTimes());
 
-        // Record the number of shards targeted by this write.
+        // Record the number of shards targeted by this write and the time spent routing it.
         CurOp::get(opCtx)->debug().nShards =
             stats.getTargetedShards().size() + (updatedShardKey ? 1 : 0);
+        CurOp::get(opCtx)->debug().writeRoutingStats = OpDebug::WriteRoutingStats{
+            stats.numRounds, stats.targetingTime, stats.shardResponseWaitTime, stats.refreshTime};
 
         if (stats.getNumShardsOwningChunks().is_initialized())
             updateHostsTargetedMetrics(opCtx,
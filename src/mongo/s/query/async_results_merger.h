@@ -35,7 +35,9 @@
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
@@ -67,6 +69,13 @@ class CursorResponse;
  * This requires waiting until we have a response from every remote before returning results.
  * Without a sort, we are ready to return results as soon as we have *any* response from a remote.
  *
+ * For non-tailable cursors, the ARM can also prefetch: once fewer than
+ * 'internalQueryAsyncResultsMergerPrefetchThreshold' results are buffered for a remote, a getMore
+ * is scheduled against it without waiting for the caller to drain its buffer, so that the
+ * latency of a merge approaches that of the slowest remote rather than the sum of round trips.
+ * Prefetching stops while more than 'internalQueryAsyncResultsMergerPrefetchMaxBufferedBytes' are
+ * buffered across all remotes.
+ *
  * On any error, the caller is responsible for shutting down the ARM using the kill() method.
  *
  * Does not throw exceptions.
@@ -255,6 +264,15 @@ private:
      * reported from the remote.
      */
     struct RemoteCursorData {
+        /**
+         * A result buffered from the remote. For sorted merges of non-tailable cursors, also holds
+         * the result's sort key as a KeyString, so that the merge compares keys with a memcmp.
+         */
+        struct BufferedResult {
+            ClusterQueryResult result;
+            KeyString::Value sortKey;
+        };
+
         RemoteCursorData(HostAndPort hostAndPort,
                          NamespaceString cursorNss,
                          CursorId establishedCursorId,
@@ -303,7 +321,10 @@ private:
         bool partialResultsReturned = false;
 
         // The buffer of results that have been retrieved but not yet returned to the caller.
-        std::queue<ClusterQueryResult> docBuffer;
+        std::queue<BufferedResult> docBuffer;
+
+        // The total BSON size of the results in 'docBuffer'.
+        long long bufferedBytes = 0;
 
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
@@ -321,8 +342,12 @@ private:
     public:
         MergingComparator(const std::vector<RemoteCursorData>& remotes,
                           const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+                          bool compareWholeSortKey,
+                          bool compareKeyStrings)
+            : _remotes(remotes),
+              _sort(sort),
+              _compareWholeSortKey(compareWholeSortKey),
+              _compareKeyStrings(compareKeyStrings) {}
 
         bool operator()(const size_t& lhs, const size_t& rhs);
 
@@ -335,6 +360,10 @@ private:
         // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
         // be {$sortKey: 1}.
         const bool _compareWholeSortKey;
+
+        // When true, the buffered results carry their sort keys as KeyStrings, which are compared
+        // instead of the $sortKey fields.
+        const bool _compareKeyStrings;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -390,6 +419,19 @@ private:
     ClusterQueryResult _nextReadySorted(WithLock);
     ClusterQueryResult _nextReadyUnsorted(WithLock);
 
+    /**
+     * Removes and returns the first buffered result of the remote at 'remoteIndex'.
+     */
+    ClusterQueryResult _popFront(WithLock, size_t remoteIndex);
+
+    /**
+     * Schedules a getMore against the remote at 'remoteIndex' ahead of need, if prefetching is
+     * enabled, fewer results than the prefetch threshold are buffered for the remote, the remote
+     * has no request in flight, and the buffers of all remotes are within the memory budget. A
+     * failure to schedule is recorded in the remote's status.
+     */
+    void _prefetchIfNeeded(WithLock, size_t remoteIndex);
+
     using CbData = executor::TaskExecutor::RemoteCommandCallbackArgs;
     using CbResponse = executor::TaskExecutor::ResponseStatus;
 
@@ -463,6 +505,10 @@ private:
     TailableModeEnum _tailableMode;
     AsyncResultsMergerParams _params;
 
+    // The ordering used to encode buffered sort keys as KeyStrings. Unset if the merge is unsorted,
+    // the cursor is tailable, or the sort pattern has too many fields to encode.
+    const boost::optional<Ordering> _sortKeyOrdering;
+
     // Must be acquired before accessing any data members (other than _params, which is read-only).
     mutable Mutex _mutex = MONGO_MAKE_LATCH("AsyncResultsMerger::_mutex");
 
@@ -38,12 +38,14 @@
 #include "mongo/db/pipeline/resume_token.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/query/results_merger_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -1902,5 +1904,128 @@ TEST_F(AsyncResultsMergerTest, ShouldNotScheduleGetMoresWithoutAnOperationContex
     executor()->waitForEvent(killedEvent);
 }
 
+TEST_F(AsyncResultsMergerTest, SortedMergeWithMixedTypeSortKeys) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: ['b']}"),
+                                   fromjson("{$sortKey: [NumberLong(5)]}"),
+                                   fromjson("{$sortKey: [2.5]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, CursorId(0), batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: ['a']}"),
+                                   fromjson("{$sortKey: [4.0]}"),
+                                   fromjson("{$sortKey: [NumberInt(1)]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, CursorId(0), batch2)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Strings sort after numbers, and numbers of different types compare by value.
+    for (auto&& expected : {fromjson("{$sortKey: ['b']}"),
+                            fromjson("{$sortKey: ['a']}"),
+                            fromjson("{$sortKey: [NumberLong(5)]}"),
+                            fromjson("{$sortKey: [4.0]}"),
+                            fromjson("{$sortKey: [2.5]}"),
+                            fromjson("{$sortKey: [NumberInt(1)]}")}) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(expected, *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, SortedMergePrefetchesBeforeBufferRunsDry) {
+    const auto originalThreshold = internalQueryAsyncResultsMergerPrefetchThreshold.load();
+    ON_BLOCK_EXIT(
+        [&] { internalQueryAsyncResultsMergerPrefetchThreshold.store(originalThreshold); });
+    internalQueryAsyncResultsMergerPrefetchThreshold.store(2);
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: [1]}"),
+                                   fromjson("{$sortKey: [3]}"),
+                                   fromjson("{$sortKey: [5]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: [2]}"), fromjson("{$sortKey: [4]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, batch2)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // The first shard still has two buffered results, so nothing is prefetched.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [1]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // The second shard drops below the threshold, so a getMore is sent to it while the ARM can
+    // still return results.
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [2]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+    ASSERT_EQ(kTestShardHosts[1], getNthPendingRequest(0u).target);
+    ASSERT_TRUE(arm->ready());
+
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: [6]}")};
+    scheduleNetworkResponse({kTestNss, CursorId(0), batch3});
+
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [3]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+    ASSERT_EQ(kTestShardHosts[0], getNthPendingRequest(0u).target);
+
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [4]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [5]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // The first shard's getMore is still outstanding, so the merge must wait for it.
+    ASSERT_FALSE(arm->ready());
+    std::vector<BSONObj> batch4 = {fromjson("{$sortKey: [7]}")};
+    scheduleNetworkResponse({kTestNss, CursorId(0), batch4});
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [6]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [7]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, PrefetchStopsWhenBufferedBytesExceedBudget) {
+    const auto originalThreshold = internalQueryAsyncResultsMergerPrefetchThreshold.load();
+    const auto originalMaxBytes = internalQueryAsyncResultsMergerPrefetchMaxBufferedBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryAsyncResultsMergerPrefetchThreshold.store(originalThreshold);
+        internalQueryAsyncResultsMergerPrefetchMaxBufferedBytes.store(originalMaxBytes);
+    });
+    internalQueryAsyncResultsMergerPrefetchThreshold.store(10);
+    internalQueryAsyncResultsMergerPrefetchMaxBufferedBytes.store(1);
+
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{_id: 1}"), fromjson("{_id: 2}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 1, batch1)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors));
+
+    // A result is still buffered, which exceeds the budget.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // Once the buffer is empty, the next batch is requested before the caller asks for it.
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+    ASSERT_FALSE(arm->ready());
+
+    std::vector<BSONObj> batch2 = {fromjson("{_id: 3}")};
+    scheduleNetworkResponse({kTestNss, CursorId(0), batch2});
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 3}"), *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
 #include "mongo/s/catalog/type_shard.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
 #include "mongo/s/query/sharded_agg_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
@@ -608,5 +609,103 @@ TEST_F(ClusterExchangeTest, CompoundShardKeyThreeShards) {
 
     future.default_timed_get();
 }
+
+class ClusterGroupExchangeTest : public ClusterExchangeTest {
+protected:
+    void setUp() override {
+        ClusterExchangeTest::setUp();
+        _originalEnableGroupExchange = internalQueryEnableGroupExchange.load();
+        internalQueryEnableGroupExchange.store(true);
+    }
+
+    void tearDown() override {
+        internalQueryEnableGroupExchange.store(_originalEnableGroupExchange);
+        ClusterExchangeTest::tearDown();
+    }
+
+    const std::set<ShardId> _threeShards{ShardId("0"), ShardId("1"), ShardId("2")};
+
+private:
+    bool _originalEnableGroupExchange;
+};
+
+TEST_F(ClusterGroupExchangeTest, MergingGroupIsHashPartitionedAcrossTargetedShards) {
+    auto mergePipe =
+        Pipeline::create({parseStage("{$group: {_id: '$x', n: {$sum: '$n'}, $doingMerge: true}}"),
+                          parseStage("{$match: {n: {$gt: 1}}}"),
+                          parseStage("{$project: {n: 1}}")},
+                         expCtx());
+
+    auto exchangeSpec = sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _threeShards);
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT(exchangeSpec->exchangeSpec.getPolicy() == ExchangePolicyEnum::kKeyRange);
+    ASSERT_BSONOBJ_EQ(exchangeSpec->exchangeSpec.getKey(),
+                      BSON("_id"
+                           << "hashed"));
+    ASSERT_EQ(exchangeSpec->exchangeSpec.getConsumers(), 3);
+    ASSERT_EQ(exchangeSpec->consumerShards.size(), 3UL);  // One for each targeted shard.
+    ASSERT_EQ(exchangeSpec->consumerShards[0], ShardId("0"));
+    ASSERT_EQ(exchangeSpec->consumerShards[2], ShardId("2"));
+
+    // The hashed key space is split into three equal ranges.
+    const long long lowest = std::numeric_limits<long long>::min();
+    const long long third = std::numeric_limits<long long>::max() / 3;
+    const auto& boundaries = exchangeSpec->exchangeSpec.getBoundaries().get();
+    ASSERT_EQ(boundaries.size(), 4UL);
+    ASSERT_BSONOBJ_EQ(boundaries[0], BSON("_id" << MINKEY));
+    ASSERT_BSONOBJ_EQ(boundaries[1], BSON("_id" << (lowest + 2 * third)));
+    ASSERT_BSONOBJ_EQ(boundaries[2], BSON("_id" << (lowest + 2 * third + 2 * third)));
+    ASSERT_BSONOBJ_EQ(boundaries[3], BSON("_id" << MAXKEY));
+
+    const auto& consumerIds = exchangeSpec->exchangeSpec.getConsumerIds().get();
+    ASSERT_EQ(consumerIds.size(), 3UL);
+    ASSERT_EQ(consumerIds[0], 0);
+    ASSERT_EQ(consumerIds[1], 1);
+    ASSERT_EQ(consumerIds[2], 2);
+}
+
+TEST_F(ClusterGroupExchangeTest, GroupExchangeRequiresKnobAndMultipleShards) {
+    auto mergePipe =
+        Pipeline::create({parseStage("{$group: {_id: '$x', $doingMerge: true}}")}, expCtx());
+    ASSERT_TRUE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _threeShards));
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), {ShardId("0")}));
+
+    internalQueryEnableGroupExchange.store(false);
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _threeShards));
+
+    internalQueryEnableGroupExchange.store(true);
+    internalQueryDisableExchange.store(true);
+    ON_BLOCK_EXIT([] { internalQueryDisableExchange.store(false); });
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _threeShards));
+}
+
+TEST_F(ClusterGroupExchangeTest, ShouldNotGroupExchangeIfPipelineDoesNotStartWithMergingGroup) {
+    auto mergePipe = Pipeline::create({parseStage("{$group: {_id: '$x'}}")}, expCtx());
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _threeShards));
+
+    mergePipe = Pipeline::create({parseStage("{$match: {x: 1}}"),
+                                  parseStage("{$group: {_id: '$x', $doingMerge: true}}")},
+                                 expCtx());
+    ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+        operationContext(), mergePipe.get(), _threeShards));
+}
+
+TEST_F(ClusterGroupExchangeTest, ShouldNotGroupExchangeIfLaterStageNeedsAllGroups) {
+    for (auto&& stage :
+         {"{$sort: {_id: 1}}", "{$limit: 5}", "{$skip: 5}", "{$group: {_id: null}}"}) {
+        auto mergePipe = Pipeline::create(
+            {parseStage("{$group: {_id: '$x', $doingMerge: true}}"), parseStage(stage)},
+            expCtx());
+        ASSERT_FALSE(sharded_agg_helpers::checkIfEligibleForGroupExchange(
+            operationContext(), mergePipe.get(), _threeShards))
+            << stage;
+    }
+}
 }  // namespace
 }  // namespace mongo
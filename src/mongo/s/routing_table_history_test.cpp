@@ -93,9 +93,7 @@ std::set<ChunkInfo*> getChunksInRange(std::shared_ptr<RoutingTableHistory> rt,
     std::transform(chunksFromSplitIter.first,
                    chunksFromSplitIter.second,
                    std::inserter(chunksFromSplit, chunksFromSplit.begin()),
-                   [](const std::pair<std::string, std::shared_ptr<ChunkInfo>>& pair) {
-                       return pair.second.get();
-                   });
+                   [](const std::shared_ptr<ChunkInfo>& chunkInfo) { return chunkInfo.get(); });
     return chunksFromSplit;
 }
 
@@ -108,7 +106,7 @@ std::shared_ptr<ChunkInfo> getChunkToSplit(std::shared_ptr<RoutingTableHistory>
     invariant(std::distance(chunkToSplitIter.first, chunkToSplitIter.second) <= 1);
     invariant(chunkToSplitIter.first != rt->getChunkMap().end());
 
-    return (*chunkToSplitIter.first).second;
+    return *chunkToSplitIter.first;
 }
 
 /**
@@ -136,8 +134,7 @@ void assertCorrectBytesWritten(std::shared_ptr<RoutingTableHistory> rt,
     auto chunksFromSplit = getChunksInRange(rt, minSplitBoundary, maxSplitBoundary);
     ASSERT_EQ(chunksFromSplit.size(), expectedNumChunksFromSplit);
 
-    for (auto kv : rt->getChunkMap()) {
-        auto chunkInfo = kv.second;
+    for (const auto& chunkInfo : rt->getChunkMap()) {
         auto writesTracker = chunkInfo->getWritesTracker();
         auto bytesWritten = writesTracker->getBytesWritten();
         if (chunksFromSplit.count(chunkInfo.get()) > 0) {
@@ -170,8 +167,7 @@ public:
 
         ASSERT_EQ(_rt->getChunkMap().size(), 1ull);
         // Should only be one
-        for (auto kv : _rt->getChunkMap()) {
-            auto chunkInfo = kv.second;
+        for (const auto& chunkInfo : _rt->getChunkMap()) {
             auto writesTracker = chunkInfo->getWritesTracker();
             writesTracker->addBytesWritten(_bytesInOriginalChunk);
         }
@@ -234,8 +230,7 @@ TEST_F(RoutingTableHistoryTest, SplittingOnlyChunkCopiesBytesWrittenToAllSubchun
     auto rt = splitChunk(getInitialRoutingTable(), newChunkBoundaryPoints);
 
     ASSERT_EQ(rt->getChunkMap().size(), 3ull);
-    for (auto kv : rt->getChunkMap()) {
-        auto chunkInfo = kv.second;
+    for (const auto& chunkInfo : rt->getChunkMap()) {
         auto writesTracker = chunkInfo->getWritesTracker();
         auto bytesWritten = writesTracker->getBytesWritten();
         ASSERT_EQ(bytesWritten, getBytesInOriginalChunk());
@@ -318,5 +313,231 @@ TEST_F(RoutingTableHistoryTestThreeInitialChunks,
                               expectedBytesInChunksNotSplit);
 }
 
+/**
+ * Makes a routing table on {a: 1} with a chunk ending at each of "splitPoints", assigned to the
+ * shards in "shards" in turn.
+ */
+std::shared_ptr<RoutingTableHistory> makeRoutingTable(const std::vector<BSONObj>& splitPoints,
+                                                      const std::vector<ShardId>& shards) {
+    const KeyPattern shardKeyPattern(BSON("a" << 1));
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    std::vector<ChunkType> chunks;
+    auto min = shardKeyPattern.globalMin();
+    for (size_t i = 0; i <= splitPoints.size(); ++i) {
+        const auto max = i < splitPoints.size() ? splitPoints[i] : shardKeyPattern.globalMax();
+        chunks.emplace_back(kNss, ChunkRange{min, max}, version, shards[i % shards.size()]);
+        version.incMinor();
+        min = max;
+    }
+
+    return RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), shardKeyPattern, nullptr, false, epoch, chunks);
+}
+
+TEST(ChunkMapTest, LookupsFindChunksWhoseMaxKeysShareLongPrefixes) {
+    // All the key strings have the same first eight bytes, so every comparison in the search has
+    // to fall back to the full key strings.
+    const auto makeKey = [](int i) { return BSON("a" << ("commonprefix" + std::to_string(i))); };
+    std::vector<BSONObj> splitPoints;
+    for (int i = 0; i < 100; ++i) {
+        splitPoints.push_back(makeKey(1000 + i * 10));
+    }
+    const std::vector<ShardId> shards{ShardId("shard0"), ShardId("shard1"), ShardId("shard2")};
+    ChunkManager cm(makeRoutingTable(splitPoints, shards), boost::none);
+    ASSERT_EQ(101, cm.numChunks());
+
+    for (size_t i = 0; i < splitPoints.size(); ++i) {
+        // The split point itself belongs to the next chunk.
+        const auto chunk = cm.findIntersectingChunkWithSimpleCollation(splitPoints[i]);
+        ASSERT_BSONOBJ_EQ(splitPoints[i], chunk.getMin());
+        ASSERT_EQ(shards[(i + 1) % shards.size()], chunk.getShardId());
+
+        const auto keyBefore = makeKey(1000 + int(i) * 10 - 5);
+        const auto chunkBefore = cm.findIntersectingChunkWithSimpleCollation(keyBefore);
+        ASSERT_BSONOBJ_EQ(splitPoints[i], chunkBefore.getMax());
+        ASSERT(cm.keyBelongsToShard(keyBefore, shards[i % shards.size()]));
+    }
+}
+
+TEST(ChunkMapTest, InternsTheCurrentOwnerOfEachChunk) {
+    const std::vector<ShardId> shards{ShardId("shard0"), ShardId("shard1"), ShardId("shard2")};
+    auto rt = makeRoutingTable({BSON("a" << 10), BSON("a" << 20), BSON("a" << 30)}, shards);
+
+    const auto& chunkMap = rt->getChunkMap();
+    ASSERT_EQ(3ull, chunkMap.numShards());
+    for (auto it = chunkMap.begin(); it != chunkMap.end(); ++it) {
+        ASSERT_EQ((*it)->getShardIdAt(boost::none),
+                  chunkMap.shardIdForIndex(chunkMap.shardIndexAt(it)));
+    }
+    ASSERT_FALSE(chunkMap.findShardIndex(ShardId("shard3")));
+
+    ChunkManager cm(rt, boost::none);
+    std::set<ShardId> shardIds;
+    cm.getShardIdsForRange(BSON("a" << 15), BSON("a" << 25), &shardIds);
+    ASSERT((std::set<ShardId>{ShardId("shard1"), ShardId("shard2")}) == shardIds);
+
+    ASSERT(cm.rangeOverlapsShard(ChunkRange(BSON("a" << 25), BSON("a" << 35)), ShardId("shard0")));
+    ASSERT_FALSE(
+        cm.rangeOverlapsShard(ChunkRange(BSON("a" << 10), BSON("a" << 20)), ShardId("shard0")));
+    ASSERT_FALSE(
+        cm.rangeOverlapsShard(ChunkRange(BSON("a" << 10), BSON("a" << 20)), ShardId("shard3")));
+}
+
+TEST(ChunkMapTest, UpdateMergesChangedChunksWithTheUntouchedOnes) {
+    const std::vector<ShardId> shards{ShardId("shard0"), ShardId("shard1")};
+    std::vector<BSONObj> splitPoints;
+    for (int i = 1; i < 50; ++i) {
+        splitPoints.push_back(BSON("a" << i * 10));
+    }
+    auto rt = makeRoutingTable(splitPoints, shards);
+    const auto untouchedChunk = *std::next(rt->getChunkMap().begin(), 5);
+
+    // Move the chunk [200, 210) to a new shard and merge the chunks [300, 310) and [310, 320).
+    auto version = rt->getVersion();
+    version.incMajor();
+    std::vector<ChunkType> changedChunks;
+    changedChunks.emplace_back(
+        kNss, ChunkRange{BSON("a" << 200), BSON("a" << 210)}, version, ShardId("shard2"));
+    version.incMinor();
+    changedChunks.emplace_back(
+        kNss, ChunkRange{BSON("a" << 300), BSON("a" << 320)}, version, ShardId("shard1"));
+    auto updatedRt = rt->makeUpdated(changedChunks);
+
+    ASSERT_EQ(rt->getChunkMap().size() - 1, updatedRt->getChunkMap().size());
+    ASSERT_EQ(3ull, updatedRt->getChunkMap().numShards());
+
+    ChunkManager cm(updatedRt, boost::none);
+    ASSERT_EQ(ShardId("shard2"),
+              cm.findIntersectingChunkWithSimpleCollation(BSON("a" << 205)).getShardId());
+    const auto mergedChunk = cm.findIntersectingChunkWithSimpleCollation(BSON("a" << 315));
+    ASSERT_BSONOBJ_EQ(BSON("a" << 300), mergedChunk.getMin());
+    ASSERT_BSONOBJ_EQ(BSON("a" << 320), mergedChunk.getMax());
+
+    // The chunks which did not change are shared with the previous routing table.
+    ASSERT_EQ(untouchedChunk.get(), std::next(updatedRt->getChunkMap().begin(), 5)->get());
+
+    BSONObj prevMax;
+    for (const auto& chunk : cm.chunks()) {
+        if (!prevMax.isEmpty()) {
+            ASSERT_BSONOBJ_EQ(prevMax, chunk.getMin());
+        }
+        prevMax = chunk.getMax();
+    }
+}
+
+/**
+ * Checks that "rt", which was incrementally updated, has the same chunks and shard versions as a
+ * routing table built from scratch out of its chunks.
+ */
+void assertSameAsFullBuild(const std::shared_ptr<RoutingTableHistory>& rt) {
+    std::vector<ChunkType> chunks;
+    for (const auto& chunkInfo : rt->getChunkMap()) {
+        chunks.emplace_back(kNss,
+                            chunkInfo->getRange(),
+                            chunkInfo->getLastmod(),
+                            chunkInfo->getShardIdAt(boost::none));
+    }
+    std::sort(chunks.begin(), chunks.end(), [](const ChunkType& lhs, const ChunkType& rhs) {
+        return lhs.getVersion() < rhs.getVersion();
+    });
+    auto fullBuildRt =
+        RoutingTableHistory::makeNew(kNss,
+                                     UUID::gen(),
+                                     rt->getShardKeyPattern().getKeyPattern(),
+                                     nullptr,
+                                     false,
+                                     rt->getVersion().epoch(),
+                                     chunks);
+
+    ASSERT_EQ(fullBuildRt->getChunkMap().size(), rt->getChunkMap().size());
+    auto fullBuildIt = fullBuildRt->getChunkMap().begin();
+    for (const auto& chunkInfo : rt->getChunkMap()) {
+        ASSERT_EQ((*fullBuildIt)->getRange().toString(), chunkInfo->getRange().toString());
+        ++fullBuildIt;
+    }
+
+    std::set<ShardId> shardIds;
+    fullBuildRt->getAllShardIds(&shardIds);
+    ASSERT_EQ(fullBuildRt->getNShardsOwningChunks(), rt->getNShardsOwningChunks());
+    for (const auto& shardId : shardIds) {
+        ASSERT_EQ(fullBuildRt->getVersion(shardId), rt->getVersion(shardId));
+    }
+}
+
+TEST(ChunkMapTest, IncrementalUpdatesAcrossSegmentsMatchAFullBuild) {
+    const std::vector<ShardId> shards{ShardId("shard0"), ShardId("shard1")};
+    std::vector<BSONObj> splitPoints;
+    for (int i = 1; i < 3000; ++i) {
+        splitPoints.push_back(BSON("a" << i * 10));
+    }
+    auto rt = makeRoutingTable(splitPoints, shards);
+    ASSERT_GT(rt->getChunkMap().size(), 2 * ChunkMap::kMaxChunksPerSegment);
+
+    // Merge the two chunks on either side of the first segment boundary and split a chunk in the
+    // middle of the second segment.
+    const int boundary = ChunkMap::kMaxChunksPerSegment * 10;
+    auto version = rt->getVersion();
+    version.incMajor();
+    std::vector<ChunkType> changedChunks;
+    changedChunks.emplace_back(kNss,
+                               ChunkRange{BSON("a" << boundary - 10), BSON("a" << boundary + 10)},
+                               version,
+                               ShardId("shard1"));
+    for (int splitPoint = 15000; splitPoint < 15010; splitPoint += 5) {
+        version.incMinor();
+        changedChunks.emplace_back(kNss,
+                                   ChunkRange{BSON("a" << splitPoint), BSON("a" << splitPoint + 5)},
+                                   version,
+                                   ShardId("shard0"));
+    }
+    auto updatedRt = rt->makeUpdated(changedChunks);
+    ASSERT_EQ(rt->getChunkMap().size(), updatedRt->getChunkMap().size());
+    assertSameAsFullBuild(updatedRt);
+
+    // Move the merged chunk, which has the max version of its shard, to a new shard.
+    version.incMajor();
+    updatedRt = updatedRt->makeUpdated({ChunkType(kNss,
+                                                  ChunkRange{BSON("a" << boundary - 10),
+                                                             BSON("a" << boundary + 10)},
+                                                  version,
+                                                  ShardId("shard2"))});
+    assertSameAsFullBuild(updatedRt);
+    ASSERT_EQ(ShardId("shard2"),
+              ChunkManager(updatedRt, boost::none)
+                  .findIntersectingChunkWithSimpleCollation(BSON("a" << boundary))
+                  .getShardId());
+}
+
+TEST(ChunkMapTest, ShardWhichLosesItsLastChunkHasNoVersion) {
+    const std::vector<ShardId> shards{ShardId("shard0"), ShardId("shard1")};
+    auto rt = makeRoutingTable({BSON("a" << 10), BSON("a" << 20)}, shards);
+    ASSERT_EQ(2, rt->getNShardsOwningChunks());
+
+    auto version = rt->getVersion();
+    version.incMajor();
+    auto updatedRt = rt->makeUpdated(
+        {ChunkType(kNss, ChunkRange{BSON("a" << 10), BSON("a" << 20)}, version, shards[0])});
+
+    ASSERT_EQ(1, updatedRt->getNShardsOwningChunks());
+    ASSERT_EQ(ChunkVersion(0, 0, version.epoch()), updatedRt->getVersion(shards[1]));
+    ASSERT_EQ(version, updatedRt->getVersion(shards[0]));
+    assertSameAsFullBuild(updatedRt);
+}
+
+TEST(ChunkMapTest, IncrementalUpdateWhichLeavesAnOverlapIsRejected) {
+    const std::vector<ShardId> shards{ShardId("shard0"), ShardId("shard1")};
+    auto rt = makeRoutingTable({BSON("a" << 10), BSON("a" << 20)}, shards);
+
+    auto version = rt->getVersion();
+    version.incMajor();
+    ASSERT_THROWS_CODE(
+        rt->makeUpdated(
+            {ChunkType(kNss, ChunkRange{BSON("a" << 10), BSON("a" << 15)}, version, shards[0])}),
+        DBException,
+        ErrorCodes::ConflictingOperationInProgress);
+}
+
 }  // namespace
 }  // namespace mongo
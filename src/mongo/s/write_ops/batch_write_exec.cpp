@@ -49,6 +49,8 @@
 #include "mongo/s/transaction_router.h"
 #include "mongo/s/write_ops/batch_write_op.h"
 #include "mongo/s/write_ops/write_error_detail.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -170,7 +172,9 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         // If we've already had a targeting error, we've refreshed the metadata once and can
         // record target errors definitively.
         bool recordTargetErrors = refreshedTargeter;
+        Timer targetingTimer;
         Status targetStatus = batchOp.targetBatch(targeter, recordTargetErrors, &childBatches);
+        stats->targetingTime += Milliseconds(targetingTimer.millis());
         if (!targetStatus.isOK()) {
             // Don't do anything until a targeter refresh
             targeter.noteCouldNotTarget();
@@ -198,6 +202,8 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         const size_t numToSend = childBatches.size();
         size_t numSent = 0;
 
+        Timer shardResponseTimer;
+
         while (numSent != numToSend) {
             // Collect batches out on the network, mapped by endpoint
             OwnedShardBatchMap ownedPendingBatches;
@@ -411,6 +417,8 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
             }
         }
 
+        stats->shardResponseWaitTime += Milliseconds(shardResponseTimer.millis());
+
         ++rounds;
         ++stats->numRounds;
 
@@ -425,6 +433,8 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         //
 
         bool targeterChanged = false;
+        Timer refreshTimer;
+        ON_BLOCK_EXIT([&] { stats->refreshTime += Milliseconds(refreshTimer.millis()); });
         try {
             targeter.refreshIfNeeded(opCtx, &targeterChanged);
         } catch (const ExceptionFor<ErrorCodes::StaleEpoch>& ex) {
@@ -38,6 +38,7 @@
 #include "mongo/s/ns_targeter.h"
 #include "mongo/s/write_ops/batched_command_request.h"
 #include "mongo/s/write_ops/batched_command_response.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -113,6 +114,12 @@ public:
     // Number of stale batches due to StaleDbVersion
     int numStaleDbBatches;
 
+    // Time spent in each stage of the rounds: targeting the writes, waiting for the shards to
+    // respond to the child batches and refreshing the routing information after stale responses
+    Milliseconds targetingTime{0};
+    Milliseconds shardResponseWaitTime{0};
+    Milliseconds refreshTime{0};
+
 private:
     std::set<ShardId> _targetedShards;
     HostOpTimeMap _writeOpTimes;
@@ -128,11 +128,14 @@ bool isNewBatchRequiredUnordered(const std::vector<TargetedWrite*>& writes,
 }
 
 /**
- * Helper to determine whether a number of targeted writes require a new targeted batch.
+ * Helper to determine whether a number of targeted writes require a new targeted batch. If
+ * 'fullBatches' is given, every batch which cannot take the write is added to it.
  */
 bool wouldMakeBatchesTooBig(const std::vector<TargetedWrite*>& writes,
                             int writeSizeBytes,
-                            const TargetedBatchMap& batchMap) {
+                            const TargetedBatchMap& batchMap,
+                            std::set<const TargetedWriteBatch*>* fullBatches = nullptr) {
+    bool tooBig = false;
     for (const auto write : writes) {
         TargetedBatchMap::const_iterator it = batchMap.find(&write->endpoint);
         if (it == batchMap.end()) {
@@ -142,18 +145,18 @@ bool wouldMakeBatchesTooBig(const std::vector<TargetedWrite*>& writes,
 
         const auto& batch = it->second;
 
-        if (batch->getNumOps() >= write_ops::kMaxWriteBatchSize) {
-            // Too many items in batch
-            return true;
-        }
-
-        if (batch->getEstimatedSizeBytes() + writeSizeBytes > BSONObjMaxUserSize) {
-            // Batch would be too big
-            return true;
+        // Too many items in batch, or batch would be too big
+        if (batch->getNumOps() >= write_ops::kMaxWriteBatchSize ||
+            batch->getEstimatedSizeBytes() + writeSizeBytes > BSONObjMaxUserSize) {
+            if (!fullBatches) {
+                return true;
+            }
+            fullBatches->insert(batch);
+            tooBig = true;
         }
     }
 
-    return false;
+    return tooBig;
 }
 
 /**
@@ -266,7 +269,10 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
     //
     // Targeting of unordered batches is fairly simple - each remaining write op is targeted,
     // and each of those targeted writes are grouped into a batch for a particular shard
-    // endpoint.
+    // endpoint. Writes which would go to a shard at a different version than its batch (such as
+    // a multi-shard write, which is not versioned), or which do not fit in the batch, are left for
+    // the next round, without stopping the targeting of the writes after them, until every batch
+    // of the round is full.
     //
     // Targeting of ordered batches is a bit more complex - to respect the ordering of the
     // batch, we can only send:
@@ -300,6 +306,8 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     TargetedBatchMap batchMap;
     std::set<ShardId> targetedShards;
+    // The batches of this round which could not take a write because of their size or count.
+    std::set<const TargetedWriteBatch*> fullBatches;
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
@@ -392,17 +400,24 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         const int errorResponsePotentialSizeBytes =
             ordered ? 0 : write_ops::kWriteCommandBSONArrayPerElementOverheadBytes + 256;
 
-        if (wouldMakeBatchesTooBig(
-                writes, std::max(writeSizeBytes, errorResponsePotentialSizeBytes), batchMap)) {
+        // A write, which does not fit in this round's batches, is left for the next round. Later
+        // writes of an unordered batch may still fit in the batches of other shards, but once
+        // every batch of this round is full, targeting them would only cancel them again.
+        if (wouldMakeBatchesTooBig(writes,
+                                   std::max(writeSizeBytes, errorResponsePotentialSizeBytes),
+                                   batchMap,
+                                   &fullBatches)) {
             invariant(!batchMap.empty());
             writeOp.cancelWrites(nullptr);
-            break;
+            if (ordered || fullBatches.size() == batchMap.size())
+                break;
+            continue;
         }
 
         if (!ordered && !batchMap.empty() &&
             isNewBatchRequiredUnordered(writes, batchMap, targetedShards)) {
             writeOp.cancelWrites(nullptr);
-            break;
+            continue;
         }
 
         //
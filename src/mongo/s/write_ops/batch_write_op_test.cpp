@@ -766,6 +766,66 @@ TEST_F(BatchWriteOpTest, MultiOpOneOrTwoShardsUnordered) {
     ASSERT_EQUALS(clientResponse.getN(), 8);
 }
 
+// Unordered multi-op targeting test where a multi-shard op, which is not versioned, comes between
+// versioned single-shard ops. The single-shard ops after it are still targeted in the first round
+// and the multi-shard op is left for the second one.
+TEST_F(BatchWriteOpTest, MultiOpVersionedAndUnversionedUnordered) {
+    NamespaceString nss("foo.bar");
+    const OID epoch = OID::gen();
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion(10, 0, epoch));
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion(20, 0, epoch));
+
+    auto targeter = initTargeterSplitRange(nss, endpointA, endpointB);
+
+    BatchedCommandRequest request([&] {
+        write_ops::Update updateOp(nss);
+        updateOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        updateOp.setUpdates({buildUpdate(BSON("x" << -1), false),
+                             buildUpdate(BSON("x" << GTE << -1 << LT << 2), true),
+                             buildUpdate(BSON("x" << -2), false),
+                             buildUpdate(BSON("x" << 1), false)});
+        return updateOp;
+    }());
+
+    BatchWriteOp batchOp(_opCtx, request);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    ASSERT_EQUALS(targeted.size(), 2u);
+    ASSERT_EQUALS(targeted[endpointA.shardName]->getWrites().size(), 2u);
+    ASSERT_EQUALS(targeted[endpointA.shardName]->getEndpoint().shardVersion,
+                  endpointA.shardVersion);
+    ASSERT_EQUALS(targeted[endpointB.shardName]->getWrites().size(), 1u);
+    ASSERT_EQUALS(targeted[endpointB.shardName]->getEndpoint().shardVersion,
+                  endpointB.shardVersion);
+
+    BatchedCommandResponse response;
+    buildResponse(1, &response);
+    for (auto it = targeted.begin(); it != targeted.end(); ++it) {
+        batchOp.noteBatchResponse(*it->second, response, nullptr);
+    }
+    ASSERT(!batchOp.isFinished());
+
+    targetedOwned.clear();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    verifyTargetedBatches({{endpointA.shardName, 1u}, {endpointB.shardName, 1u}}, targeted);
+
+    for (auto it = targeted.begin(); it != targeted.end(); ++it) {
+        batchOp.noteBatchResponse(*it->second, response, nullptr);
+    }
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), 4);
+}
+
 // Multi-op targeting test where two ops go to two separate shards and there's an error on one op on
 // one shard. There should be one set of two batches to each shard and an error reported.
 TEST_F(BatchWriteOpTest, MultiOpSingleShardErrorUnordered) {
@@ -1537,6 +1597,64 @@ TEST_F(BatchWriteOpLimitTests, OneBigOneSmall) {
     ASSERT(batchOp.isFinished());
 }
 
+// Unordered batch where the batch of one shard fills up. Writes to other shards, which already
+// have a batch in this round, are still added to it, but targeting stops once every batch of the
+// round is full.
+TEST_F(BatchWriteOpLimitTests, FullBatchesStopUnorderedTargeting) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED());
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED());
+
+    auto targeter = initTargeterSplitRange(nss, endpointA, endpointB);
+
+    // Two of these updates do not fit in one batch.
+    const std::string bigString(BSONObjMaxUserSize * 3 / 4, 'x');
+
+    BatchedCommandRequest request([&] {
+        write_ops::Update updateOp(nss);
+        updateOp.setWriteCommandBase([] {
+            write_ops::WriteCommandBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        updateOp.setUpdates({buildUpdate(BSON("x" << 1), BSONObj(), false),
+                             buildUpdate(BSON("x" << -1), BSON("data" << bigString), false),
+                             buildUpdate(BSON("x" << -2), BSON("data" << bigString), false),
+                             buildUpdate(BSON("x" << 2), BSONObj(), false),
+                             buildUpdate(BSON("x" << 3), BSON("data" << bigString), false),
+                             buildUpdate(BSON("x" << 4), BSON("data" << bigString), false),
+                             buildUpdate(BSON("x" << -3), BSONObj(), false),
+                             buildUpdate(BSON("x" << 5), BSONObj(), false)});
+        return updateOp;
+    }());
+
+    BatchWriteOp batchOp(_opCtx, request);
+
+    // The second big update to shardA is left for the next round, the small update after it still
+    // joins the batch of shardB. Once the batch of shardB is full too, the remaining updates are
+    // not targeted in this round.
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    verifyTargetedBatches({{endpointA.shardName, 1u}, {endpointB.shardName, 3u}}, targeted);
+
+    BatchedCommandResponse response;
+    buildResponse(1, &response);
+    for (auto it = targeted.begin(); it != targeted.end(); ++it) {
+        batchOp.noteBatchResponse(*it->second, response, nullptr);
+    }
+    ASSERT(!batchOp.isFinished());
+
+    targetedOwned.clear();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    verifyTargetedBatches({{endpointA.shardName, 2u}, {endpointB.shardName, 2u}}, targeted);
+
+    for (auto it = targeted.begin(); it != targeted.end(); ++it) {
+        batchOp.noteBatchResponse(*it->second, response, nullptr);
+    }
+    ASSERT(batchOp.isFinished());
+}
+
 class BatchWriteOpTransactionTest : public ShardingTestFixture {
 public:
     const TxnNumber kTxnNumber = 5;
@@ -205,18 +205,30 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
     // We're about to update the compressor list with the negotiation result from the server.
     _negotiated.clear();
 
-    auto& compressorList = _registry->getCompressorNames();
+    std::vector<std::string> compressorList;
+    for (const auto& name : _clientPreference) {
+        if (_registry->getCompressor(name)) {
+            compressorList.push_back(name);
+        }
+    }
+    if (compressorList.empty()) {
+        compressorList = _registry->getCompressorNames();
+    }
     if (compressorList.size() == 0)
         return;
 
     BSONArrayBuilder sub(output->subarrayStart("compression"));
-    for (const auto e : _registry->getCompressorNames()) {
+    for (const auto& e : compressorList) {
         LOGV2_DEBUG(22929, 3, "Offering {e} compressor to server", "e"_attr = e);
         sub.append(e);
     }
     sub.doneFast();
 }
 
+void MessageCompressorManager::setClientCompressorPreference(std::vector<std::string> names) {
+    _clientPreference = std::move(names);
+}
+
 void MessageCompressorManager::clientFinish(const BSONObj& input) {
     auto elem = input.getField("compression");
     LOGV2_DEBUG(22930, 3, "Finishing client-side compression negotiation");
@@ -33,6 +33,7 @@
 #include "mongo/transport/message_compressor_base.h"
 #include "mongo/transport/session.h"
 
+#include <string>
 #include <vector>
 
 namespace mongo {
@@ -68,6 +69,14 @@ public:
      */
     void clientBegin(BSONObjBuilder* output);
 
+    /*
+     * Makes clientBegin() offer only the compressors in 'names', in that order of preference,
+     * rather than every compressor in the registry. Names that are not enabled in the registry are
+     * skipped, and if none of them are enabled the registry's compressors are offered as usual.
+     * An empty list restores the default.
+     */
+    void setClientCompressorPreference(std::vector<std::string> names);
+
     /*
      * Called by a client that has received an isMaster response (received after calling
      * clientBegin) and wants to finish negotiating compression.
@@ -129,6 +138,7 @@ public:
 private:
     std::vector<MessageCompressorBase*> _negotiated;
     MessageCompressorRegistry* _registry;
+    std::vector<std::string> _clientPreference;
 };
 
 }  // namespace mongo
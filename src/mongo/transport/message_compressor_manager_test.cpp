@@ -322,6 +322,47 @@ TEST(MessageCompressorManager, SERVER_28008) {
     ASSERT_EQ(compressorId, zstdId);
 }
 
+TEST(MessageCompressorManager, ClientCompressorPreference) {
+    std::unique_ptr<MessageCompressorBase> zstdCompressor =
+        std::make_unique<ZstdMessageCompressor>();
+    const auto zstdId = zstdCompressor->getId();
+
+    std::unique_ptr<MessageCompressorBase> snappyCompressor =
+        std::make_unique<SnappyMessageCompressor>();
+
+    MessageCompressorRegistry registry;
+    registry.setSupportedCompressors({snappyCompressor->getName(), zstdCompressor->getName()});
+    registry.registerImplementation(std::move(zstdCompressor));
+    registry.registerImplementation(std::move(snappyCompressor));
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+
+    MessageCompressorManager clientManager(&registry);
+    MessageCompressorManager serverManager(&registry);
+
+    // Names that are not enabled are skipped, and the rest are offered in the preferred order.
+    clientManager.setClientCompressorPreference({"zlib", "zstd", "snappy"});
+    BSONObjBuilder clientOutput;
+    clientManager.clientBegin(&clientOutput);
+    auto clientObj = clientOutput.done();
+    checkNegotiationResult(clientObj, {"zstd", "snappy"});
+
+    BSONObjBuilder serverOutput;
+    serverManager.serverNegotiate(clientObj, &serverOutput);
+    auto serverObj = serverOutput.done();
+    clientManager.clientFinish(serverObj);
+
+    auto toSend = assertOk(clientManager.compressMessage(buildMessage(), nullptr));
+    MessageCompressorId compressorId;
+    assertOk(serverManager.decompressMessage(toSend, &compressorId));
+    ASSERT_EQ(compressorId, zstdId);
+
+    // If none of the preferred compressors are enabled, all of the registry's are offered.
+    clientManager.setClientCompressorPreference({"zlib"});
+    BSONObjBuilder fallbackOutput;
+    clientManager.clientBegin(&fallbackOutput);
+    checkNegotiationResult(fallbackOutput.done(), {"snappy", "zstd"});
+}
+
 TEST(MessageCompressorManager, MessageSizeTooLarge) {
     auto registry = buildRegistry();
     MessageCompressorManager compManager(&registry);